@@ -0,0 +1,32 @@
+#pragma once
+
+#include <prime/KeyCode.h>
+
+#include <iostream>
+#include <streambuf>
+
+// Shared fixtures for mods_bench, installed by main before any benchmark runs
+namespace Bench
+{
+// Simulated UnityEngine.Input state, served to Key through the stubbed icalls
+void SetKey(KeyCode key, bool held);
+void ClearKeys();
+
+// Config::Load prints the parsed settings, keep that out of the benchmark output
+class QuietStdout
+{
+public:
+  QuietStdout()
+      : previous(std::cout.rdbuf(nullptr))
+  {
+  }
+
+  ~QuietStdout()
+  {
+    std::cout.rdbuf(previous);
+  }
+
+private:
+  std::streambuf* previous;
+};
+} // namespace Bench
@@ -0,0 +1,153 @@
+#include "patches/chat_filter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static constexpr size_t MaxKeywords = 1000;
+
+struct SyntheticMessage {
+  std::u16string sender;
+  std::u16string alliance;
+  std::u16string text;
+};
+
+// Words a busy galaxy chat is made of, Latin and Cyrillic, in the case people type them in
+static constexpr std::array<std::u16string_view, 24> words = {
+    u"hostile", u"armada", u"Join",  u"ALLIANCE", u"recruiting", u"lvl", u"40+", u"the",
+    u"system",  u"mining", u"Ore",   u"lol",      u"GG",         u"who", u"is",  u"at",
+    u"Привет",  u"флот",   u"война", u"ДА",       u"officers",   u"pvp", u"and", u"station",
+};
+
+// ASCII keywords like the spam the lists are for: shop names and their domains
+static std::vector<std::string> make_keywords(size_t count)
+{
+  std::mt19937 rng{7};
+
+  std::vector<std::string> keywords;
+  for (size_t i = 0; i < count; ++i) {
+    std::string keyword;
+    for (size_t j = 6 + rng() % 8; j > 0; --j) {
+      keyword += "abcdefghijklmnopqrstuvwxyz"[rng() % 26];
+    }
+    keywords.emplace_back(keyword + ".com");
+  }
+
+  return keywords;
+}
+
+// 10,000 messages of 3 to 30 words, one in fifty carrying one of the keywords, so most
+// scans run to the end of the message the way they do in a real chat
+static const std::vector<SyntheticMessage>& synthetic_corpus()
+{
+  static std::vector<SyntheticMessage> corpus = [] {
+    const auto keywords = make_keywords(MaxKeywords);
+
+    std::mt19937                          rng{42};
+    std::uniform_int_distribution<size_t> word(0, words.size() - 1);
+    std::uniform_int_distribution<size_t> length(3, 30);
+    std::uniform_int_distribution<size_t> keyword(0, keywords.size() - 1);
+    std::uniform_int_distribution<int>    spam(0, 49);
+
+    std::vector<SyntheticMessage> messages(10'000);
+    for (auto& message : messages) {
+      message.sender   = u"Commander" + std::u16string(1, char16_t(u'A' + rng() % 26));
+      message.alliance = u"TAG" + std::u16string(1, char16_t(u'0' + rng() % 10));
+
+      for (size_t i = length(rng); i > 0; --i) {
+        message.text.append(words[word(rng)]);
+        message.text.push_back(u' ');
+      }
+
+      if (spam(rng) == 0) {
+        const auto& spam_keyword = keywords[keyword(rng)];
+        message.text.append(spam_keyword.begin(), spam_keyword.end());
+      }
+    }
+
+    return messages;
+  }();
+
+  return corpus;
+}
+
+static int64_t corpus_bytes(const std::vector<SyntheticMessage>& corpus)
+{
+  int64_t bytes = 0;
+  for (const auto& message : corpus) {
+    bytes += static_cast<int64_t>(message.text.size() * sizeof(char16_t));
+  }
+
+  return bytes;
+}
+
+// range(0): keywords in the block list, the first of the ones the corpus is built with
+static void BM_ChatFilterCheck(benchmark::State& state)
+{
+  const auto  all_keywords = make_keywords(MaxKeywords);
+  const auto& corpus       = synthetic_corpus();
+
+  ChatFilter::Rules block;
+  block.senders   = {"CommanderQ"};
+  block.alliances = {"TAG7"};
+  block.keywords.assign(all_keywords.begin(), all_keywords.begin() + state.range(0));
+  const ChatFilter filter(block, {});
+
+  for (auto _ : state) {
+    int blocked = 0;
+    for (const auto& message : corpus) {
+      blocked += filter.Check(message.sender, message.alliance, message.text) == ChatFilter::Action::Block ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(blocked);
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * corpus_bytes(corpus));
+}
+
+BENCHMARK(BM_ChatFilterCheck)->Arg(10)->Arg(100)->Arg(1000)->ArgName("keywords")->Unit(benchmark::kMillisecond);
+
+// What the automaton replaces: each keyword searched for on its own in a lower cased copy
+static void BM_ChatFilterPerKeyword(benchmark::State& state)
+{
+  const auto  all_keywords = make_keywords(MaxKeywords);
+  const auto& corpus       = synthetic_corpus();
+
+  std::vector<std::u16string> keywords;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    keywords.emplace_back(all_keywords[i].begin(), all_keywords[i].end());
+  }
+
+  for (auto _ : state) {
+    int blocked = 0;
+    for (const auto& message : corpus) {
+      auto text = message.text;
+      std::ranges::transform(text, text.begin(),
+                             [](char16_t c) { return c >= u'A' && c <= u'Z' ? char16_t(c + 0x20) : c; });
+      blocked += std::ranges::any_of(keywords, [&text](const auto& k) { return text.find(k) != text.npos; }) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(blocked);
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * corpus_bytes(corpus));
+}
+
+BENCHMARK(BM_ChatFilterPerKeyword)->Arg(10)->Arg(100)->Arg(1000)->ArgName("keywords")->Unit(benchmark::kMillisecond);
+
+static void BM_ChatFilterCompile(benchmark::State& state)
+{
+  ChatFilter::Rules block;
+  block.keywords = make_keywords(state.range(0));
+
+  for (auto _ : state) {
+    ChatFilter filter(block, {});
+    benchmark::DoNotOptimize(&filter);
+  }
+}
+
+BENCHMARK(BM_ChatFilterCompile)->Arg(10)->Arg(100)->Arg(1000)->ArgName("keywords")->Unit(benchmark::kMicrosecond);
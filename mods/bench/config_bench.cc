@@ -0,0 +1,28 @@
+#include "bench.h"
+
+#include "config.h"
+
+#include <benchmark/benchmark.h>
+
+// Full reload of the staged example settings, including writing the runtime vars file back out
+static void BM_ConfigLoad(benchmark::State& state)
+{
+  Config             config{};
+  Bench::QuietStdout quiet;
+
+  for (auto _ : state) {
+    config.Load();
+  }
+}
+
+BENCHMARK(BM_ConfigLoad)->Unit(benchmark::kMicrosecond);
+
+// What every hook pays to read a setting
+static void BM_ConfigGet(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Config::Get()->hotkeys_enabled);
+  }
+}
+
+BENCHMARK(BM_ConfigGet)->Threads(1)->Threads(4);
@@ -0,0 +1,141 @@
+#include <il2cpp/il2cpp_helper.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+// A float property on a fake class. The stubbed runtime mirrors what il2cpp_runtime_invoke does
+// for a value-type getter (call through the method, box the result into a fresh object), minus
+// the GC, so the reflection figures are a lower bound of the in-game cost.
+struct FakeObject {
+  Il2CppObject header;
+  float        value;
+};
+
+static Il2CppClass  fake_class;
+static MethodInfo   fake_getter;
+static MethodInfo   fake_setter;
+static PropertyInfo fake_property;
+static FakeObject*  last_box;
+
+static float native_get(void* _this, const MethodInfo*)
+{
+  return static_cast<FakeObject*>(_this)->value;
+}
+
+static void native_set(void* _this, float v, const MethodInfo*)
+{
+  static_cast<FakeObject*>(_this)->value = v;
+}
+
+static const MethodInfo* stub_property_get_get_method(PropertyInfo* prop)
+{
+  return prop->get;
+}
+
+static const MethodInfo* stub_property_get_set_method(PropertyInfo* prop)
+{
+  return prop->set;
+}
+
+static const MethodInfo* stub_object_get_virtual_method(Il2CppObject*, const MethodInfo* method)
+{
+  return method;
+}
+
+static void* stub_object_unbox(Il2CppObject* obj)
+{
+  return obj + 1;
+}
+
+static Il2CppObject* stub_runtime_invoke(const MethodInfo* method, void* obj, void** params, Il2CppException**)
+{
+  if (params) {
+    ((void (*)(void*, float, const MethodInfo*))method->methodPointer)(obj, *(float*)params[0], method);
+    return nullptr;
+  }
+
+  auto boxed   = static_cast<FakeObject*>(std::malloc(sizeof(FakeObject)));
+  boxed->value = ((float (*)(void*, const MethodInfo*))method->methodPointer)(obj, method);
+
+  std::free(last_box);
+  last_box = boxed;
+
+  return &boxed->header;
+}
+
+static void install_fake_property(uint16_t flags)
+{
+  il2cpp_property_get_get_method   = stub_property_get_get_method;
+  il2cpp_property_get_set_method   = stub_property_get_set_method;
+  il2cpp_object_get_virtual_method = stub_object_get_virtual_method;
+  il2cpp_object_unbox              = stub_object_unbox;
+  il2cpp_runtime_invoke            = stub_runtime_invoke;
+
+  fake_getter.methodPointer = reinterpret_cast<Il2CppMethodPointer>(&native_get);
+  fake_getter.klass         = &fake_class;
+  fake_getter.flags         = flags;
+  fake_setter.methodPointer = reinterpret_cast<Il2CppMethodPointer>(&native_set);
+  fake_setter.klass         = &fake_class;
+  fake_setter.flags         = flags;
+
+  fake_property.parent = &fake_class;
+  fake_property.get    = &fake_getter;
+  fake_property.set    = &fake_setter;
+}
+
+// range(0) == 1 marks the accessors virtual, so the direct path resolves the override per call
+static void BM_PropertyReflectionGet(benchmark::State& state)
+{
+  install_fake_property(state.range(0) ? METHOD_ATTRIBUTE_VIRTUAL : 0);
+  IL2CppPropertyHelper prop{&fake_class, &fake_property};
+  FakeObject           obj{{}, 1.5f};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(*prop.Get<float>(&obj));
+  }
+}
+
+BENCHMARK(BM_PropertyReflectionGet)->Arg(0)->Arg(1)->ArgName("virtual");
+
+static void BM_PropertyAccessorGet(benchmark::State& state)
+{
+  install_fake_property(state.range(0) ? METHOD_ATTRIBUTE_VIRTUAL : 0);
+  IL2CppPropertyAccessor<float> prop{&fake_class, &fake_property};
+  FakeObject                    obj{{}, 1.5f};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(prop.Get(&obj));
+  }
+}
+
+BENCHMARK(BM_PropertyAccessorGet)->Arg(0)->Arg(1)->ArgName("virtual");
+
+static void BM_PropertyReflectionSet(benchmark::State& state)
+{
+  install_fake_property(0);
+  IL2CppPropertyHelper prop{&fake_class, &fake_property};
+  FakeObject           obj{{}, 1.5f};
+  float                value = 2.0f;
+
+  for (auto _ : state) {
+    prop.SetRaw(&obj, value);
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(BM_PropertyReflectionSet);
+
+static void BM_PropertyAccessorSet(benchmark::State& state)
+{
+  install_fake_property(0);
+  IL2CppPropertyAccessor<float> prop{&fake_class, &fake_property};
+  FakeObject                    obj{{}, 1.5f};
+
+  for (auto _ : state) {
+    prop.Set(&obj, 2.0f);
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(BM_PropertyAccessorSet);
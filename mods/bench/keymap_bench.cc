@@ -0,0 +1,91 @@
+#include "bench.h"
+
+#include "patches/gamefunctions.h"
+#include "patches/key.h"
+#include "patches/mapkey.h"
+#include "str_utils.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+// Every shortcut currently mapped, re-parsed from the loaded keymap
+static std::vector<MapKey> collect_keymap()
+{
+  std::vector<MapKey> keymap;
+
+  for (int gameFunction = 0; gameFunction < GameFunction::Max; gameFunction++) {
+    for (const auto& shortcut : StrSplit(MapKey::GetShortcuts((GameFunction)gameFunction), '|')) {
+      if (auto mapKey = MapKey::Parse(StripAsciiWhitespace(shortcut)); mapKey.Key != KeyCode::None) {
+        keymap.emplace_back(mapKey);
+      }
+    }
+  }
+
+  return keymap;
+}
+
+// range(0) == 0: nothing held, the common frame. Otherwise every mapped key and modifier is held,
+// which forces the full modifier checks on each shortcut.
+static void hold_keys(const benchmark::State& state, const std::vector<MapKey>& keymap)
+{
+  Bench::ClearKeys();
+
+  if (state.range(0) == 0) {
+    return;
+  }
+
+  for (const auto& mapKey : keymap) {
+    Bench::SetKey(mapKey.Key, true);
+  }
+
+  for (const auto key : {KeyCode::LeftShift, KeyCode::LeftControl, KeyCode::LeftAlt, KeyCode::LeftCommand}) {
+    Bench::SetKey(key, true);
+  }
+}
+
+// One frame of hotkey polling as ScreenManager_Update_Hook does it: the key cache is reset, the
+// shortcuts are resolved and every game function is checked
+static void BM_MapKeyIsDown(benchmark::State& state)
+{
+  hold_keys(state, collect_keymap());
+
+  for (auto _ : state) {
+    Key::ResetCache();
+    MapKey::Update();
+
+    int down = 0;
+    for (int gameFunction = 0; gameFunction < GameFunction::Max; gameFunction++) {
+      down += MapKey::IsDown((GameFunction)gameFunction) ? 1 : 0;
+    }
+
+    benchmark::DoNotOptimize(down);
+  }
+
+  Bench::ClearKeys();
+  state.SetItemsProcessed(state.iterations() * GameFunction::Max);
+}
+
+BENCHMARK(BM_MapKeyIsDown)->Arg(0)->Arg(1)->ArgName("held");
+
+static void BM_MapKeyHasCorrectModifiers(benchmark::State& state)
+{
+  const auto keymap = collect_keymap();
+  hold_keys(state, keymap);
+
+  for (auto _ : state) {
+    Key::ResetCache();
+
+    int matched = 0;
+    for (const auto& mapKey : keymap) {
+      matched += MapKey::HasCorrectModifiers(mapKey) ? 1 : 0;
+    }
+
+    benchmark::DoNotOptimize(matched);
+  }
+
+  Bench::ClearKeys();
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keymap.size()));
+}
+
+BENCHMARK(BM_MapKeyHasCorrectModifiers)->Arg(0)->Arg(1)->ArgName("held");
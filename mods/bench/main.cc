@@ -0,0 +1,112 @@
+// Microbenchmarks for the mod's hot paths, runnable on Linux without the game.
+//
+//   mods_bench [--benchmark_filter=<regex>] [--benchmark_out=<file> --benchmark_out_format=json]
+//
+// The settings are loaded from a scratch copy of example_community_patch_settings.toml (or
+// MODS_BENCH_CONFIG) and UnityEngine.Input is replaced by an in-memory key table. Compare two
+// JSON outputs with benchmark's tools/compare.py.
+
+#include "bench.h"
+
+#include "config.h"
+#include "file.h"
+
+#include <il2cpp/il2cpp-functions.h>
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+#ifndef MODS_BENCH_CONFIG
+#define MODS_BENCH_CONFIG "example_community_patch_settings.toml"
+#endif
+
+static std::array<bool, (int)KeyCode::Max> keys_held;
+
+void Bench::SetKey(KeyCode key, bool held)
+{
+  keys_held[(int)key] = held;
+}
+
+void Bench::ClearKeys()
+{
+  keys_held.fill(false);
+}
+
+static bool get_key_int(KeyCode key)
+{
+  return keys_held[(int)key];
+}
+
+static Il2CppMethodPointer resolve_icall(const char* name)
+{
+  const std::string_view icall(name);
+
+  if (icall == "UnityEngine.Input::GetKeyInt(UnityEngine.KeyCode)"
+      || icall == "UnityEngine.Input::GetKeyDownInt(UnityEngine.KeyCode)") {
+    return reinterpret_cast<Il2CppMethodPointer>(&get_key_int);
+  }
+
+  std::fprintf(stderr, "mods_bench: no stub for icall %s\n", name);
+  return nullptr;
+}
+
+static std::filesystem::path prepare_environment()
+{
+  namespace fs = std::filesystem;
+
+  const char*    source = std::getenv("MODS_BENCH_CONFIG");
+  const fs::path config = source ? source : MODS_BENCH_CONFIG;
+  const fs::path root   = fs::temp_directory_path() / ("mods_bench_" + std::to_string(getpid()));
+  const fs::path dir    = root / "Preferences" / "com.stfcmod.startrekpatch";
+
+  std::error_code ec;
+  fs::create_directories(dir, ec);
+  if (ec || !fs::copy_file(config, dir / FILE_DEF_CONFIG, fs::copy_options::overwrite_existing, ec)) {
+    std::fprintf(stderr, "mods_bench: unable to stage %s: %s\n", config.string().c_str(), ec.message().c_str());
+    return {};
+  }
+
+  setenv("XDG_DATA_HOME", root.c_str(), 1);
+  setenv("XDG_CACHE_HOME", root.c_str(), 1);
+
+  return root;
+}
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  spdlog::set_level(spdlog::level::off);
+
+  const auto root = prepare_environment();
+  if (root.empty()) {
+    return 1;
+  }
+
+  il2cpp_resolve_icall = resolve_icall;
+  Bench::ClearKeys();
+
+  {
+    Bench::QuietStdout quiet;
+    (void)Config::Get();
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  std::error_code ignore;
+  std::filesystem::remove_all(root, ignore);
+
+  return 0;
+}
@@ -0,0 +1,223 @@
+#include <il2cpp/tracked_objects.h>
+
+#include <il2cpp-object-internals.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Stress test for the tracker: 100k synthetic objects spread over a few leaf classes that share
+// base classes, the way the viewer widgets share Widget/MonoBehaviour parents
+static constexpr size_t ObjectCount = 100'000;
+
+struct FakeHierarchy {
+  FakeHierarchy()
+  {
+    // object <- behaviour <- widget <- leaf
+    behaviour.parent = &root;
+    widget.parent    = &behaviour;
+    for (auto& leaf : leaves) {
+      leaf.parent = &widget;
+    }
+  }
+
+  Il2CppClass                 root{};
+  Il2CppClass                 behaviour{};
+  Il2CppClass                 widget{};
+  std::array<Il2CppClass, 13> leaves{};
+};
+
+static std::vector<Il2CppObject> make_objects(FakeHierarchy& hierarchy)
+{
+  std::vector<Il2CppObject> objects(ObjectCount);
+  for (size_t i = 0; i < objects.size(); ++i) {
+    objects[i].klass = &hierarchy.leaves[i % hierarchy.leaves.size()];
+  }
+  return objects;
+}
+
+static size_t listed_objects(TrackedObjects& tracked, FakeHierarchy& hierarchy)
+{
+  size_t count = 0;
+  for (auto& leaf : hierarchy.leaves) {
+    count += tracked.Objects<Il2CppObject>(&leaf).size();
+  }
+  return count;
+}
+
+// Track every object, then destroy them all in random order
+static void BM_TrackedObjectsChurn(benchmark::State& state)
+{
+  FakeHierarchy hierarchy;
+  auto          objects = make_objects(hierarchy);
+
+  std::vector<uintptr_t> removal_order;
+  for (auto& object : objects) {
+    removal_order.push_back(uintptr_t(&object));
+  }
+  std::shuffle(removal_order.begin(), removal_order.end(), std::mt19937{1});
+
+  for (auto _ : state) {
+    TrackedObjects tracked;
+    for (auto& object : objects) {
+      tracked.Add(object.klass, uintptr_t(&object));
+    }
+
+    // Counted without reading a class, which would have every write below republish it
+    if (tracked.size() != ObjectCount) {
+      state.SkipWithError("objects went missing");
+      break;
+    }
+
+    for (auto object : removal_order) {
+      tracked.Remove(object);
+    }
+
+    if (tracked.size() != 0 || !tracked.Objects<Il2CppObject>(&hierarchy.widget).empty()) {
+      state.SkipWithError("objects left behind after removal");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(ObjectCount) * 2);
+}
+
+BENCHMARK(BM_TrackedObjectsChurn)->Unit(benchmark::kMillisecond);
+
+// The sweep calc_liveness_hook runs after every GC mark phase, with range(0) percent of the
+// objects found dead
+static void BM_TrackedObjectsLivenessSweep(benchmark::State& state)
+{
+  FakeHierarchy hierarchy;
+  auto          objects = make_objects(hierarchy);
+
+  std::mt19937                          rng{2};
+  std::uniform_int_distribution<size_t> percent(0, 99);
+
+  // Rebuilt while the timer is paused, including freeing the previous one
+  std::unique_ptr<TrackedObjects> tracked;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    tracked = std::make_unique<TrackedObjects>();
+    for (auto& object : objects) {
+      tracked->Add(object.klass, uintptr_t(&object));
+    }
+
+    std::vector<uint8_t> dead(objects.size());
+    for (auto& d : dead) {
+      d = percent(rng) < size_t(state.range(0));
+    }
+    state.ResumeTiming();
+
+    const auto removed = tracked->RemoveIf([&](uintptr_t object) {
+      return dead[(Il2CppObject*)object - objects.data()] != 0;
+    });
+
+    state.PauseTiming();
+    if (tracked->size() + removed != ObjectCount || listed_objects(*tracked, hierarchy) != tracked->size()) {
+      state.SkipWithError("sweep lost track of objects");
+      break;
+    }
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(ObjectCount));
+}
+
+BENCHMARK(BM_TrackedObjectsLivenessSweep)
+    ->Arg(0)
+    ->Arg(10)
+    ->Arg(100)
+    ->ArgName("dead_pct")
+    ->Unit(benchmark::kMillisecond);
+
+// ObjectFinder<T>::Get with a handful of live instances
+static void BM_TrackedObjectsNewest(benchmark::State& state)
+{
+  FakeHierarchy hierarchy;
+  auto          objects = make_objects(hierarchy);
+
+  TrackedObjects tracked;
+  for (auto& object : objects) {
+    tracked.Add(object.klass, uintptr_t(&object));
+  }
+
+  // Leave three instances of the first leaf, like a few open viewers
+  auto leaf = &hierarchy.leaves[0];
+  while (tracked.Objects<Il2CppObject>(leaf).size() > 3) {
+    const auto first = tracked.Objects<Il2CppObject>(leaf)[0];
+    tracked.Remove(uintptr_t(first));
+  }
+
+  auto& published = tracked.Published(leaf);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TrackedObjects::View<Il2CppObject>{published}.newest());
+  }
+}
+
+BENCHMARK(BM_TrackedObjectsNewest);
+
+// Readers walking a class while a writer keeps adding and removing its objects, the render thread
+// against the GC and constructor hooks. Every listed object has to be live and of the class read.
+static void BM_TrackedObjectsConcurrentReads(benchmark::State& state)
+{
+  static FakeHierarchy                   hierarchy;
+  static std::vector<Il2CppObject>       objects;
+  static std::unique_ptr<TrackedObjects> tracked;
+  static std::atomic<bool>               stop;
+  static std::thread                     writer;
+
+  auto leaf = &hierarchy.leaves[0];
+
+  if (state.thread_index() == 0) {
+    objects = make_objects(hierarchy);
+    tracked = std::make_unique<TrackedObjects>();
+    for (auto& object : objects) {
+      tracked->Add(object.klass, uintptr_t(&object));
+    }
+    tracked->Published(leaf);
+
+    stop   = false;
+    writer = std::thread([] {
+      std::mt19937                          rng{3};
+      std::uniform_int_distribution<size_t> pick(0, objects.size() - 1);
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto& object = objects[pick(rng)];
+        if (!tracked->Remove(uintptr_t(&object))) {
+          tracked->Add(object.klass, uintptr_t(&object));
+        }
+      }
+    });
+  }
+
+  // Only the first thread sets up, the others wait for it here
+  for (auto _ : state) {
+    const auto view = tracked->Objects<Il2CppObject>(leaf);
+    for (auto object : view) {
+      if (object->klass != leaf) {
+        state.SkipWithError("read an object of another class");
+        break;
+      }
+    }
+
+    if (view.newest() && view.newest()->klass != leaf) {
+      state.SkipWithError("newest object is of another class");
+    }
+
+    benchmark::DoNotOptimize(view.size());
+  }
+
+  if (state.thread_index() == 0) {
+    stop = true;
+    writer.join();
+    tracked.reset();
+  }
+}
+
+BENCHMARK(BM_TrackedObjectsConcurrentReads)->Threads(1)->Threads(4)->UseRealTime();
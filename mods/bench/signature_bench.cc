@@ -0,0 +1,109 @@
+#include <spud/signature.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 64 MiB of bytes drawn with a skew towards the opcodes and operands that dominate x86-64 code, about
+// the size of the GameAssembly text section, so anchor selection sees a realistic distribution
+static std::vector<uint8_t>& synthetic_module()
+{
+  static std::vector<uint8_t> module = [] {
+    constexpr std::array<uint8_t, 16> common = {0x00, 0xFF, 0x48, 0x89, 0x8B, 0x0F, 0xE8, 0x4C,
+                                                0x24, 0x83, 0xC3, 0xCC, 0x8D, 0x85, 0x74, 0x75};
+
+    std::array<double, 256> weights;
+    weights.fill(1.0);
+    for (const auto byte : common) {
+      weights[byte] = 24.0;
+    }
+
+    std::mt19937                 rng{42};
+    std::discrete_distribution<> byte(weights.begin(), weights.end());
+    std::vector<uint8_t>         bytes(64 * 1024 * 1024);
+    for (auto& b : bytes) {
+      b = static_cast<uint8_t>(byte(rng));
+    }
+
+    return bytes;
+  }();
+
+  return module;
+}
+
+// Signatures cut from the blob, every fifth byte a wildcard like the ones in the patches
+static std::vector<std::string> make_signatures(size_t count)
+{
+  const auto&                           module = synthetic_module();
+  std::mt19937                          rng{7};
+  std::uniform_int_distribution<size_t> offset(0, module.size() - 32);
+
+  std::vector<std::string> signatures;
+  for (size_t i = 0; i < count; ++i) {
+    const auto  start = offset(rng);
+    std::string signature;
+    for (size_t j = 0; j < 24; ++j) {
+      if (!signature.empty()) {
+        signature += ' ';
+      }
+      if (j % 5 == 4) {
+        signature += '?';
+      } else {
+        signature += "0123456789ABCDEF"[module[start + j] >> 4];
+        signature += "0123456789ABCDEF"[module[start + j] & 0xF];
+      }
+    }
+    signatures.emplace_back(std::move(signature));
+  }
+
+  return signatures;
+}
+
+static void BM_SignaturePerPattern(benchmark::State& state)
+{
+  auto&      module     = synthetic_module();
+  const auto signatures = make_signatures(state.range(0));
+
+  for (auto _ : state) {
+    for (const auto& signature : signatures) {
+      benchmark::DoNotOptimize(spud::find_matches(signature, module));
+    }
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(module.size()));
+}
+
+BENCHMARK(BM_SignaturePerPattern)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->ArgName("patterns")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_SignatureSinglePass(benchmark::State& state)
+{
+  auto&      module     = synthetic_module();
+  const auto signatures = make_signatures(state.range(0));
+
+  const std::vector<std::string_view> views(signatures.begin(), signatures.end());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spud::find_many_matches(views, module));
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(module.size()));
+}
+
+BENCHMARK(BM_SignatureSinglePass)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->ArgName("patterns")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
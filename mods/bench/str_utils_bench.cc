@@ -0,0 +1,53 @@
+#include "str_utils.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+static const std::string banner_types =
+    "Standard, Achievement, IncomingAttack, IncomingAttackFaction, FleetBattle, StationBattle, StationVictory, "
+    "StationDefeat, ArmadaBattleWon, ArmadaBattleLost, ArmadaCreated, ArmadaCanceled, Treasury, AllianceStarbaseAttacked";
+
+static void BM_StrSplit(benchmark::State& state)
+{
+  for (auto _ : state) {
+    auto parts = StrSplit(banner_types, ',');
+    benchmark::DoNotOptimize(parts.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(banner_types.size()));
+}
+
+BENCHMARK(BM_StrSplit);
+
+static void BM_AsciiStrToUpper(benchmark::State& state)
+{
+  const std::string shortcut = "ctrl-shift-alt-pgdown";
+
+  for (auto _ : state) {
+    auto upper = AsciiStrToUpper(shortcut);
+    benchmark::DoNotOptimize(upper.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(shortcut.size()));
+}
+
+BENCHMARK(BM_AsciiStrToUpper);
+
+// range(0): minimum input length in bytes, mixed ASCII and multi-byte UTF-8
+static void BM_ToWString(benchmark::State& state)
+{
+  std::string text;
+  while (text.size() < static_cast<size_t>(state.range(0))) {
+    text.append("Fleet Commander \xE2\x98\x85 \xD0\x9A\xD0\xBE\xD0\xBC ");
+  }
+
+  for (auto _ : state) {
+    auto wide = to_wstring(text);
+    benchmark::DoNotOptimize(wide.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+BENCHMARK(BM_ToWString)->Arg(32)->Arg(256)->Arg(4096)->ArgName("bytes");
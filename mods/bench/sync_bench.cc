@@ -0,0 +1,140 @@
+#include "bench.h"
+
+#include "config.h"
+#include "patches/sync_replay.h"
+
+#include <prime/EntityGroup.h>
+
+#include <Digit.PrimeServer.Models.pb.h>
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Models = Digit::PrimeServer::Models;
+
+using PayloadFactory = std::string (*)(int64_t entries, int64_t generation);
+
+// Each factory serializes `entries` records; the two generations differ in every value so that
+// alternating between them makes the processors emit a record per entry.
+static std::string make_inventories(int64_t entries, int64_t generation)
+{
+  Models::InventoryResponse response;
+  auto&                     inventory = (*response.mutable_inventories())[0];
+
+  for (int64_t i = 0; i < entries; i++) {
+    auto item = inventory.add_items();
+    item->set_type(Models::INVENTORYITEMTYPE_INVENTORYCOMPONENT);
+    item->set_count(i + generation);
+    item->mutable_commonparams()->set_refid(i);
+  }
+
+  return response.SerializeAsString();
+}
+
+static std::string make_officers(int64_t entries, int64_t generation)
+{
+  Models::OfficersResponse response;
+
+  for (int64_t i = 0; i < entries; i++) {
+    auto officer = response.add_officers();
+    officer->set_id(i);
+    officer->set_level(static_cast<int32_t>(i % 60 + generation));
+    officer->set_rankindex(static_cast<int32_t>(i % 5));
+    officer->set_shardcount(static_cast<int32_t>(i % 500));
+  }
+
+  return response.SerializeAsString();
+}
+
+static std::string make_research(int64_t entries, int64_t generation)
+{
+  Models::ResearchTreesState response;
+  auto&                      levels = *response.mutable_researchprojectlevels();
+
+  for (int64_t i = 0; i < entries; i++) {
+    levels[i] = static_cast<int32_t>(i % 50 + generation);
+  }
+
+  return response.SerializeAsString();
+}
+
+// range(0): entries per payload, range(1): 1 when every entry changed since the previous payload
+static void BM_SyncProcessor(benchmark::State& state, int32_t type, PayloadFactory make)
+{
+  Config::Update([](Config& config) {
+    config.sync_capture = false;
+    for (const auto& opt : SyncOptions) {
+      config.sync_options.*opt.option = true;
+    }
+  });
+
+  const auto       entries = state.range(0);
+  const bool       changed = state.range(1) != 0;
+  const std::array payloads{make(entries, 0), make(entries, 1)};
+  int64_t          records = 0;
+
+  SyncReplay::SetRecordSink([&records](SyncConfig::Type, const nlohmann::json& batch) { records += batch.size(); });
+
+  // seed the processor's previous state with generation 0
+  SyncReplay::ProcessEntityGroup(type, std::make_unique<std::string>(payloads[0]));
+  records = 0;
+
+  size_t generation = 0;
+  for (auto _ : state) {
+    if (changed) {
+      generation ^= 1;
+    }
+
+    if (!SyncReplay::ProcessEntityGroup(type, std::make_unique<std::string>(payloads[generation]))) {
+      state.SkipWithError("no processor for entity group");
+      break;
+    }
+  }
+
+  SyncReplay::SetRecordSink({});
+
+  state.SetItemsProcessed(state.iterations() * entries);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payloads[0].size()));
+  state.counters["records"] = benchmark::Counter(static_cast<double>(records), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_SyncProcessor, inventories, EntityGroup::Type::PlayerInventories, make_inventories)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 1}})
+    ->ArgNames({"entries", "changed"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SyncProcessor, officers, EntityGroup::Type::Officers, make_officers)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 1}})
+    ->ArgNames({"entries", "changed"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SyncProcessor, research, EntityGroup::Type::ResearchTreesState, make_research)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 1}})
+    ->ArgNames({"entries", "changed"})
+    ->Unit(benchmark::kMicrosecond);
+
+// Builds and serializes a batch shaped like the inventory records, as queue_data receives them
+static void BM_JsonRecords(benchmark::State& state)
+{
+  const auto entries = state.range(0);
+  const auto type    = to_string(SyncConfig::Type::Inventory);
+  size_t     bytes   = 0;
+
+  for (auto _ : state) {
+    auto records = nlohmann::json::array();
+    for (int64_t i = 0; i < entries; i++) {
+      records.push_back({{"type", type}, {"item_type", 0}, {"refid", i}, {"count", i * 3}});
+    }
+
+    const auto body = records.dump();
+    bytes += body.size();
+    benchmark::DoNotOptimize(body.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * entries);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+BENCHMARK(BM_JsonRecords)->Arg(1000)->Arg(10000)->Arg(100000)->ArgName("entries")->Unit(benchmark::kMicrosecond);
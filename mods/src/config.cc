@@ -1,5 +1,7 @@
 #include "config.h"
 #include "file.h"
+#include "logging.h"
+#include "patches/main_thread.h"
 #include "patches/mapkey.h"
 #include "prime/KeyCode.h"
 #include "str_utils.h"
@@ -10,13 +12,26 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <filesystem>
 #include <iostream>
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include "defaultconfig.h"
 
+#if __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
 namespace DCP = DefaultConfig::Patches;
 namespace DCG = DefaultConfig::Graphics;
 namespace DCC = DefaultConfig::Control;
@@ -79,9 +94,13 @@ bool SyncConfig::enabled(SyncConfig::Type type) const
   return false;
 }
 
-Config::Config()
+const SyncTargetConfig::Filter* SyncTargetConfig::filter(SyncConfig::Type type) const
 {
-  Load();
+  if (const auto it = this->filters.find(type); it != this->filters.end()) {
+    return &it->second;
+  }
+
+  return nullptr;
 }
 
 void Config::Save(const toml::table& config, const std::string_view filename, bool apply_warning)
@@ -115,10 +134,57 @@ void Config::Save(const toml::table& config, const std::string_view filename, bo
   config_file.close();
 }
 
-Config& Config::Get()
+std::atomic<const Config*>   Config::current = nullptr;
+std::vector<Config::Retired> Config::retired;
+std::mutex                   Config::writer;
+
+// Sequentially consistent, so the load cannot be ordered ahead of the guard publishing its epoch
+Config::Snapshot::Snapshot()
+    : config(Config::current.load())
 {
-  static Config config;
-  return config;
+}
+
+Config::Snapshot Config::Get()
+{
+  if (!Config::current.load(std::memory_order_acquire)) [[unlikely]] {
+    static std::once_flag loaded;
+    std::call_once(loaded, [] {
+      auto config = std::make_unique<Config>();
+      config->Load();
+
+      std::lock_guard lk(Config::writer);
+      Config::Publish(std::move(config));
+    });
+  }
+
+  return Snapshot{};
+}
+
+// Called with the writer lock held. Replaced snapshots are freed on a later publish, once no
+// reader can still hold them.
+void Config::Publish(std::unique_ptr<Config> next)
+{
+  const auto previous = Config::current.load(std::memory_order_relaxed);
+  next->generation    = previous ? previous->generation + 1 : 1;
+
+  if (Config::current.exchange(next.release()); previous) {
+    Config::retired.push_back(Retired{previous, Epoch::Retire()});
+  }
+
+  const auto oldest = Epoch::Oldest();
+  std::erase_if(Config::retired, [oldest](const Retired& entry) {
+    if (entry.epoch >= oldest) {
+      return false;
+    }
+
+    delete entry.config;
+    return true;
+  });
+}
+
+void Config::Toggle(bool Config::* option)
+{
+  Config::Update([option](Config& config) { config.*option = !(config.*option); });
 }
 
 #if _WIN32
@@ -204,29 +270,37 @@ float Config::GetDPI()
 
 void Config::AdjustUiScale(bool scaleUp)
 {
-  if (this->ui_scale != 0.0f) {
-    auto old_scale    = this->ui_scale;
-    auto scale_factor = (scaleUp ? 1.0f : -1.0f) * this->ui_scale_adjust;
-    auto new_scale    = this->ui_scale + scale_factor;
-    this->ui_scale    = std::clamp(new_scale, 0.1f, 2.0f);
+  if (Config::Get()->ui_scale == 0.0f) {
+    return;
+  }
+
+  Config::Update([scaleUp](Config& config) {
+    auto old_scale    = config.ui_scale;
+    auto scale_factor = (scaleUp ? 1.0f : -1.0f) * config.ui_scale_adjust;
+    auto new_scale    = config.ui_scale + scale_factor;
+    config.ui_scale   = std::clamp(new_scale, 0.1f, 2.0f);
 
     auto dpi = Config::RefreshDPI();
     spdlog::info("UI has been scaled {}, was {}, now {} (unclamped {}) @ {} DPI Scaling", (scaleUp ? "UP" : "DOWN"),
-                 old_scale, this->ui_scale, new_scale, dpi);
-  }
+                 old_scale, config.ui_scale, new_scale, dpi);
+  });
 }
 
 void Config::AdjustUiViewerScale(bool scaleUp)
 {
-  if (this->ui_scale_viewer != 0.0f) {
-    auto old_scale        = this->ui_scale_viewer;
-    auto scale_factor     = (scaleUp ? 1.0f : -1.0f) * this->ui_scale_adjust;
-    auto new_scale        = this->ui_scale_viewer + (scale_factor * 0.25f);
-    this->ui_scale_viewer = std::clamp(new_scale, 0.1f, 2.0f);
+  if (Config::Get()->ui_scale_viewer == 0.0f) {
+    return;
+  }
+
+  Config::Update([scaleUp](Config& config) {
+    auto old_scale         = config.ui_scale_viewer;
+    auto scale_factor      = (scaleUp ? 1.0f : -1.0f) * config.ui_scale_adjust;
+    auto new_scale         = config.ui_scale_viewer + (scale_factor * 0.25f);
+    config.ui_scale_viewer = std::clamp(new_scale, 0.1f, 2.0f);
 
     spdlog::info("UI Viewer has been scaled {}, was {}, now {} (unclamped {})", (scaleUp ? "UP" : "DOWN"), old_scale,
-                 this->ui_scale_viewer, new_scale);
-  }
+                 config.ui_scale_viewer, new_scale);
+  });
 }
 
 inline std::string mask_token(const std::string& token)
@@ -299,6 +373,103 @@ T get_config_or_default(toml::table& config, toml::table& new_config, std::strin
   return (T)final_value;
 }
 
+// A comma separated list, entries are stripped and empty ones dropped
+std::vector<std::string> get_config_list(toml::table& config, toml::table& new_config, std::string_view section,
+                                         std::string_view item, const char* default_value, bool write_log)
+{
+  std::vector<std::string> list;
+  for (const auto& entry :
+       StrSplit(get_config_or_default<std::string>(config, new_config, section, item, default_value, write_log), ',')) {
+    if (const auto stripped = StripAsciiWhitespace(entry); !stripped.empty()) {
+      list.emplace_back(stripped);
+    }
+  }
+
+  return list;
+}
+
+void read_sync_filter_values(const toml::node_view<const toml::node> node, std::unordered_set<int64_t>& ids,
+                             std::unordered_set<std::string>& names, toml::array& parsed_values)
+{
+  const auto values = node.as_array();
+  if (!values) {
+    return;
+  }
+
+  for (const auto& value : *values) {
+    if (value.is_integer()) {
+      const auto id = value.value<int64_t>().value();
+      ids.insert(id);
+      parsed_values.push_back(id);
+    } else if (const auto name = value.value<std::string>(); name.has_value()) {
+      names.insert(name.value());
+      parsed_values.push_back(name.value());
+    }
+  }
+}
+
+void read_sync_filters(const toml::table& values, toml::table& parsed_target, SyncTargetConfig& target,
+                       const std::string& target_section)
+{
+  const auto filters = values["filters"].as_table();
+  if (!filters) {
+    return;
+  }
+
+  toml::table parsed_filters;
+
+  for (const auto& opt : SyncOptions) {
+    const auto filter_config = (*filters)[opt.type_str];
+    if (!filter_config.is_table()) {
+      continue;
+    }
+
+    SyncTargetConfig::Filter filter;
+    toml::table              parsed_filter;
+    toml::array              parsed_allow, parsed_deny, parsed_drop;
+
+    filter.key = filter_config["key"].value_or(std::string());
+
+    read_sync_filter_values(filter_config["allow"], filter.allow_ids, filter.allow_names, parsed_allow);
+    read_sync_filter_values(filter_config["deny"], filter.deny_ids, filter.deny_names, parsed_deny);
+
+    if (const auto drop = filter_config["drop"].as_array()) {
+      for (const auto& field : *drop) {
+        if (const auto name = field.value<std::string>(); name.has_value() && name.value() != "type") {
+          filter.drop.emplace_back(name.value());
+          parsed_drop.push_back(name.value());
+        }
+      }
+    }
+
+    if (filter.key.empty() && (filter.has_allow() || filter.has_deny())) {
+      spdlog::warn("Ignoring allow/deny lists in [{}.filters.{}]. Missing key.", target_section, opt.type_str);
+      filter = SyncTargetConfig::Filter{.drop = filter.drop};
+      parsed_allow.clear();
+      parsed_deny.clear();
+    }
+
+    if (!filter.has_allow() && !filter.has_deny() && filter.drop.empty()) {
+      continue;
+    }
+
+    parsed_filter.insert("key", filter.key);
+    parsed_filter.insert("allow", parsed_allow);
+    parsed_filter.insert("deny", parsed_deny);
+    parsed_filter.insert("drop", parsed_drop);
+    parsed_filters.insert(opt.type_str, parsed_filter);
+
+    spdlog::debug("config value {}.filters.{} key: {}, allow: {}, deny: {}, drop: {}", target_section, opt.type_str,
+                  filter.key, parsed_allow.size(), parsed_deny.size(), parsed_drop.size());
+
+    target.filters.insert_or_assign(opt.type, std::move(filter));
+  }
+
+  if (!parsed_filters.empty()) {
+    parsed_target.insert("filters", parsed_filters);
+  }
+}
+
 void read_sync_targets(toml::table& config, toml::table& new_config,
                        std::map<std::string, SyncTargetConfig>& sync_targets, const SyncConfig& defaults)
 {
@@ -353,6 +524,8 @@ void read_sync_targets(toml::table& config, toml::table& new_config,
       parsed_target.insert(opt.option_str, target.*opt.option);
     }
 
+    read_sync_filters(values, parsed_target, target, target_section);
+
     if (sync_targets.emplace(target_key.str(), target).second) {
       new_config["sync"]["targets"].as_table()->emplace<toml::table>(target_key.str(), parsed_target);
       spdlog::debug("config value {} url: {}, token: {}", target_section, target.url, mask_token(target.token));
@@ -360,7 +533,8 @@ void read_sync_targets(toml::table& config, toml::table& new_config,
   }
 }
 
-void parse_config_shortcut(toml::table& config, toml::table& new_config, std::string_view item,
+void parse_config_shortcut(toml::table& config, toml::table& new_config,
+                           std::array<std::vector<MapKey>, GameFunction::Max>& shortcuts, std::string_view item,
                            GameFunction gameFunction, std::string_view default_value)
 {
   auto section = "shortcuts";
@@ -375,7 +549,8 @@ void parse_config_shortcut(toml::table& config, toml::table& new_config, std::st
   auto valueLowered = AsciiStrToUpper(valueTrimmed);
   auto wantedKeys   = StrSplit(valueLowered, '|');
 
-  bool keyAdded = false;
+  auto& mapKeys  = shortcuts[gameFunction];
+  bool  keyAdded = false;
   for (std::string_view wantedKey : wantedKeys) {
     MapKey mapKey = MapKey::Parse(wantedKey);
 
@@ -383,15 +558,14 @@ void parse_config_shortcut(toml::table& config, toml::table& new_config, std::st
       keyAdded = true;
     }
 
-    MapKey::AddMappedKey(gameFunction, mapKey);
+    mapKeys.emplace_back(mapKey);
   }
 
   if (!keyAdded) {
-    MapKey mapKey = MapKey::Parse(default_value);
-    MapKey::AddMappedKey(gameFunction, mapKey);
+    mapKeys.emplace_back(MapKey::Parse(default_value));
   }
 
-  auto shortcut = MapKey::GetShortcuts(gameFunction);
+  auto shortcut = MapKey::GetShortcuts(mapKeys);
   sectionTable.as_table()->insert_or_assign(item, shortcut);
 
   spdlog::debug("shortcut value {}.{} value: {}", section, item, shortcut);
@@ -462,24 +636,27 @@ void Config::Load()
   delete_old_vars();
 
   toml::table config;
-  toml::table parsed;
   bool        write_config = false;
-  bool        write_log    = true;
   try {
     config       = std::move(toml::parse_file(File::MakePath(filename)));
     write_config = true;
   } catch (const toml::parse_error& e) {
     spdlog::warn("Failed to load config file, falling back to default settings: {}", e.description());
     spdlog::debug("");
-    write_config = false;
-    write_log    = false;
   } catch (...) {
     spdlog::warn("Failed to load config file, falling back to default settings");
     spdlog::debug("");
-    write_config = false;
-    write_log    = false;
   }
 
+  this->Load(std::move(config), write_config);
+}
+
+// write_config is false when the file did not parse and the defaults are used
+void Config::Load(toml::table config, bool write_config)
+{
+  toml::table parsed;
+  const bool  write_log = write_config;
+
 #if _MODDBG
   this->installUiScaleHooks     = get_config_or_default(config, parsed, "patches", "uiscalehooks", DCP::uiscalehooks, write_config);
   this->installZoomHooks        = get_config_or_default(config, parsed, "patches", "zoomhooks", DCP::zoomhooks, write_config);
@@ -496,6 +673,7 @@ void Config::Load()
   this->installResolutionListFix = get_config_or_default(config, parsed, "patches", "resolutionlistfix", DCP::resolutionlistfix, write_config);
   this->installSyncPatches       = get_config_or_default(config, parsed, "patches", "syncpatches", DCP::syncpatches, write_config);
   this->installObjectTracker     = get_config_or_default(config, parsed, "patches", "objecttracker", DCP::objecttracker, write_config);
+  this->installStateElisionHooks = get_config_or_default(config, parsed, "patches", "stateelisionhooks", DCP::stateelisionhooks, write_config);
   spdlog::debug("");
 #else
   this->installUiScaleHooks               = true;
@@ -513,6 +691,7 @@ void Config::Load()
   this->installResolutionListFix          = true;
   this->installSyncPatches                = true;
   this->installObjectTracker              = true;
+  this->installStateElisionHooks          = true;
 #endif
   
   this->queue_enabled       = get_config_or_default(config, parsed, "control", "queue_enabled", DCC::queue_enabled, write_config);
@@ -521,6 +700,21 @@ void Config::Load()
   this->use_scopely_hotkeys = get_config_or_default(config, parsed, "control", "use_scopely_hotkeys", DCC::use_scopely_hotkeys, write_config);
   this->select_timer        = get_config_or_default(config, parsed, "control", "select_timer", DCC::select_timer, write_config);
   this->enable_experimental = get_config_or_default(config, parsed, "control", "enable_experimental", DCC::enable_experimental, write_config);
+  this->frame_task_budget   = get_config_or_default(config, parsed, "control", "frame_task_budget", DCC::frame_task_budget, write_config);
+  this->coroutine_steps     = get_config_or_default(config, parsed, "control", "coroutine_steps", DCC::coroutine_steps, write_config);
+  this->coroutine_timeout   = get_config_or_default(config, parsed, "control", "coroutine_timeout", DCC::coroutine_timeout, write_config);
+  this->gc_growth           = get_config_or_default(config, parsed, "control", "gc_growth", DCC::gc_growth, write_config);
+  this->gc_limit            = get_config_or_default(config, parsed, "control", "gc_limit", DCC::gc_limit, write_config);
+  this->gc_unload_growth    = get_config_or_default(config, parsed, "control", "gc_unload_growth", DCC::gc_unload_growth, write_config);
+  this->profile_hooks       = get_config_or_default(config, parsed, "control", "profile_hooks", DCC::profile_hooks, write_config);
+  this->profile_interval    = get_config_or_default(config, parsed, "control", "profile_interval", DCC::profile_interval, write_config);
+  this->trace_events        = get_config_or_default(config, parsed, "control", "trace_events", DCC::trace_events, write_config);
+  this->trace_seconds       = get_config_or_default(config, parsed, "control", "trace_seconds", DCC::trace_seconds, write_config);
+  this->trace_hitch_ms      = get_config_or_default(config, parsed, "control", "trace_hitch_ms", DCC::trace_hitch_ms, write_config);
+  this->log_ui_latency      = get_config_or_default(config, parsed, "control", "log_ui_latency", DCC::log_ui_latency, write_config);
+  this->log_max_size        = get_config_or_default(config, parsed, "control", "log_max_size", DCC::log_max_size, write_config);
+  this->log_max_files       = get_config_or_default(config, parsed, "control", "log_max_files", DCC::log_max_files, write_config);
+  this->log_overflow        = get_config_or_default<std::string>(config, parsed, "control", "log_overflow", DCC::log_overflow, write_config);
 
   spdlog::debug("");
 
@@ -544,6 +738,21 @@ void Config::Load()
       get_config_or_default(config, parsed, "graphics", "borderless_fullscreen", DCG::borderless_fullscreen, write_log);
   this->transition_time      = get_config_or_default(config, parsed, "graphics", "transition_time", DCG::transition_time, write_config);
   this->show_all_resolutions = get_config_or_default(config, parsed, "graphics", "show_all_resolutions", DCG::show_all_resolutions, write_config);
+  this->fps_focused          = get_config_or_default(config, parsed, "graphics", "fps_focused", DCG::fps_focused, write_config);
+  this->fps_unfocused        = get_config_or_default(config, parsed, "graphics", "fps_unfocused", DCG::fps_unfocused, write_config);
+  this->fps_minimized        = get_config_or_default(config, parsed, "graphics", "fps_minimized", DCG::fps_minimized, write_config);
+  this->fps_idle             = get_config_or_default(config, parsed, "graphics", "fps_idle", DCG::fps_idle, write_config);
+  this->fps_idle_seconds     = get_config_or_default(config, parsed, "graphics", "fps_idle_seconds", DCG::fps_idle_seconds, write_config);
+  this->low_spec             = get_config_or_default(config, parsed, "graphics", "low_spec", DCG::low_spec, write_config);
+  this->low_spec_blur        = get_config_or_default(config, parsed, "graphics", "low_spec_blur", DCG::low_spec_blur, write_config);
+  this->low_spec_shadows     = get_config_or_default(config, parsed, "graphics", "low_spec_shadows", DCG::low_spec_shadows, write_config);
+  this->low_spec_particles   = get_config_or_default(config, parsed, "graphics", "low_spec_particles", DCG::low_spec_particles, write_config);
+  this->low_spec_transitions = get_config_or_default(config, parsed, "graphics", "low_spec_transitions", DCG::low_spec_transitions, write_config);
+  this->low_spec_render_scale =
+      get_config_or_default(config, parsed, "graphics", "low_spec_render_scale", DCG::low_spec_render_scale, write_config);
+  this->elide_set_active     = get_config_or_default(config, parsed, "graphics", "elide_set_active", DCG::elide_set_active, write_config);
+  this->elide_transform      = get_config_or_default(config, parsed, "graphics", "elide_transform", DCG::elide_transform, write_config);
+  this->elide_canvas_alpha   = get_config_or_default(config, parsed, "graphics", "elide_canvas_alpha", DCG::elide_canvas_alpha, write_config);
   this->default_system_zoom  = get_config_or_default(config, parsed, "graphics", "default_system_zoom", DCG::default_system_zoom, write_config);
 
   spdlog::debug("");
@@ -582,12 +791,27 @@ void Config::Load()
   this->show_armada_cargo      = get_config_or_default(config, parsed, "ui", "show_armada_cargo", DCU::show_armada_cargo, write_config);
 
   this->always_skip_reveal_sequence = get_config_or_default(config, parsed, "ui", "always_skip_reveal_sequence", DCU::always_skip_reveal_sequence, write_config);
+  this->animation_speed             = get_config_or_default(config, parsed, "ui", "animation_speed", DCU::animation_speed, write_config);
+
+  this->animation_keep              = get_config_list(config, parsed, "ui", "animation_keep", DCU::animation_keep, write_config);
+
+  ChatFilter::Rules chat_block, chat_mute;
+  chat_block.senders   = get_config_list(config, parsed, "ui", "chat_block_senders", DCU::chat_block_senders, write_config);
+  chat_block.alliances = get_config_list(config, parsed, "ui", "chat_block_alliances", DCU::chat_block_alliances, write_config);
+  chat_block.keywords  = get_config_list(config, parsed, "ui", "chat_block_keywords", DCU::chat_block_keywords, write_config);
+  chat_mute.senders    = get_config_list(config, parsed, "ui", "chat_mute_senders", DCU::chat_mute_senders, write_config);
+  chat_mute.alliances  = get_config_list(config, parsed, "ui", "chat_mute_alliances", DCU::chat_mute_alliances, write_config);
+  chat_mute.keywords   = get_config_list(config, parsed, "ui", "chat_mute_keywords", DCU::chat_mute_keywords, write_config);
+  this->chat_filter    = std::make_shared<const ChatFilter>(chat_block, chat_mute);
 
   spdlog::debug("");
 
   this->sync_debug              = get_config_or_default(config, parsed, "sync", "debug", DCS::debug, write_config);
   this->sync_logging            = get_config_or_default(config, parsed, "sync", "logging", DCS::logging, write_config);
   this->sync_resolver_cache_ttl = get_config_or_default(config, parsed, "sync", "resolver_cache_ttl", DCS::resolver_cache_ttl, write_config);
+  this->sync_metrics_port       = get_config_or_default(config, parsed, "sync", "metrics_port", DCS::metrics_port, write_config);
+  this->sync_stats_interval     = get_config_or_default(config, parsed, "sync", "stats_interval", DCS::stats_interval, write_config);
+  this->sync_capture            = get_config_or_default(config, parsed, "sync", "capture", DCS::capture, write_config);
 
   SyncConfig sync_defaults;
   sync_defaults.proxy      = get_config_or_default<std::string>(config, parsed, "sync", "proxy", DCS::proxy , write_log);
@@ -600,6 +824,7 @@ void Config::Load()
   spdlog::debug("");
 
   parsed["sync"].as_table()->emplace<toml::table>("targets", toml::table());
+  this->sync_targets.clear();
   read_sync_targets(config, parsed, this->sync_targets, sync_defaults);
 
   // handle legacy sync options
@@ -656,6 +881,7 @@ void Config::Load()
 
   std::string       bannerString;
   std::stringstream message;
+  this->disabled_banner_types.clear();
   message << "Parsing banner strings";
 
   spdlog::debug(message.str());
@@ -686,113 +912,120 @@ void Config::Load()
   spdlog::debug("");
 
   //if (this->enable_experimental) {
-  //  parse_config_shortcut(config, parsed, "move_left",  GameFunction::MoveLeft,  DCSH::move_left);
-  //  parse_config_shortcut(config, parsed, "move_right", GameFunction::MoveRight, DCSH::move_right);
-  //  parse_config_shortcut(config, parsed, "move_down",  GameFunction::MoveDown,  DCSH::move_down);
-  //  parse_config_shortcut(config, parsed, "move_up",    GameFunction::MoveUp,    DCSH::move_up);
+  //  parse_config_shortcut(config, parsed, this->shortcuts, "move_left",  GameFunction::MoveLeft,  DCSH::move_left);
+  //  parse_config_shortcut(config, parsed, this->shortcuts, "move_right", GameFunction::MoveRight, DCSH::move_right);
+  //  parse_config_shortcut(config, parsed, this->shortcuts, "move_down",  GameFunction::MoveDown,  DCSH::move_down);
+  //  parse_config_shortcut(config, parsed, this->shortcuts, "move_up",    GameFunction::MoveUp,    DCSH::move_up);
   //}
 
-  parse_config_shortcut(config, parsed, "set_hotkeys_disble", GameFunction::DisableHotKeys, DCSH::set_hotkeys_disabled);
-  parse_config_shortcut(config, parsed, "set_hotkeys_enable", GameFunction::EnableHotKeys,  DCSH::set_hotkeys_enabled);
-
-  parse_config_shortcut(config, parsed, "select_chatalliance", GameFunction::SelectChatAlliance, DCSH::select_chatalliance);
-  parse_config_shortcut(config, parsed, "select_chatglobal",   GameFunction::SelectChatGlobal,   DCSH::select_chatglobal);
-  parse_config_shortcut(config, parsed, "select_chatprivate",  GameFunction::SelectChatPrivate,  DCSH::select_chatprivate);
-  parse_config_shortcut(config, parsed, "quit",                GameFunction::Quit,               DCSH::quit);
-
-  parse_config_shortcut(config, parsed, "select_ship1", GameFunction::SelectShip1, DCSH::select_ship1);
-  parse_config_shortcut(config, parsed, "select_ship2", GameFunction::SelectShip2, DCSH::select_ship2);
-  parse_config_shortcut(config, parsed, "select_ship3", GameFunction::SelectShip3, DCSH::select_ship3);
-  parse_config_shortcut(config, parsed, "select_ship4", GameFunction::SelectShip4, DCSH::select_ship4);
-  parse_config_shortcut(config, parsed, "select_ship5", GameFunction::SelectShip5, DCSH::select_ship5);
-  parse_config_shortcut(config, parsed, "select_ship6", GameFunction::SelectShip6, DCSH::select_ship6);
-  parse_config_shortcut(config, parsed, "select_ship7", GameFunction::SelectShip7, DCSH::select_ship7);
-  parse_config_shortcut(config, parsed, "select_ship8", GameFunction::SelectShip8, DCSH::select_ship8);
-  parse_config_shortcut(config, parsed, "select_current", GameFunction::SelectCurrent, DCSH::select_current);
-
-  parse_config_shortcut(config, parsed, "action_primary",        GameFunction::ActionPrimary,        DCSH::action_primary);
-  parse_config_shortcut(config, parsed, "action_secondary",      GameFunction::ActionSecondary,      DCSH::action_secondary);
-  parse_config_shortcut(config, parsed, "action_queue",          GameFunction::ActionQueue,          DCSH::action_queue);
-  parse_config_shortcut(config, parsed, "action_queue_clear",    GameFunction::ActionQueueClear,     DCSH::action_queue_clear);
-  parse_config_shortcut(config, parsed, "action_view",           GameFunction::ActionView,           DCSH::action_view);
-  parse_config_shortcut(config, parsed, "action_recall",         GameFunction::ActionRecall,         DCSH::action_recall);
-  parse_config_shortcut(config, parsed, "action_recall_cancel",  GameFunction::ActionRecallCancel,   DCSH::action_recall_cancel);
-  parse_config_shortcut(config, parsed, "action_repair",         GameFunction::ActionRepair,         DCSH::action_repair);
-  parse_config_shortcut(config, parsed, "show_chat",             GameFunction::ShowChat,             DCSH::show_chat);
-  parse_config_shortcut(config, parsed, "show_chatside1",        GameFunction::ShowChatSide1,        DCSH::show_chatside1);
-  parse_config_shortcut(config, parsed, "show_chatside2",        GameFunction::ShowChatSide2,        DCSH::show_chatside2);
-  parse_config_shortcut(config, parsed, "show_galaxy",           GameFunction::ShowGalaxy,           DCSH::show_galaxy);
-  parse_config_shortcut(config, parsed, "show_system",           GameFunction::ShowSystem,           DCSH::show_system);
-  parse_config_shortcut(config, parsed, "zoom_preset1",          GameFunction::ZoomPreset1,          DCSH::zoom_preset1);
-  parse_config_shortcut(config, parsed, "zoom_preset2",          GameFunction::ZoomPreset2,          DCSH::zoom_preset2);
-  parse_config_shortcut(config, parsed, "zoom_preset3",          GameFunction::ZoomPreset3,          DCSH::zoom_preset3);
-  parse_config_shortcut(config, parsed, "zoom_preset4",          GameFunction::ZoomPreset4,          DCSH::zoom_preset4);
-  parse_config_shortcut(config, parsed, "zoom_preset5",          GameFunction::ZoomPreset5,          DCSH::zoom_preset5);
-  parse_config_shortcut(config, parsed, "zoom_in",               GameFunction::ZoomIn,               DCSH::zoom_in);
-  parse_config_shortcut(config, parsed, "zoom_out",              GameFunction::ZoomOut,              DCSH::zoom_out);
-  parse_config_shortcut(config, parsed, "zoom_max",              GameFunction::ZoomMax,              DCSH::zoom_max);
-  parse_config_shortcut(config, parsed, "zoom_min",              GameFunction::ZoomMin,              DCSH::zoom_min);
-  parse_config_shortcut(config, parsed, "zoom_reset",            GameFunction::ZoomReset,            DCSH::zoom_reset);
-  parse_config_shortcut(config, parsed, "ui_scaleup",            GameFunction::UiScaleUp,            DCSH::ui_scaleup);
-  parse_config_shortcut(config, parsed, "ui_scaledown",          GameFunction::UiScaleDown,          DCSH::ui_scaledown);
-  parse_config_shortcut(config, parsed, "ui_scaleviewerup",      GameFunction::UiViewerScaleUp,      DCSH::ui_scaleviewerup);
-  parse_config_shortcut(config, parsed, "ui_scaleviewerdown",    GameFunction::UiViewerScaleDown,    DCSH::ui_scaleviewerdown);
-
-  parse_config_shortcut(config, parsed, "log_debug",             GameFunction::LogLevelDebug,        DCSH::log_debug);
-  parse_config_shortcut(config, parsed, "log_trace",             GameFunction::LogLevelTrace,        DCSH::log_trace);
-  parse_config_shortcut(config, parsed, "log_info",              GameFunction::LogLevelInfo,         DCSH::log_info);
-  parse_config_shortcut(config, parsed, "log_warn",              GameFunction::LogLevelWarn,         DCSH::log_warn);
-  parse_config_shortcut(config, parsed, "log_error",             GameFunction::LogLevelError,        DCSH::log_error);
-  parse_config_shortcut(config, parsed, "log_off",               GameFunction::LogLevelOff,          DCSH::log_off);
-
-  parse_config_shortcut(config, parsed, "show_awayteam",         GameFunction::ShowAwayTeam,         DCSH::show_awayteam);
-  parse_config_shortcut(config, parsed, "show_gifts",            GameFunction::ShowGifts,            DCSH::show_gifts);
-  parse_config_shortcut(config, parsed, "show_artifacts",        GameFunction::ShowArtifacts,        DCSH::show_artifacts);
-  parse_config_shortcut(config, parsed, "show_commander",        GameFunction::ShowCommander,        DCSH::show_commander);
-  parse_config_shortcut(config, parsed, "show_daily",            GameFunction::ShowDaily,            DCSH::show_daily);
-  parse_config_shortcut(config, parsed, "show_events",           GameFunction::ShowEvents,           DCSH::show_events);
-  parse_config_shortcut(config, parsed, "show_exocomp",          GameFunction::ShowExoComp,          DCSH::show_exocomp);
-  parse_config_shortcut(config, parsed, "show_factions",         GameFunction::ShowFactions,         DCSH::show_factions);
-  parse_config_shortcut(config, parsed, "show_inventory",        GameFunction::ShowInventory,        DCSH::show_inventory);
-  parse_config_shortcut(config, parsed, "show_missions",         GameFunction::ShowMissions,         DCSH::show_missions);
-  parse_config_shortcut(config, parsed, "show_research",         GameFunction::ShowResearch,         DCSH::show_research);
-  parse_config_shortcut(config, parsed, "show_scrapyard",        GameFunction::ShowScrapYard,        DCSH::show_scrapyard);
-  parse_config_shortcut(config, parsed, "show_settings",         GameFunction::ShowSettings,         DCSH::show_settings);
-  parse_config_shortcut(config, parsed, "show_officers",         GameFunction::ShowOfficers,         DCSH::show_officers);
-  parse_config_shortcut(config, parsed, "show_qtrials",          GameFunction::ShowQTrials,          DCSH::show_qtrials);
-  parse_config_shortcut(config, parsed, "show_refinery",         GameFunction::ShowRefinery,         DCSH::show_refinery);
-  parse_config_shortcut(config, parsed, "show_ships",            GameFunction::ShowShips,            DCSH::show_ships);
-  parse_config_shortcut(config, parsed, "show_stationexterior",  GameFunction::ShoWStationExterior,  DCSH::show_stationexterior);
-  parse_config_shortcut(config, parsed, "show_stationinterior",  GameFunction::ShowStationInterior,  DCSH::show_stationinterior);
-  parse_config_shortcut(config, parsed, "toggle_queue",          GameFunction::ToggleQueue,          DCSH::toggle_queue);
+  for (auto& mapKeys : this->shortcuts) {
+    mapKeys.clear();
+  }
+
+  parse_config_shortcut(config, parsed, this->shortcuts, "set_hotkeys_disble", GameFunction::DisableHotKeys, DCSH::set_hotkeys_disabled);
+  parse_config_shortcut(config, parsed, this->shortcuts, "set_hotkeys_enable", GameFunction::EnableHotKeys,  DCSH::set_hotkeys_enabled);
+
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_chatalliance", GameFunction::SelectChatAlliance, DCSH::select_chatalliance);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_chatglobal",   GameFunction::SelectChatGlobal,   DCSH::select_chatglobal);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_chatprivate",  GameFunction::SelectChatPrivate,  DCSH::select_chatprivate);
+  parse_config_shortcut(config, parsed, this->shortcuts, "quit",                GameFunction::Quit,               DCSH::quit);
+
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship1", GameFunction::SelectShip1, DCSH::select_ship1);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship2", GameFunction::SelectShip2, DCSH::select_ship2);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship3", GameFunction::SelectShip3, DCSH::select_ship3);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship4", GameFunction::SelectShip4, DCSH::select_ship4);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship5", GameFunction::SelectShip5, DCSH::select_ship5);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship6", GameFunction::SelectShip6, DCSH::select_ship6);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship7", GameFunction::SelectShip7, DCSH::select_ship7);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_ship8", GameFunction::SelectShip8, DCSH::select_ship8);
+  parse_config_shortcut(config, parsed, this->shortcuts, "select_current", GameFunction::SelectCurrent, DCSH::select_current);
+
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_primary",        GameFunction::ActionPrimary,        DCSH::action_primary);
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_secondary",      GameFunction::ActionSecondary,      DCSH::action_secondary);
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_queue",          GameFunction::ActionQueue,          DCSH::action_queue);
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_queue_clear",    GameFunction::ActionQueueClear,     DCSH::action_queue_clear);
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_view",           GameFunction::ActionView,           DCSH::action_view);
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_recall",         GameFunction::ActionRecall,         DCSH::action_recall);
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_recall_cancel",  GameFunction::ActionRecallCancel,   DCSH::action_recall_cancel);
+  parse_config_shortcut(config, parsed, this->shortcuts, "action_repair",         GameFunction::ActionRepair,         DCSH::action_repair);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_chat",             GameFunction::ShowChat,             DCSH::show_chat);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_chatside1",        GameFunction::ShowChatSide1,        DCSH::show_chatside1);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_chatside2",        GameFunction::ShowChatSide2,        DCSH::show_chatside2);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_galaxy",           GameFunction::ShowGalaxy,           DCSH::show_galaxy);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_system",           GameFunction::ShowSystem,           DCSH::show_system);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_preset1",          GameFunction::ZoomPreset1,          DCSH::zoom_preset1);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_preset2",          GameFunction::ZoomPreset2,          DCSH::zoom_preset2);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_preset3",          GameFunction::ZoomPreset3,          DCSH::zoom_preset3);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_preset4",          GameFunction::ZoomPreset4,          DCSH::zoom_preset4);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_preset5",          GameFunction::ZoomPreset5,          DCSH::zoom_preset5);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_in",               GameFunction::ZoomIn,               DCSH::zoom_in);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_out",              GameFunction::ZoomOut,              DCSH::zoom_out);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_max",              GameFunction::ZoomMax,              DCSH::zoom_max);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_min",              GameFunction::ZoomMin,              DCSH::zoom_min);
+  parse_config_shortcut(config, parsed, this->shortcuts, "zoom_reset",            GameFunction::ZoomReset,            DCSH::zoom_reset);
+  parse_config_shortcut(config, parsed, this->shortcuts, "ui_scaleup",            GameFunction::UiScaleUp,            DCSH::ui_scaleup);
+  parse_config_shortcut(config, parsed, this->shortcuts, "ui_scaledown",          GameFunction::UiScaleDown,          DCSH::ui_scaledown);
+  parse_config_shortcut(config, parsed, this->shortcuts, "ui_scaleviewerup",      GameFunction::UiViewerScaleUp,      DCSH::ui_scaleviewerup);
+  parse_config_shortcut(config, parsed, this->shortcuts, "ui_scaleviewerdown",    GameFunction::UiViewerScaleDown,    DCSH::ui_scaleviewerdown);
+
+  parse_config_shortcut(config, parsed, this->shortcuts, "log_debug",             GameFunction::LogLevelDebug,        DCSH::log_debug);
+  parse_config_shortcut(config, parsed, this->shortcuts, "log_trace",             GameFunction::LogLevelTrace,        DCSH::log_trace);
+  parse_config_shortcut(config, parsed, this->shortcuts, "log_info",              GameFunction::LogLevelInfo,         DCSH::log_info);
+  parse_config_shortcut(config, parsed, this->shortcuts, "log_warn",              GameFunction::LogLevelWarn,         DCSH::log_warn);
+  parse_config_shortcut(config, parsed, this->shortcuts, "log_error",             GameFunction::LogLevelError,        DCSH::log_error);
+  parse_config_shortcut(config, parsed, this->shortcuts, "log_off",               GameFunction::LogLevelOff,          DCSH::log_off);
+  parse_config_shortcut(config, parsed, this->shortcuts, "reset_hook_profile",    GameFunction::ResetHookProfile,     DCSH::reset_hook_profile);
+  parse_config_shortcut(config, parsed, this->shortcuts, "dump_trace",            GameFunction::DumpTrace,            DCSH::dump_trace);
+  parse_config_shortcut(config, parsed, this->shortcuts, "toggle_low_spec",       GameFunction::ToggleLowSpec,        DCSH::toggle_low_spec);
+
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_awayteam",         GameFunction::ShowAwayTeam,         DCSH::show_awayteam);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_gifts",            GameFunction::ShowGifts,            DCSH::show_gifts);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_artifacts",        GameFunction::ShowArtifacts,        DCSH::show_artifacts);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_commander",        GameFunction::ShowCommander,        DCSH::show_commander);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_daily",            GameFunction::ShowDaily,            DCSH::show_daily);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_events",           GameFunction::ShowEvents,           DCSH::show_events);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_exocomp",          GameFunction::ShowExoComp,          DCSH::show_exocomp);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_factions",         GameFunction::ShowFactions,         DCSH::show_factions);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_inventory",        GameFunction::ShowInventory,        DCSH::show_inventory);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_missions",         GameFunction::ShowMissions,         DCSH::show_missions);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_research",         GameFunction::ShowResearch,         DCSH::show_research);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_scrapyard",        GameFunction::ShowScrapYard,        DCSH::show_scrapyard);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_settings",         GameFunction::ShowSettings,         DCSH::show_settings);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_officers",         GameFunction::ShowOfficers,         DCSH::show_officers);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_qtrials",          GameFunction::ShowQTrials,          DCSH::show_qtrials);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_refinery",         GameFunction::ShowRefinery,         DCSH::show_refinery);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_ships",            GameFunction::ShowShips,            DCSH::show_ships);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_stationexterior",  GameFunction::ShoWStationExterior,  DCSH::show_stationexterior);
+  parse_config_shortcut(config, parsed, this->shortcuts, "show_stationinterior",  GameFunction::ShowStationInterior,  DCSH::show_stationinterior);
+  parse_config_shortcut(config, parsed, this->shortcuts, "toggle_queue",          GameFunction::ToggleQueue,          DCSH::toggle_queue);
 
   if (this->hotkeys_extended) {
-    parse_config_shortcut(config, parsed, "show_alliance", GameFunction::ShowAlliance, DCSH::show_alliance);
+    parse_config_shortcut(config, parsed, this->shortcuts, "show_alliance", GameFunction::ShowAlliance, DCSH::show_alliance);
 
     if (this->enable_experimental) {
-      parse_config_shortcut(config, parsed, "show_alliance_help",   GameFunction::ShowAllianceHelp,   DCSH::show_alliance_help);
-      parse_config_shortcut(config, parsed, "show_alliance_armada", GameFunction::ShowAllianceArmada, DCSH::show_alliance_armada);
+      parse_config_shortcut(config, parsed, this->shortcuts, "show_alliance_help",   GameFunction::ShowAllianceHelp,   DCSH::show_alliance_help);
+      parse_config_shortcut(config, parsed, this->shortcuts, "show_alliance_armada", GameFunction::ShowAllianceArmada, DCSH::show_alliance_armada);
     }
 
-    parse_config_shortcut(config, parsed, "show_bookmarks", GameFunction::ShowBookmarks, DCSH::show_bookmarks);
+    parse_config_shortcut(config, parsed, this->shortcuts, "show_bookmarks", GameFunction::ShowBookmarks, DCSH::show_bookmarks);
 
     if (this->enable_experimental) {
-      parse_config_shortcut(config, parsed, "show_lookup", GameFunction::ShowLookup, DCSH::show_lookup);
+      parse_config_shortcut(config, parsed, this->shortcuts, "show_lookup", GameFunction::ShowLookup, DCSH::show_lookup);
     }
 
-    parse_config_shortcut(config, parsed, "set_zoom_preset1", GameFunction::SetZoomPreset1, DCSH::set_zoom_preset1);
-    parse_config_shortcut(config, parsed, "set_zoom_preset2", GameFunction::SetZoomPreset2, DCSH::set_zoom_preset2);
-    parse_config_shortcut(config, parsed, "set_zoom_preset3", GameFunction::SetZoomPreset3, DCSH::set_zoom_preset3);
-    parse_config_shortcut(config, parsed, "set_zoom_preset4", GameFunction::SetZoomPreset4, DCSH::set_zoom_preset4);
-    parse_config_shortcut(config, parsed, "set_zoom_preset5", GameFunction::SetZoomPreset5, DCSH::set_zoom_preset5);
-    parse_config_shortcut(config, parsed, "set_zoom_default", GameFunction::SetZoomDefault, DCSH::set_zoom_default);
-    parse_config_shortcut(config, parsed, "toggle_preview_locate", GameFunction::TogglePreviewLocate, DCSH::toggle_preview_locate);
-    parse_config_shortcut(config, parsed, "toggle_preview_recall", GameFunction::TogglePreviewRecall, DCSH::toggle_preview_recall);
-    parse_config_shortcut(config, parsed, "toggle_cargo_default", GameFunction::ToggleCargoDefault, DCSH::toggle_cargo_default);
-    parse_config_shortcut(config, parsed, "toggle_cargo_player",  GameFunction::ToggleCargoPlayer,  DCSH::toggle_cargo_player);
-    parse_config_shortcut(config, parsed, "toggle_cargo_station", GameFunction::ToggleCargoStation, DCSH::toggle_cargo_station);
-    parse_config_shortcut(config, parsed, "toggle_cargo_hostile", GameFunction::ToggleCargoHostile, DCSH::toggle_cargo_hostile);
-    parse_config_shortcut(config, parsed, "toggle_cargo_armada",  GameFunction::ToggleCargoArmada,  DCSH::toggle_cargo_armada);
+    parse_config_shortcut(config, parsed, this->shortcuts, "set_zoom_preset1", GameFunction::SetZoomPreset1, DCSH::set_zoom_preset1);
+    parse_config_shortcut(config, parsed, this->shortcuts, "set_zoom_preset2", GameFunction::SetZoomPreset2, DCSH::set_zoom_preset2);
+    parse_config_shortcut(config, parsed, this->shortcuts, "set_zoom_preset3", GameFunction::SetZoomPreset3, DCSH::set_zoom_preset3);
+    parse_config_shortcut(config, parsed, this->shortcuts, "set_zoom_preset4", GameFunction::SetZoomPreset4, DCSH::set_zoom_preset4);
+    parse_config_shortcut(config, parsed, this->shortcuts, "set_zoom_preset5", GameFunction::SetZoomPreset5, DCSH::set_zoom_preset5);
+    parse_config_shortcut(config, parsed, this->shortcuts, "set_zoom_default", GameFunction::SetZoomDefault, DCSH::set_zoom_default);
+    parse_config_shortcut(config, parsed, this->shortcuts, "toggle_preview_locate", GameFunction::TogglePreviewLocate, DCSH::toggle_preview_locate);
+    parse_config_shortcut(config, parsed, this->shortcuts, "toggle_preview_recall", GameFunction::TogglePreviewRecall, DCSH::toggle_preview_recall);
+    parse_config_shortcut(config, parsed, this->shortcuts, "toggle_cargo_default", GameFunction::ToggleCargoDefault, DCSH::toggle_cargo_default);
+    parse_config_shortcut(config, parsed, this->shortcuts, "toggle_cargo_player",  GameFunction::ToggleCargoPlayer,  DCSH::toggle_cargo_player);
+    parse_config_shortcut(config, parsed, this->shortcuts, "toggle_cargo_station", GameFunction::ToggleCargoStation, DCSH::toggle_cargo_station);
+    parse_config_shortcut(config, parsed, this->shortcuts, "toggle_cargo_hostile", GameFunction::ToggleCargoHostile, DCSH::toggle_cargo_hostile);
+    parse_config_shortcut(config, parsed, this->shortcuts, "toggle_cargo_armada",  GameFunction::ToggleCargoArmada,  DCSH::toggle_cargo_armada);
   }
 
   spdlog::debug("");
@@ -835,3 +1068,182 @@ void Config::Load()
                "releases\n"
             << "or visit the STFC Community Mod discord server at https://discord.gg/PrpHgs7Vjs\n\n";
 }
+
+bool Config::Reload()
+{
+  (void)Config::Get(); // the first load publishes through Get
+
+  // Parsed once, a file that changes again after this point is picked up by the next reload
+  toml::table config;
+  try {
+    config = toml::parse_file(File::MakePath(File::Config()));
+  } catch (const toml::parse_error& e) {
+    spdlog::error("Not applying changes to {}, keeping the current settings: {} (line {})", File::Config(),
+                  e.description(), e.source().begin.line);
+    return false;
+  } catch (...) {
+    spdlog::error("Not applying changes to {}, keeping the current settings", File::Config());
+    return false;
+  }
+
+  auto next = std::make_shared<Config>();
+  next->Load(std::move(config), true);
+
+  // Parsing stays on this thread, the swap waits for the end of a frame so no frame mixes the
+  // settings from before and after the edit
+  auto publish = [next = std::move(next)] {
+    const auto previous        = Config::Get();
+    const auto logging_changed = next->log_max_size != previous->log_max_size
+                              || next->log_max_files != previous->log_max_files
+                              || next->log_overflow != previous->log_overflow;
+
+    {
+      std::lock_guard lk(Config::writer);
+      Config::Publish(std::make_unique<Config>(std::move(*next)));
+    }
+
+    if (logging_changed) {
+      Logging::Configure(*Config::Get());
+    }
+
+    spdlog::info("Applied changes to {}", File::Config());
+  };
+
+  if (MainThread::Running()) {
+    MainThread::Post(std::move(publish), MainThread::Priority::High);
+  } else {
+    publish();
+  }
+
+  return true;
+}
+
+// Saving from an editor is usually a burst of events (truncate, write, rename over the original),
+// so wait for it to settle before reading the file
+static constexpr auto ConfigSettleTime = std::chrono::milliseconds(250);
+
+static std::filesystem::file_time_type config_write_time;
+
+// Only reloads when the modification time moved, which folds duplicate notifications together
+static void reload_if_changed(const std::filesystem::path& path)
+{
+  std::error_code ec;
+  const auto      write_time = std::filesystem::last_write_time(path, ec);
+  if (ec || write_time == config_write_time) {
+    return;
+  }
+
+  config_write_time = write_time;
+  Config::Reload();
+}
+
+#if _WIN32
+static void watch_config_file(std::filesystem::path path)
+{
+  const auto directory =
+      CreateFileW(path.parent_path().c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                  nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+  if (directory == INVALID_HANDLE_VALUE) {
+    spdlog::error("Unable to watch {} for changes (error {})", path.string(), GetLastError());
+    return;
+  }
+
+  const auto filename = path.filename().wstring();
+
+  alignas(DWORD) BYTE buffer[4096];
+  DWORD               length = 0;
+
+  while (ReadDirectoryChangesW(directory, buffer, sizeof(buffer), FALSE,
+                               FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE, &length, nullptr, nullptr)) {
+    // nothing returned means the buffer overflowed and the events were dropped
+    auto changed = length == 0;
+
+    for (DWORD offset = 0; !changed && offset < length;) {
+      const auto info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+      const auto size = info->FileNameLength / sizeof(WCHAR);
+
+      changed = size == filename.size() && _wcsnicmp(info->FileName, filename.c_str(), size) == 0;
+
+      if (info->NextEntryOffset == 0) {
+        break;
+      }
+      offset += info->NextEntryOffset;
+    }
+
+    if (changed) {
+      std::this_thread::sleep_for(ConfigSettleTime);
+      reload_if_changed(path);
+    }
+  }
+
+  CloseHandle(directory);
+}
+#elif __linux__
+static void watch_config_file(std::filesystem::path path)
+{
+  const auto fd = inotify_init1(IN_CLOEXEC);
+  if (fd < 0 || inotify_add_watch(fd, path.parent_path().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    spdlog::error("Unable to watch {} for changes: {}", path.string(), strerror(errno));
+    if (fd >= 0) {
+      close(fd);
+    }
+    return;
+  }
+
+  const auto filename = path.filename().string();
+
+  alignas(inotify_event) char buffer[4096];
+
+  for (;;) {
+    const auto length = read(fd, buffer, sizeof(buffer));
+    if (length < 0 && errno == EINTR) {
+      continue;
+    }
+    if (length <= 0) {
+      break;
+    }
+
+    auto changed = false;
+    for (ssize_t offset = 0; offset < length;) {
+      const auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+      changed |= event->len > 0 && filename == event->name;
+      offset += sizeof(inotify_event) + event->len;
+    }
+
+    if (!changed) {
+      continue;
+    }
+
+    pollfd pending{fd, POLLIN, 0};
+    while (poll(&pending, 1, ConfigSettleTime.count()) > 0 && read(fd, buffer, sizeof(buffer)) > 0) {
+    }
+
+    reload_if_changed(path);
+  }
+
+  close(fd);
+}
+#else
+// No notification API wired up here, a stat once a second is cheap enough
+static void watch_config_file(std::filesystem::path path)
+{
+  for (;;) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    reload_if_changed(path);
+  }
+}
+#endif
+
+void Config::Watch()
+{
+  static std::once_flag started;
+  std::call_once(started, [] {
+    const auto path = std::filesystem::path(File::MakePath(File::Config()));
+
+    std::error_code ec;
+    config_write_time = std::filesystem::last_write_time(path, ec);
+
+    std::thread(watch_config_file, path).detach();
+    spdlog::info("Watching {} for changes", File::Config());
+  });
+}
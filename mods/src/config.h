@@ -1,8 +1,17 @@
 #pragma once
 
+#include "epoch.h"
+#include "patches/chat_filter.h"
+#include "patches/mapkey.h"
+
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <toml++/toml.h>
@@ -86,6 +95,18 @@ constexpr std::string to_string(const SyncConfig::Type type)
   return {};
 }
 
+// Same as to_string, for callers that keep the pointer (the names are literals)
+constexpr const char* to_c_str(const SyncConfig::Type type)
+{
+  for (const auto& opt : SyncOptions) {
+    if (opt.type == type) {
+      return opt.type_str.data();
+    }
+  }
+
+  return "";
+}
+
 constexpr std::string operator+(const std::string& prefix, const SyncConfig::Type type)
 {
   return prefix + to_string(type);
@@ -99,18 +120,65 @@ constexpr std::string operator+(const SyncConfig::Type type, const std::string&
 class SyncTargetConfig : public SyncConfig
 {
 public:
+  // Compiled from [sync.targets.<name>.filters.<type>], applied to each record before serialization
+  struct Filter {
+    std::string                     key;         // record field matched against allow/deny
+    std::unordered_set<int64_t>     allow_ids;
+    std::unordered_set<std::string> allow_names;
+    std::unordered_set<int64_t>     deny_ids;
+    std::unordered_set<std::string> deny_names;
+    std::vector<std::string>        drop;        // fields removed from every record
+
+    [[nodiscard]] bool has_allow() const { return !allow_ids.empty() || !allow_names.empty(); }
+    [[nodiscard]] bool has_deny() const { return !deny_ids.empty() || !deny_names.empty(); }
+  };
+
   std::string url;
   std::string token;
+
+  std::map<Type, Filter> filters;
+
+  [[nodiscard]] const Filter* filter(Type type) const;
 };
 
+// The settings are published as immutable snapshots. A change, whether a hotkey toggle or an edit
+// of the settings file, copies the current snapshot, modifies the copy and publishes it. Get()
+// never locks: it pins the snapshot current at the call through an epoch guard (epoch.h), and a
+// replaced snapshot is freed once no handle that could still see it is left.
 class Config final
 {
 public:
-  Config();
+  // The snapshot current when Get() was called, valid while the handle lives. Handles belong to
+  // one thread and are only meant to live for the length of a read.
+  class Snapshot
+  {
+  public:
+    Snapshot(const Snapshot&)            = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    const Config* operator->() const
+    {
+      return this->config;
+    }
+
+    const Config& operator*() const
+    {
+      return *this->config;
+    }
+
+  private:
+    friend class Config;
+    Snapshot();
 
-  [[nodiscard]] static Config& Get();
-  [[nodiscard]] static float   GetDPI();
-  static float                 RefreshDPI();
+    Epoch::ReadGuard guard;
+    const Config*    config;
+  };
+
+  Config() = default;
+
+  [[nodiscard]] static Snapshot Get();
+  [[nodiscard]] static float         GetDPI();
+  static float                       RefreshDPI();
 
 #ifdef _WIN32
   [[nodiscard]] static HWND WindowHandle();
@@ -118,14 +186,33 @@ public:
 
   static void Save(const toml::table& config, std::string_view filename, bool apply_warning = true);
   void        Load();
-  void        AdjustUiScale(bool scaleUp);
-  void        AdjustUiViewerScale(bool scaleUp);
+  void        Load(toml::table config, bool write_config);
+
+  // Publishes a copy of the current snapshot with fn applied to it
+  template <typename Fn> static void Update(Fn&& fn)
+  {
+    (void)Config::Get(); // loads the settings on first use
+
+    std::lock_guard lk(Config::writer);
+
+    auto next = std::make_unique<Config>(*Config::Get());
+    fn(*next);
+    Config::Publish(std::move(next));
+  }
+
+  static void Toggle(bool Config::* option);
+  static void AdjustUiScale(bool scaleUp);
+  static void AdjustUiViewerScale(bool scaleUp);
+
+  // Re-reads the settings file and publishes it, from the main thread between two frames once
+  // the frame hook runs. The current settings stay in place if the file does not parse.
+  static bool Reload();
 
-  // Disallow copying/moving to enforce singleton
-  Config(const Config&)            = delete;
-  Config& operator=(const Config&) = delete;
-  Config(Config&&)                 = delete;
-  Config& operator=(Config&&)      = delete;
+  // Reloads the settings whenever the file changes on disk, from a background thread
+  static void Watch();
+
+  // Bumped by every publish
+  uint64_t generation;
 
   float ui_scale;
   float ui_scale_adjust;
@@ -135,6 +222,20 @@ public:
   bool  free_resize;
   bool  adjust_scale_res;
   bool  show_all_resolutions;
+  int   fps_focused;
+  int   fps_unfocused;
+  int   fps_minimized;
+  int   fps_idle;
+  int   fps_idle_seconds;
+  bool  low_spec;
+  bool  low_spec_blur;
+  bool  low_spec_shadows;
+  bool  low_spec_particles;
+  bool  low_spec_transitions;
+  float low_spec_render_scale;
+  bool  elide_set_active;
+  bool  elide_transform;
+  bool  elide_canvas_alpha;
 
   bool  use_out_of_dock_power;
   float system_pan_momentum;
@@ -142,6 +243,12 @@ public:
 
   float keyboard_zoom_speed;
   int   select_timer;
+  float frame_task_budget;
+  int   coroutine_steps;
+  int   coroutine_timeout;
+  int   gc_growth;
+  int   gc_limit;
+  int   gc_unload_growth;
 
   bool  queue_enabled;
   bool  hotkeys_enabled;
@@ -149,6 +256,16 @@ public:
   bool  use_scopely_hotkeys;
   bool  use_presets_as_default;
   bool  enable_experimental;
+  bool  profile_hooks;
+  int   profile_interval;
+  bool  trace_events;
+  int   trace_seconds;
+  int   trace_hitch_ms;
+  bool  log_ui_latency;
+  int   log_max_size;
+  int   log_max_files;
+
+  std::string log_overflow;
   float default_system_zoom;
 
   float system_zoom_preset_1;
@@ -169,6 +286,9 @@ public:
   bool disable_escape_exit;
   bool disable_galaxy_chat;
   bool disable_veil_chat;
+
+  // Compiled once per load, the copies Update makes share it
+  std::shared_ptr<const ChatFilter> chat_filter;
   bool disable_first_popup;
   bool disable_toast_banners;
 
@@ -180,9 +300,15 @@ public:
 
   bool always_skip_reveal_sequence;
 
+  float                    animation_speed;
+  std::vector<std::string> animation_keep;
+
   bool       sync_logging;
   bool       sync_debug;
   int        sync_resolver_cache_ttl;
+  int        sync_metrics_port;
+  int        sync_stats_interval;
+  bool       sync_capture;
   SyncConfig sync_options;
 
   std::map<std::string, SyncTargetConfig> sync_targets;
@@ -202,7 +328,23 @@ public:
   bool installResolutionListFix;
   bool installSyncPatches;
   bool installObjectTracker;
+  bool installStateElisionHooks;
 
   std::string config_settings_url;
   std::string config_assets_url_override;
+
+  std::array<std::vector<MapKey>, GameFunction::Max> shortcuts;
+
+private:
+  struct Retired {
+    const Config* config;
+    uint64_t      epoch;
+  };
+
+  static void Publish(std::unique_ptr<Config> next);
+
+  // writer serializes the copy, modify and publish of a change, and guards retired
+  static std::atomic<const Config*> current;
+  static std::vector<Retired>       retired;
+  static std::mutex                 writer;
 };
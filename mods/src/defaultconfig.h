@@ -21,6 +21,22 @@ namespace Control
   constexpr bool use_scopely_hotkeys = false;
   constexpr bool queue_enabled       = true;
   constexpr auto select_timer        = 500;
+  constexpr auto frame_task_budget   = 2.0;
+  constexpr auto coroutine_steps     = 16;
+  constexpr auto coroutine_timeout   = 30;
+  constexpr auto gc_growth           = 0;
+  constexpr auto gc_limit            = 0;
+  constexpr auto gc_unload_growth    = 0;
+  constexpr bool profile_hooks       = false;
+  constexpr auto profile_interval    = 10;
+  constexpr bool trace_events        = false;
+  constexpr auto trace_seconds       = 10;
+  constexpr auto trace_hitch_ms      = 0;
+  constexpr bool log_ui_latency      = false;
+  constexpr auto log_max_size        = 10;
+  constexpr auto log_max_files       = 3;
+
+  constexpr const char* log_overflow = "drop_oldest";
 } // namespace Control
 
 namespace Graphics
@@ -28,8 +44,22 @@ namespace Graphics
   constexpr bool borderless_fullscreen       = true;
   constexpr bool allow_cursor                = true;
   constexpr auto default_system_zoom         = 1750;
+  constexpr bool elide_canvas_alpha          = true;
+  constexpr bool elide_set_active            = true;
+  constexpr bool elide_transform             = true;
   constexpr bool free_resize                 = true;
+  constexpr auto fps_focused                 = 0;
+  constexpr auto fps_idle                    = 0;
+  constexpr auto fps_idle_seconds            = 0;
+  constexpr auto fps_minimized               = 0;
+  constexpr auto fps_unfocused               = 0;
   constexpr auto keyboard_zoom_speed         = 350;
+  constexpr bool low_spec                    = false;
+  constexpr bool low_spec_blur               = true;
+  constexpr bool low_spec_particles          = true;
+  constexpr auto low_spec_render_scale       = 0.75;
+  constexpr bool low_spec_shadows            = true;
+  constexpr bool low_spec_transitions        = true;
   constexpr bool show_all_resolutions        = false;
   constexpr auto system_pan_momentum_falloff = 0.8;
   constexpr auto system_pan_momentum         = 0.4;
@@ -57,6 +87,7 @@ namespace Patches
   constexpr bool objecttracker              = true;
   constexpr bool panhooks                   = true;
   constexpr bool resolutionlistfix          = true;
+  constexpr bool stateelisionhooks          = true;
   constexpr bool syncpatches                = true;
   constexpr bool tempcrashfixes             = true;
   constexpr bool testpatches                = true;
@@ -79,6 +110,9 @@ namespace Shortcuts
   constexpr const char* set_hotkeys_disabled  = "CTRL-ALT-MINUS";
   constexpr const char* set_hotkeys_enabled   = "CTRL-ALT-=";
   constexpr const char* log_off               = "CTRL-SHIFT-F12";
+  constexpr const char* reset_hook_profile    = "CTRL-SHIFT-F6";
+  constexpr const char* dump_trace            = "CTRL-SHIFT-F5";
+  constexpr const char* toggle_low_spec       = "CTRL-SHIFT-F4";
   constexpr const char* log_error             = "CTRL-SHIFT-F11";
   constexpr const char* log_warn              = "CTRL-SHIFT-F10";
   constexpr const char* log_debug             = "CTRL-SHIFT-F9";
@@ -181,11 +215,22 @@ namespace Sync
   constexpr bool        logging            = false;
   constexpr bool        verify_ssl         = true;
   constexpr auto        resolver_cache_ttl = 300;
+  constexpr int         metrics_port       = 0;
+  constexpr int         stats_interval     = 60;
+  constexpr bool        capture            = false;
 } // namespace Sync
 
 namespace UI
 {
   constexpr bool        always_skip_reveal_sequence = true;
+  constexpr const char* animation_keep              = "";
+  constexpr auto        animation_speed             = 1.0;
+  constexpr const char* chat_block_alliances        = "";
+  constexpr const char* chat_block_keywords         = "";
+  constexpr const char* chat_block_senders          = "";
+  constexpr const char* chat_mute_alliances         = "";
+  constexpr const char* chat_mute_keywords          = "";
+  constexpr const char* chat_mute_senders           = "";
   constexpr bool        auto_confirm_discovery      = true;
   constexpr bool        disable_escape_exit         = true;
   constexpr bool        disable_first_popup         = false;
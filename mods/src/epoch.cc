@@ -0,0 +1,93 @@
+#include "epoch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace
+{
+constexpr size_t ReaderSlotCount = 64;
+
+struct alignas(64) ReaderSlot {
+  std::atomic<uint64_t> epoch{0};
+  std::atomic<bool>     claimed{false};
+};
+
+ReaderSlot            reader_slots[ReaderSlotCount];
+std::atomic<uint64_t> global_epoch{1};
+std::atomic<uint32_t> unslotted_readers{0};
+
+struct ThreadReader {
+  ThreadReader()
+  {
+    for (auto& candidate : reader_slots) {
+      bool expected = false;
+      if (candidate.claimed.compare_exchange_strong(expected, true)) {
+        this->slot = &candidate;
+        break;
+      }
+    }
+  }
+
+  ~ThreadReader()
+  {
+    if (this->slot) {
+      this->slot->claimed.store(false, std::memory_order_release);
+    }
+  }
+
+  ReaderSlot* slot  = nullptr;
+  uint32_t    depth = 0;
+};
+
+thread_local ThreadReader thread_reader;
+} // namespace
+
+Epoch::ReadGuard::ReadGuard()
+{
+  auto& reader = thread_reader;
+  if (reader.depth++ > 0) {
+    return;
+  }
+
+  if (reader.slot) {
+    reader.slot->epoch.store(global_epoch.load());
+  } else {
+    unslotted_readers.fetch_add(1);
+  }
+}
+
+Epoch::ReadGuard::~ReadGuard()
+{
+  auto& reader = thread_reader;
+  if (--reader.depth > 0) {
+    return;
+  }
+
+  if (reader.slot) {
+    reader.slot->epoch.store(0, std::memory_order_release);
+  } else {
+    unslotted_readers.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+uint64_t Epoch::Retire()
+{
+  return global_epoch.fetch_add(1);
+}
+
+uint64_t Epoch::Oldest()
+{
+  if (unslotted_readers.load() != 0) {
+    return 0;
+  }
+
+  auto oldest = UINT64_MAX;
+  for (auto& slot : reader_slots) {
+    if (const auto epoch = slot.epoch.load(); epoch != 0) {
+      oldest = std::min(oldest, epoch);
+    }
+  }
+
+  return oldest;
+}
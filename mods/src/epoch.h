@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// Epoch-based reclamation for data published through an atomic pointer and read without locks.
+//
+// Each reading thread owns a slot holding the epoch it pinned (0 when idle). A writer that swaps
+// out a pointer retires it at Retire(); readers that pinned an epoch <= that one may still hold it,
+// so it can be freed once Oldest() is past it. Threads that find every slot taken are counted
+// instead, and hold off all reclamation while they read.
+class Epoch
+{
+public:
+  // Pins the current epoch for the calling thread; pointers loaded while it is alive stay valid.
+  // Guards nest, and are only meant to live for the length of a read. Load the pointer with a
+  // sequentially consistent load after the guard is constructed.
+  class ReadGuard
+  {
+  public:
+    ReadGuard();
+    ~ReadGuard();
+
+    ReadGuard(const ReadGuard&)            = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+  };
+
+  // Call after the pointer was swapped out, returns the epoch it is retired at
+  static uint64_t Retire();
+
+  // Anything retired at an epoch below this can be freed; 0 while a reader without a slot is
+  // inside a guard
+  static uint64_t Oldest();
+};
@@ -69,6 +69,51 @@ const char* File::Battles()
   return cacheNameBattles.c_str();
 }
 
+const char* File::Stats()
+{
+  if (!File::initialized) {
+    File::Init();
+  }
+
+  return cacheNameStats.c_str();
+}
+
+const char* File::Capture()
+{
+  if (!File::initialized) {
+    File::Init();
+  }
+
+  return cacheNameCapture.c_str();
+}
+
+const char* File::Symbols()
+{
+  if (!File::initialized) {
+    File::Init();
+  }
+
+  return cacheNameSymbols.c_str();
+}
+
+const char* File::Profile()
+{
+  if (!File::initialized) {
+    File::Init();
+  }
+
+  return cacheNameProfile.c_str();
+}
+
+const char* File::Trace()
+{
+  if (!File::initialized) {
+    File::Init();
+  }
+
+  return cacheNameTrace.c_str();
+}
+
 std::wstring File::Title()
 {
   if (!File::initialized) {
@@ -184,6 +229,61 @@ void File::Init()
       cacheNameBattles = std::string(FILE_DEF_BL);
     }
 
+    /*******************************
+     *
+     * Set the sync stats file name
+     *
+     *******************************/
+    if (File::override) {
+      cacheNameStats = std::filesystem::path(configPath).replace_extension(FILE_EXT_STATS).string();
+    } else {
+      cacheNameStats = std::string(FILE_DEF_STATS);
+    }
+
+    /*******************************
+     *
+     * Set the sync capture file name
+     *
+     *******************************/
+    if (File::override) {
+      cacheNameCapture = std::filesystem::path(configPath).replace_extension(FILE_EXT_CAPTURE).string();
+    } else {
+      cacheNameCapture = std::string(FILE_DEF_CAPTURE);
+    }
+
+    /*******************************
+     *
+     * Set the hook profile file name
+     *
+     *******************************/
+    if (File::override) {
+      cacheNameProfile = std::filesystem::path(configPath).replace_extension(FILE_EXT_PROFILE).string();
+    } else {
+      cacheNameProfile = std::string(FILE_DEF_PROFILE);
+    }
+
+    /*******************************
+     *
+     * Set the trace file name, dumps add the reason and time before the extension
+     *
+     *******************************/
+    if (File::override) {
+      cacheNameTrace = std::filesystem::path(configPath).replace_extension(FILE_EXT_TRACE).string();
+    } else {
+      cacheNameTrace = std::string(FILE_DEF_TRACE);
+    }
+
+    /*******************************
+     *
+     * Set the symbol cache file name
+     *
+     *******************************/
+    if (File::override) {
+      cacheNameSymbols = std::filesystem::path(configPath).replace_extension(FILE_EXT_SYMBOLS).string();
+    } else {
+      cacheNameSymbols = std::string(FILE_DEF_SYMBOLS);
+    }
+
     /*******************************
      *
      * Set the log file name
@@ -250,6 +350,11 @@ bool File::initialized = false;
 std::wstring File::cacheNameTitle = L"";
 
 std::string File::cacheNameBattles = "";
+std::string File::cacheNameStats   = "";
+std::string File::cacheNameCapture = "";
+std::string File::cacheNameSymbols = "";
+std::string File::cacheNameProfile = "";
+std::string File::cacheNameTrace   = "";
 std::string File::cacheNameLog     = "";
 std::string File::cacheNameVar     = "";
 std::string File::cacheNameConfig  = "";
@@ -28,6 +28,11 @@
 #define FILE_DEF_VARS "community_patch_runtime.vars"
 #define FILE_DEF_VARS_OLD "community_path_runtime.vars"
 #define FILE_DEF_BL "patch_battlelogs_sent.json"
+#define FILE_DEF_STATS "community_patch_sync_stats.json"
+#define FILE_DEF_CAPTURE "community_patch_sync_capture.bin"
+#define FILE_DEF_SYMBOLS "community_patch_symbols.cache"
+#define FILE_DEF_PROFILE "community_patch_hook_profile.json"
+#define FILE_DEF_TRACE "community_patch_trace.json"
 #define FILE_DEF_PARSED "community_patch_settings_parsed.toml"
 #define FILE_DEF_TITLE L"Star Trek Fleet Command"
 
@@ -35,6 +40,11 @@
 #define FILE_EXT_VARS ".vars"
 #define FILE_EXT_LOG ".log"
 #define FILE_EXT_JSON ".json"
+#define FILE_EXT_STATS ".sync_stats.json"
+#define FILE_EXT_CAPTURE ".sync_capture.bin"
+#define FILE_EXT_SYMBOLS ".symbols.cache"
+#define FILE_EXT_PROFILE ".hook_profile.json"
+#define FILE_EXT_TRACE ".trace.json"
 
 class File
 {
@@ -46,6 +56,11 @@ public:
   static const char*  Vars();
   static const char*  Log();
   static const char*  Battles();
+  static const char*  Stats();
+  static const char*  Capture();
+  static const char*  Symbols();
+  static const char*  Profile();
+  static const char*  Trace();
   static bool         hasCustomNames();
   static bool         hasDebug();
   static bool         hasTrace();
@@ -66,6 +81,11 @@ private:
 
   static std::wstring cacheNameTitle;
   static std::string  cacheNameBattles;
+  static std::string  cacheNameStats;
+  static std::string  cacheNameCapture;
+  static std::string  cacheNameSymbols;
+  static std::string  cacheNameProfile;
+  static std::string  cacheNameTrace;
   static std::string  cacheNameLog;
   static std::string  cacheNameVar;
   static std::string  cacheNameConfig;
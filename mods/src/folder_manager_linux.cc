@@ -0,0 +1,37 @@
+#if !_WIN32 && !__APPLE__
+#include "folder_manager.h"
+
+#include <cstdlib>
+#include <string>
+
+using namespace fm;
+
+// Maps the Foundation search paths onto XDG locations so the mod and its tools can run on Linux
+const char* FolderManager::pathForDirectory(SearchPathDirectory directory, SearchPathDomainMask domainMask)
+{
+  static thread_local std::string path;
+
+  const char* home = std::getenv("HOME");
+  const char* xdg  = nullptr;
+
+  switch (directory) {
+    case NSCachesDirectory:
+      xdg  = std::getenv("XDG_CACHE_HOME");
+      path = xdg ? xdg : std::string(home ? home : ".") + "/.cache";
+      break;
+    default:
+      xdg  = std::getenv("XDG_DATA_HOME");
+      path = xdg ? xdg : std::string(home ? home : ".") + "/.local/share";
+      break;
+  }
+
+  return path.c_str();
+}
+
+const char* FolderManager::pathForDirectoryAppropriateForItemAtPath(SearchPathDirectory  directory,
+                                                                    SearchPathDomainMask domainMask,
+                                                                    const char* itemPath, bool create)
+{
+  return pathForDirectory(directory, domainMask);
+}
+#endif
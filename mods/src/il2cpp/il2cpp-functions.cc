@@ -5,9 +5,11 @@
 #if !_WIN32
 #include <dlfcn.h>
 #include <libgen.h>
+#if __APPLE__
 #include <mach-o/dyld.h>
 
 #define PATH_MAX 1024
+#endif
 #if defined(__cplusplus)
 extern "C" {
 #endif // __cplusplus
@@ -23,7 +25,7 @@ extern "C" {
 
 void init_il2cpp_pointers()
 {
-#if !_WIN32
+#if __APPLE__
   char     buf[PATH_MAX];
   uint32_t bufsize = PATH_MAX;
   _NSGetExecutablePath(buf, &bufsize);
@@ -1,17 +1,23 @@
 #pragma once
 
 #include "il2cpp-functions.h"
+#include "il2cpp_index.h"
+#include "il2cpp_symbol_cache.h"
+#include "tracked_objects.h"
 
 #include <il2cpp-api-types.h>
 #include <il2cpp-class-internals.h>
 #include <il2cpp-config.h>
 #include <il2cpp-object-internals.h>
+#include <il2cpp-tabledefs.h>
 #include <utils/Il2CppHashMap.h>
 
 #include <EASTL/span.h>
 #include <EASTL/unordered_map.h>
 #include <EASTL/vector.h>
 
+#include <type_traits>
+
 #if !_WIN32
 #include <syslog.h>
 #include <unistd.h>
@@ -86,6 +92,137 @@ private:
   const PropertyInfo* propInfo;
 };
 
+// Typed property access that calls the getter/setter's native methodPointer directly, using the
+// il2cpp calling convention (this, args..., const MethodInfo*), without boxing or exception frames.
+// The methods are resolved once; overridable ones are looked up on the instance per call. Methods
+// without a compiled pointer fall back to il2cpp_runtime_invoke.
+//
+// T is the property type as the game stores it: a pointer for reference types, the value for
+// value types. Exceptions thrown by the game's getter propagate instead of being swallowed.
+template <typename T> class IL2CppPropertyAccessor
+{
+public:
+  IL2CppPropertyAccessor(Il2CppClass* cls, const PropertyInfo* propInfo)
+  {
+    this->cls      = cls;
+    this->propInfo = propInfo;
+
+    if (propInfo) {
+      this->getter = il2cpp_property_get_get_method((PropertyInfo*)propInfo);
+      this->setter = il2cpp_property_get_set_method((PropertyInfo*)propInfo);
+    }
+
+    this->getterVirtual = is_overridable(this->getter);
+    this->setterVirtual = is_overridable(this->setter);
+  }
+
+  bool isValidHelper()
+  {
+#if DEBUG
+    return true;
+#else
+    return this->cls != nullptr && propInfo != nullptr;
+#endif
+  }
+
+  T Get(void* _this) const
+  {
+    auto method = this->getterVirtual ? resolve_virtual(_this, this->getter) : this->getter;
+    if (!callable(method, _this)) {
+      return T{};
+    }
+
+    if (method->methodPointer) {
+      if (method->flags & METHOD_ATTRIBUTE_STATIC) {
+        return ((T(*)(const MethodInfo*))method->methodPointer)(method);
+      }
+
+      return ((T(*)(void*, const MethodInfo*))method->methodPointer)(_this, method);
+    }
+
+    Il2CppException* exception = nullptr;
+    auto             result    = il2cpp_runtime_invoke(method, _this, nullptr, &exception);
+    if (exception || !result) {
+      return T{};
+    }
+
+    if constexpr (std::is_pointer_v<T>) {
+      return (T)result;
+    } else {
+      return *(T*)il2cpp_object_unbox(result);
+    }
+  }
+
+  // For properties declared on a value type, _this is the boxed struct
+  T GetUnboxedSelf(void* _this) const
+  {
+    if (!_this || !this->getter || !this->getter->methodPointer) {
+      return T{};
+    }
+
+    return ((T(*)(void*, const MethodInfo*))this->getter->methodPointer)(
+        il2cpp_object_unbox((Il2CppObject*)_this), this->getter);
+  }
+
+  void Set(void* _this, T v) const
+  {
+    auto method = this->setterVirtual ? resolve_virtual(_this, this->setter) : this->setter;
+    if (!callable(method, _this)) {
+      return;
+    }
+
+    if (method->methodPointer) {
+      if (method->flags & METHOD_ATTRIBUTE_STATIC) {
+        ((void (*)(T, const MethodInfo*))method->methodPointer)(v, method);
+      } else {
+        ((void (*)(void*, T, const MethodInfo*))method->methodPointer)(_this, v, method);
+      }
+
+      return;
+    }
+
+    Il2CppException* exception = nullptr;
+    void*            params[1];
+
+    if constexpr (std::is_pointer_v<T>) {
+      params[0] = (void*)v;
+    } else {
+      params[0] = &v;
+    }
+
+    il2cpp_runtime_invoke(method, _this, params, &exception);
+  }
+
+private:
+  static bool is_overridable(const MethodInfo* method)
+  {
+    if (!method || !(method->flags & METHOD_ATTRIBUTE_VIRTUAL) || (method->flags & METHOD_ATTRIBUTE_FINAL)) {
+      return false;
+    }
+
+    return !method->klass || !(method->klass->flags & TYPE_ATTRIBUTE_SEALED);
+  }
+
+  // An instance method on a null object reads as the default, the way the NullReferenceException
+  // from il2cpp_runtime_invoke did, instead of handing the game's code a null this
+  static bool callable(const MethodInfo* method, void* _this)
+  {
+    return method && (_this || (method->flags & METHOD_ATTRIBUTE_STATIC));
+  }
+
+  static const MethodInfo* resolve_virtual(void* _this, const MethodInfo* method)
+  {
+    return _this ? il2cpp_object_get_virtual_method((Il2CppObject*)_this, method) : method;
+  }
+
+  Il2CppClass*        cls;
+  const PropertyInfo* propInfo;
+  const MethodInfo*   getter        = nullptr;
+  const MethodInfo*   setter        = nullptr;
+  bool                getterVirtual = false;
+  bool                setterVirtual = false;
+};
+
 class IL2CppFieldHelper
 {
 public:
@@ -169,8 +306,13 @@ public:
       return nullptr;
     }
 
-    auto fn = il2cpp_class_get_method_from_name(this->cls, name, arg_count);
+    if (auto cached = Il2CppSymbolCache::Method(this->cls, name, arg_count)) {
+      return (T*)cached;
+    }
+
+    auto fn = Il2CppIndex::Method(this->cls, name, arg_count);
     if (fn != nullptr) {
+      Il2CppSymbolCache::StoreMethod(this->cls, name, arg_count, fn->methodPointer);
       return (T*)fn->methodPointer;
     }
 
@@ -183,7 +325,7 @@ public:
       return nullptr;
     }
 
-    auto fn = il2cpp_class_get_method_from_name(this->cls, name, arg_count);
+    auto fn = Il2CppIndex::Method(this->cls, name, arg_count);
 
     auto get_method_virtual = il2cpp_object_get_virtual_method((Il2CppObject*)this, fn);
 
@@ -218,7 +360,7 @@ public:
       return nullptr;
     }
 
-    auto fn = il2cpp_class_get_method_from_name(this->cls, name, arg_count);
+    auto fn = Il2CppIndex::Method(this->cls, name, arg_count);
 
     return InvokerMethod<R, Args...>(fn);
   }
@@ -231,13 +373,9 @@ public:
       return nullptr;
     }
 
-    auto  flags = 0;
-    void* iter  = NULL;
-    while (const MethodInfo* method = il2cpp_class_get_methods(this->cls, &iter)) {
-      if (method->name[0] == name[0] && !strcmp(name, method->name) && ((method->flags & flags) == flags)) {
-        if (!arg_filter || arg_filter(method->parameters_count, method->parameters)) {
-          return method;
-        }
+    for (auto method : Il2CppIndex::Methods(this->cls, name)) {
+      if (!arg_filter || arg_filter(method->parameters_count, method->parameters)) {
+        return method;
       }
     }
     return nullptr;
@@ -263,13 +401,8 @@ public:
       return nullptr;
     }
 
-    for (auto i = 0; i < obj->klass->method_count; ++i) {
-      auto method = obj->klass->klass->methods[i];
-      if (method->name[0] == name[0] && !strcmp(name, method->name)) {
-        return (T*)method->methodPointer;
-      }
-    }
-    return nullptr;
+    auto methods = Il2CppIndex::Methods(obj->klass, name);
+    return methods.empty() ? nullptr : (T*)methods.front()->methodPointer;
   }
 
   const MethodInfo* GetMethodInfo(const char* name, int arg_count = -1)
@@ -278,7 +411,7 @@ public:
       return nullptr;
     }
 
-    return il2cpp_class_get_method_from_name(this->cls, name, arg_count);
+    return Il2CppIndex::Method(this->cls, name, arg_count);
   }
 
   inline IL2CppPropertyHelper GetProperty(const char* name)
@@ -286,6 +419,11 @@ public:
     return IL2CppPropertyHelper{this->cls, il2cpp_class_get_property_from_name(this->cls, name)};
   }
 
+  template <typename T> inline IL2CppPropertyAccessor<T> GetPropertyAccessor(const char* name)
+  {
+    return IL2CppPropertyAccessor<T>{this->cls, il2cpp_class_get_property_from_name(this->cls, name)};
+  }
+
   inline IL2CppFieldHelper GetField(const char* name)
   {
     return IL2CppFieldHelper{this->cls, il2cpp_class_get_field_from_name(this->cls, name)};
@@ -313,14 +451,7 @@ public:
 
   inline IL2CppClassHelper GetNestedType(const char* name)
   {
-    for (int i = 0; i < this->cls->nested_type_count; ++i) {
-      auto type = this->cls->nestedTypes[i];
-      if (strcmp(type->name, name) == 0) {
-        return type;
-      }
-    }
-
-    return nullptr;
+    return Il2CppIndex::NestedType(this->cls, name);
   }
 
   Il2CppClass* get_cls()
@@ -336,13 +467,7 @@ private:
 
 inline IL2CppClassHelper il2cpp_get_class_helper_impl(const char* assembly, const char* namespacez, const char* name)
 {
-  auto domain    = il2cpp_domain_get();
-  auto assemblyT = il2cpp_domain_assembly_open(domain, assembly);
-  auto image     = il2cpp_assembly_get_image(assemblyT);
-
-  auto cls = il2cpp_class_from_name(image, namespacez, name);
-
-  return IL2CppClassHelper{cls};
+  return IL2CppClassHelper{Il2CppIndex::Class(assembly, namespacez, name)};
 }
 
 template <typename T> inline T* il2cpp_get_array_element(Il2CppArray* array, size_t index)
@@ -351,25 +476,25 @@ template <typename T> inline T* il2cpp_get_array_element(Il2CppArray* array, siz
   return (T*)n->vector[index];
 }
 
-extern eastl::unordered_map<Il2CppClass*, eastl::vector<uintptr_t>> tracked_objects;
-
 template <typename T> class ObjectFinder
 {
 public:
   static T* Get()
   {
-    auto& objects = tracked_objects[T::get_class_helper().get_cls()];
-    if (objects.empty()) {
-      // TODO: assert?
-      return nullptr;
-    }
-    return reinterpret_cast<T*>(objects.back());
+    return TrackedObjects::View<T>{published()}.newest();
   }
 
-  static eastl::span<T*> GetAll()
+  // Lock-free; the view keeps the objects it lists valid, so don't hold on to it past the frame
+  static TrackedObjects::View<T> GetAll()
+  {
+    return TrackedObjects::View<T>{published()};
+  }
+
+private:
+  static const auto& published()
   {
-    auto& objects = tracked_objects[T::get_class_helper().get_cls()];
-    return {reinterpret_cast<T**>(objects.data()), reinterpret_cast<T**>(objects.data()) + objects.size()};
+    static const auto& snapshot = tracked_objects.Published(T::get_class_helper().get_cls());
+    return snapshot;
   }
 };
 
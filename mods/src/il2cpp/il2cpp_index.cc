@@ -0,0 +1,170 @@
+#include "il2cpp_index.h"
+
+#include "il2cpp-functions.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using MethodOverloads = std::unordered_map<std::string, std::vector<const MethodInfo*>>;
+using NestedTypes     = std::unordered_map<std::string, Il2CppClass*>;
+
+static std::mutex                                          index_mtx;
+static std::unordered_map<std::string, const Il2CppImage*> images;
+static std::unordered_map<std::string, Il2CppClass*>       classes;
+static std::unordered_map<Il2CppClass*, MethodOverloads>   methods;
+static std::unordered_map<Il2CppClass*, NestedTypes>       nested_types;
+
+// Callers pass both "Assembly-CSharp" and "Assembly-CSharp.dll"; image names carry the extension
+static std::string_view assembly_key(std::string_view assembly)
+{
+  if (assembly.ends_with(".dll")) {
+    assembly.remove_suffix(4);
+  }
+
+  return assembly;
+}
+
+// All of the below expect index_mtx to be held
+
+static const Il2CppImage* find_image(std::string_view assembly)
+{
+  std::string key{assembly_key(assembly)};
+  if (auto it = images.find(key); it != images.end()) {
+    return it->second;
+  }
+
+  // Not loaded when Build() ran; misses aren't cached as the assembly may still turn up
+  auto assemblyT = il2cpp_domain_assembly_open(il2cpp_domain_get(), key.c_str());
+  auto image     = assemblyT ? il2cpp_assembly_get_image(assemblyT) : nullptr;
+  if (image) {
+    images.emplace(std::move(key), image);
+  }
+
+  return image;
+}
+
+static const MethodOverloads& class_methods(Il2CppClass* cls)
+{
+  auto [it, inserted] = methods.try_emplace(cls);
+  if (inserted) {
+    void* iter = nullptr;
+    while (auto method = il2cpp_class_get_methods(cls, &iter)) {
+      it->second[method->name].emplace_back(method);
+    }
+  }
+
+  return it->second;
+}
+
+void Il2CppIndex::Build()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::lock_guard lk(index_mtx);
+
+  size_t count      = 0;
+  auto   assemblies = il2cpp_domain_get_assemblies(il2cpp_domain_get(), &count);
+  for (size_t i = 0; i < count; ++i) {
+    auto image = il2cpp_assembly_get_image(assemblies[i]);
+    if (image) {
+      images.emplace(assembly_key(il2cpp_image_get_name(image)), image);
+    }
+  }
+
+  const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  spdlog::debug("Indexed {} assemblies in {:.2f}ms", images.size(), elapsed.count());
+}
+
+const Il2CppImage* Il2CppIndex::Image(std::string_view assembly)
+{
+  std::lock_guard lk(index_mtx);
+  return find_image(assembly);
+}
+
+Il2CppClass* Il2CppIndex::Class(std::string_view assembly, std::string_view namespacez, std::string_view name)
+{
+  std::string key;
+  key.reserve(assembly.size() + namespacez.size() + name.size() + 2);
+  key.append(assembly_key(assembly)).append(1, '|').append(namespacez).append(1, '|').append(name);
+
+  std::lock_guard lk(index_mtx);
+  if (auto it = classes.find(key); it != classes.end()) {
+    return it->second;
+  }
+
+  auto image = find_image(assembly);
+  if (!image) {
+    return nullptr;
+  }
+
+  auto cls = il2cpp_class_from_name(image, std::string{namespacez}.c_str(), std::string{name}.c_str());
+  if (cls) {
+    classes.emplace(std::move(key), cls);
+  }
+
+  return cls;
+}
+
+std::span<const MethodInfo* const> Il2CppIndex::Methods(Il2CppClass* cls, std::string_view name)
+{
+  if (!cls) {
+    return {};
+  }
+
+  std::lock_guard lk(index_mtx);
+  auto&           overloads = class_methods(cls);
+  if (auto it = overloads.find(std::string{name}); it != overloads.end()) {
+    return it->second;
+  }
+
+  return {};
+}
+
+const MethodInfo* Il2CppIndex::Method(Il2CppClass* cls, std::string_view name, int arg_count)
+{
+  const std::string key{name};
+
+  std::lock_guard lk(index_mtx);
+  for (; cls; cls = il2cpp_class_get_parent(cls)) {
+    auto& overloads = class_methods(cls);
+    auto  it        = overloads.find(key);
+    if (it == overloads.end()) {
+      continue;
+    }
+
+    for (auto method : it->second) {
+      if (arg_count == -1 || method->parameters_count == arg_count) {
+        return method;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+Il2CppClass* Il2CppIndex::NestedType(Il2CppClass* cls, std::string_view name)
+{
+  if (!cls) {
+    return nullptr;
+  }
+
+  std::lock_guard lk(index_mtx);
+  auto [it, inserted] = nested_types.try_emplace(cls);
+  if (inserted) {
+    void* iter = nullptr;
+    while (auto nested = il2cpp_class_get_nested_types(cls, &iter)) {
+      it->second.emplace(nested->name, nested);
+    }
+  }
+
+  if (auto found = it->second.find(std::string{name}); found != it->second.end()) {
+    return found->second;
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <il2cpp-class-internals.h>
+
+#include <span>
+#include <string_view>
+
+// Hash indexes over the loaded metadata, so the class helpers don't reopen assemblies or scan
+// method lists on every lookup. Assemblies are indexed by Build(); classes, methods and nested
+// types are indexed the first time they are asked for and kept for the life of the domain.
+class Il2CppIndex
+{
+public:
+  static void Build();
+
+  static const Il2CppImage* Image(std::string_view assembly);
+  static Il2CppClass*       Class(std::string_view assembly, std::string_view namespacez, std::string_view name);
+
+  // Overloads declared on cls itself, in declaration order
+  static std::span<const MethodInfo* const> Methods(Il2CppClass* cls, std::string_view name);
+
+  // Same resolution as il2cpp_class_get_method_from_name: first match by arity (-1 for any),
+  // searching cls and then its parents
+  static const MethodInfo* Method(Il2CppClass* cls, std::string_view name, int arg_count = -1);
+
+  static Il2CppClass* NestedType(Il2CppClass* cls, std::string_view name);
+};
@@ -0,0 +1,301 @@
+#include "il2cpp_symbol_cache.h"
+
+#include "il2cpp-functions.h"
+
+#include <spdlog/spdlog.h>
+#include <spud/signature.h>
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if _WIN32
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+static constexpr std::string_view Magic = "STFCSYM1";
+
+// Bytes hashed from each end of GameAssembly. The headers carry the PE timestamp, Mach-O UUID or ELF
+// build id, so together with the size this tells builds apart without reading the whole image
+static constexpr size_t SampleSize = 64 * 1024;
+
+static std::mutex                                    cache_mtx;
+static std::unordered_map<std::string, uint64_t>     entries;
+static std::unordered_map<Il2CppClass*, std::string> type_names;
+static uint64_t                                      build_hash  = 0;
+static uintptr_t                                     module_base = 0;
+static bool                                          dirty       = false;
+
+template <typename T> static void write_value(std::ofstream& out, T value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T> static bool read_value(std::ifstream& in, T& value)
+{
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t size)
+{
+  auto bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+
+  return hash;
+}
+
+static bool locate_game_assembly(std::filesystem::path& path)
+{
+#if _WIN32
+  auto module = GetModuleHandleW(L"GameAssembly.dll");
+  if (!module) {
+    return false;
+  }
+
+  wchar_t buf[MAX_PATH];
+  if (!GetModuleFileNameW(module, buf, MAX_PATH)) {
+    return false;
+  }
+
+  module_base = reinterpret_cast<uintptr_t>(module);
+  path        = buf;
+#else
+  Dl_info info;
+  if (!il2cpp_domain_get || !dladdr(reinterpret_cast<void*>(il2cpp_domain_get), &info) || !info.dli_fname) {
+    return false;
+  }
+
+  module_base = reinterpret_cast<uintptr_t>(info.dli_fbase);
+  path        = info.dli_fname;
+#endif
+
+  return true;
+}
+
+static uint64_t hash_build(const std::filesystem::path& path, std::string_view mod_version)
+{
+  std::ifstream in(path, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in) {
+    return 0;
+  }
+
+  const uint64_t size = in.tellg();
+  uint64_t       hash = 14695981039346656037ull;
+  hash                = fnv1a(hash, &size, sizeof(size));
+  hash                = fnv1a(hash, mod_version.data(), mod_version.size());
+
+  std::vector<char> sample(SampleSize);
+  for (const uint64_t offset : {uint64_t{0}, size > SampleSize ? size - SampleSize : 0}) {
+    in.clear();
+    in.seekg(offset);
+    in.read(sample.data(), sample.size());
+    hash = fnv1a(hash, sample.data(), in.gcount());
+  }
+
+  return hash;
+}
+
+// Generic instances share a name with their definition, so the key uses the full type name
+static const std::string& type_name(Il2CppClass* cls)
+{
+  auto [it, inserted] = type_names.try_emplace(cls);
+  if (inserted) {
+    auto name = il2cpp_type_get_name(&cls->byval_arg);
+    it->second.append(il2cpp_image_get_name(il2cpp_class_get_image(cls))).append(1, '|').append(name);
+    il2cpp_free(name);
+  }
+
+  return it->second;
+}
+
+static std::string method_key(Il2CppClass* cls, std::string_view name, int arg_count)
+{
+  std::string key{"M"};
+  key.append(type_name(cls)).append("::").append(name).append(1, '/').append(std::to_string(arg_count));
+  return key;
+}
+
+void Il2CppSymbolCache::Load(const std::filesystem::path& path, std::string_view mod_version)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::lock_guard lk(cache_mtx);
+
+  std::filesystem::path game_assembly;
+  if (!locate_game_assembly(game_assembly) || !(build_hash = hash_build(game_assembly, mod_version))) {
+    spdlog::warn("Unable to identify GameAssembly, not caching symbols");
+    return;
+  }
+
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in) {
+    spdlog::debug("No symbol cache yet, resolving everything");
+    return;
+  }
+
+  std::string magic(Magic.size(), '\0');
+  uint64_t    file_hash = 0;
+  uint32_t    count     = 0;
+  if (!in.read(magic.data(), magic.size()) || magic != Magic || !read_value(in, file_hash)
+      || file_hash != build_hash || !read_value(in, count)) {
+    spdlog::debug("Symbol cache is from another game or mod version, resolving everything");
+    return;
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t    key_length;
+    std::string key;
+    uint64_t    rva;
+
+    if (!read_value(in, key_length)) {
+      break;
+    }
+
+    key.resize(key_length);
+    if (!in.read(key.data(), key_length) || !read_value(in, rva)) {
+      break;
+    }
+
+    entries.emplace(std::move(key), rva);
+  }
+
+  if (entries.size() != count) {
+    spdlog::warn("Symbol cache is truncated, resolving everything");
+    entries.clear();
+    return;
+  }
+
+  const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  spdlog::debug("Loaded {} cached symbols in {:.2f}ms", entries.size(), elapsed.count());
+}
+
+void Il2CppSymbolCache::Save(const std::filesystem::path& path)
+{
+  std::lock_guard lk(cache_mtx);
+  if (!dirty || !build_hash) {
+    return;
+  }
+
+  auto temp_path = path;
+  temp_path += ".tmp";
+
+  {
+    std::ofstream out(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out) {
+      spdlog::warn("Failed to write symbol cache to {}", path.string());
+      return;
+    }
+
+    out.write(Magic.data(), Magic.size());
+    write_value(out, build_hash);
+    write_value(out, static_cast<uint32_t>(entries.size()));
+    for (const auto& [key, rva] : entries) {
+      write_value(out, static_cast<uint32_t>(key.size()));
+      out.write(key.data(), key.size());
+      write_value(out, rva);
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    spdlog::warn("Failed to write symbol cache to {}: {}", path.string(), ec.message());
+    return;
+  }
+
+  dirty = false;
+}
+
+Il2CppMethodPointer Il2CppSymbolCache::Method(Il2CppClass* cls, std::string_view name, int arg_count)
+{
+  if (!cls) {
+    return nullptr;
+  }
+
+  std::lock_guard lk(cache_mtx);
+  if (!build_hash) {
+    return nullptr;
+  }
+
+  if (auto it = entries.find(method_key(cls, name, arg_count)); it != entries.end()) {
+    return reinterpret_cast<Il2CppMethodPointer>(module_base + it->second);
+  }
+
+  return nullptr;
+}
+
+void Il2CppSymbolCache::StoreMethod(Il2CppClass* cls, std::string_view name, int arg_count,
+                                    Il2CppMethodPointer method)
+{
+  const auto address = reinterpret_cast<uintptr_t>(method);
+
+  std::lock_guard lk(cache_mtx);
+  if (!cls || !build_hash || address < module_base) {
+    return;
+  }
+
+  entries[method_key(cls, name, arg_count)] = address - module_base;
+  dirty                                     = true;
+}
+
+static std::string signature_key(std::string_view signature, std::string_view module)
+{
+  std::string key{"S"};
+  key.append(module).append(1, '|').append(signature);
+  return key;
+}
+
+std::vector<uintptr_t> Il2CppSymbolCache::FindManyInModule(std::span<const std::string_view> signatures,
+                                                           std::string_view                  module)
+{
+  std::vector<uintptr_t>        addresses(signatures.size(), 0);
+  std::vector<std::string_view> missing;
+  std::vector<size_t>           missing_index;
+
+  {
+    std::lock_guard lk(cache_mtx);
+    for (size_t i = 0; i < signatures.size(); ++i) {
+      if (auto it = entries.find(signature_key(signatures[i], module)); build_hash && it != entries.end()) {
+        addresses[i] = module_base + it->second;
+      } else {
+        missing.push_back(signatures[i]);
+        missing_index.push_back(i);
+      }
+    }
+  }
+
+  if (missing.empty()) {
+    return addresses;
+  }
+
+  auto matches = spud::find_many_in_module(missing, module);
+
+  std::lock_guard lk(cache_mtx);
+  for (size_t i = 0; i < missing.size(); ++i) {
+    if (matches[i].size() == 0) {
+      continue;
+    }
+
+    const auto address          = matches[i].get(0).address();
+    addresses[missing_index[i]] = address;
+
+    if (build_hash && address >= module_base) {
+      entries[signature_key(missing[i], module)] = address - module_base;
+      dirty                                      = true;
+    }
+  }
+
+  return addresses;
+}
+
+uintptr_t Il2CppSymbolCache::FindInModule(std::string_view signature, std::string_view module)
+{
+  return FindManyInModule({&signature, 1}, module)[0];
+}
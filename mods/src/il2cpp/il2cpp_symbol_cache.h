@@ -0,0 +1,30 @@
+#pragma once
+
+#include <il2cpp-class-internals.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Remembers where method and signature lookups landed inside GameAssembly, as offsets from its base,
+// so the next launch of the same game build can skip class method setup and module scans. The file
+// is keyed by a hash of the GameAssembly binary and the mod version; if either differs it is ignored
+// and rebuilt from the lookups of that run.
+class Il2CppSymbolCache
+{
+public:
+  static void Load(const std::filesystem::path& path, std::string_view mod_version);
+  // Only writes when something was resolved that the loaded cache didn't have
+  static void Save(const std::filesystem::path& path);
+
+  static Il2CppMethodPointer Method(Il2CppClass* cls, std::string_view name, int arg_count);
+  static void StoreMethod(Il2CppClass* cls, std::string_view name, int arg_count, Il2CppMethodPointer method);
+
+  // First match of each signature, or 0 where it isn't found. The signatures missing from the cache
+  // are found with a single spud::find_many_in_module pass over the module.
+  static std::vector<uintptr_t> FindManyInModule(std::span<const std::string_view> signatures,
+                                                 std::string_view                  module);
+  static uintptr_t              FindInModule(std::string_view signature, std::string_view module);
+};
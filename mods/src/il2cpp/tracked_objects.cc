@@ -0,0 +1,153 @@
+#include "tracked_objects.h"
+
+#include <algorithm>
+
+TrackedObjects tracked_objects;
+
+TrackedObjects::~TrackedObjects()
+{
+  for (auto& [cls, list] : this->classes) {
+    delete list.published.load();
+  }
+
+  for (const auto& retired : this->retired) {
+    delete retired.snapshot;
+  }
+}
+
+bool TrackedObjects::Add(Il2CppClass* cls, uintptr_t object)
+{
+  std::lock_guard lk(this->mtx);
+
+  auto [it, inserted] = this->slots.try_emplace(object);
+  if (!inserted) {
+    return false;
+  }
+
+  const auto sequence = this->next_sequence++;
+  for (; cls; cls = cls->parent) {
+    auto& list = this->classes[cls];
+    it->second.push_back(Slot{&list, uint32_t(list.objects.size())});
+    list.objects.push_back(object);
+    list.sequence.push_back(sequence);
+    this->mark_dirty(list);
+  }
+
+  this->publish_dirty();
+  return true;
+}
+
+bool TrackedObjects::Remove(uintptr_t object)
+{
+  std::lock_guard lk(this->mtx);
+
+  if (this->slots.find(object) == this->slots.end()) {
+    return false;
+  }
+
+  this->remove_locked(object);
+  this->publish_dirty();
+  return true;
+}
+
+void TrackedObjects::remove_locked(uintptr_t object)
+{
+  auto it = this->slots.find(object);
+
+  for (const auto& slot : it->second) {
+    auto&      list = *slot.list;
+    const auto last = list.objects.back();
+
+    list.objects[slot.index]  = last;
+    list.sequence[slot.index] = list.sequence.back();
+    list.objects.pop_back();
+    list.sequence.pop_back();
+    this->mark_dirty(list);
+
+    if (last == object) {
+      continue;
+    }
+
+    // The moved object is listed in this class too, point its slot at the hole
+    for (auto& moved : this->slots.find(last)->second) {
+      if (moved.list == slot.list) {
+        moved.index = slot.index;
+        break;
+      }
+    }
+  }
+
+  this->slots.erase(it);
+}
+
+const std::atomic<const TrackedObjects::Snapshot*>& TrackedObjects::Published(Il2CppClass* cls)
+{
+  std::lock_guard lk(this->mtx);
+
+  auto& list = this->classes[cls];
+  if (!list.published.load(std::memory_order_relaxed)) {
+    this->publish(list);
+  }
+
+  return list.published;
+}
+
+size_t TrackedObjects::size()
+{
+  std::lock_guard lk(this->mtx);
+  return this->slots.size();
+}
+
+// Only classes somebody reads from are published; parents such as MonoBehaviour list every
+// tracked object and would otherwise be copied on each write
+void TrackedObjects::mark_dirty(ClassObjects& list)
+{
+  if (!list.dirty && list.published.load(std::memory_order_relaxed)) {
+    list.dirty = true;
+    this->dirty.push_back(&list);
+  }
+}
+
+void TrackedObjects::publish(ClassObjects& list)
+{
+  auto snapshot     = new Snapshot{};
+  snapshot->objects = list.objects;
+  if (!list.sequence.empty()) {
+    const auto newest = std::max_element(list.sequence.begin(), list.sequence.end()) - list.sequence.begin();
+    snapshot->newest  = list.objects[newest];
+  }
+
+  if (auto previous = list.published.exchange(snapshot)) {
+    this->retired.push_back(Retired{previous, Epoch::Retire()});
+  }
+}
+
+void TrackedObjects::publish_dirty()
+{
+  if (this->dirty.empty()) {
+    return;
+  }
+
+  for (auto list : this->dirty) {
+    list->dirty = false;
+    this->publish(*list);
+  }
+
+  this->dirty.clear();
+  this->reclaim();
+}
+
+void TrackedObjects::reclaim()
+{
+  const auto oldest = Epoch::Oldest();
+
+  auto kept = std::remove_if(this->retired.begin(), this->retired.end(), [&](const Retired& retired) {
+    if (retired.epoch >= oldest) {
+      return false;
+    }
+
+    delete retired.snapshot;
+    return true;
+  });
+  this->retired.erase(kept, this->retired.end());
+}
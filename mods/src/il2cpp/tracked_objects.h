@@ -0,0 +1,160 @@
+#pragma once
+
+#include "epoch.h"
+
+#include <il2cpp-class-internals.h>
+
+#include <EASTL/fixed_vector.h>
+#include <EASTL/span.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Live instances of the tracked classes, listed under their class and every parent class.
+//
+// Each class keeps a dense array of its objects, and each object knows its slot in every array
+// it is listed in, so adding and removing an object costs one step per class in its hierarchy
+// (swap-remove), regardless of how many objects are tracked. Writers serialize on a mutex.
+//
+// Readers never take that mutex. Classes that have been read from get an immutable snapshot of
+// their objects, republished through an atomic pointer whenever a write touches the class; a
+// replaced snapshot is freed once no reader that could still see it is left (epoch-based
+// reclamation, see epoch.h). Reads are a handful of atomic loads and stores and never wait on a writer.
+class TrackedObjects
+{
+  struct Snapshot {
+    eastl::vector<uintptr_t> objects;
+    uintptr_t                newest = 0;
+  };
+
+public:
+  // Snapshots loaded while a guard is alive stay valid
+  using ReadGuard = Epoch::ReadGuard;
+
+  // The objects of one class at the time of the read, valid while the view is alive
+  template <typename T> class View
+  {
+  public:
+    // Sequentially consistent, so the load cannot be ordered ahead of the guard publishing its epoch
+    explicit View(const std::atomic<const Snapshot*>& published)
+        : snapshot(published.load())
+    {
+    }
+
+    T* const* begin() const
+    {
+      return (T* const*)this->snapshot->objects.data();
+    }
+
+    T* const* end() const
+    {
+      return this->begin() + this->size();
+    }
+
+    size_t size() const
+    {
+      return this->snapshot->objects.size();
+    }
+
+    bool empty() const
+    {
+      return this->snapshot->objects.empty();
+    }
+
+    T* operator[](size_t index) const
+    {
+      return this->begin()[index];
+    }
+
+    // The most recently added object, or nullptr
+    T* newest() const
+    {
+      return (T*)this->snapshot->newest;
+    }
+
+  private:
+    ReadGuard       guard;
+    const Snapshot* snapshot;
+  };
+
+  TrackedObjects() = default;
+  ~TrackedObjects();
+
+  TrackedObjects(const TrackedObjects&)            = delete;
+  TrackedObjects& operator=(const TrackedObjects&) = delete;
+
+  // Returns false if the object was already tracked, e.g. when a base class constructor is hooked too
+  bool Add(Il2CppClass* cls, uintptr_t object);
+  bool Remove(uintptr_t object);
+
+  // Removes every object pred returns true for, visiting each object once. pred runs with the
+  // writer lock held.
+  template <typename Pred> size_t RemoveIf(Pred&& pred)
+  {
+    std::lock_guard lk(this->mtx);
+
+    eastl::vector<uintptr_t> removed;
+    for (const auto& [object, _] : this->slots) {
+      if (pred(object)) {
+        removed.push_back(object);
+      }
+    }
+
+    for (auto object : removed) {
+      this->remove_locked(object);
+    }
+
+    this->publish_dirty();
+    return removed.size();
+  }
+
+  // The published snapshot of cls, created on first use. The reference stays valid for the life
+  // of the tracker, so callers can keep it.
+  const std::atomic<const Snapshot*>& Published(Il2CppClass* cls);
+
+  template <typename T> View<T> Objects(Il2CppClass* cls)
+  {
+    return View<T>{this->Published(cls)};
+  }
+
+  size_t size();
+
+private:
+  struct ClassObjects {
+    eastl::vector<uintptr_t>     objects;
+    eastl::vector<uint64_t>      sequence;
+    std::atomic<const Snapshot*> published{nullptr};
+    bool                         dirty = false;
+  };
+
+  struct Slot {
+    ClassObjects* list;
+    uint32_t      index;
+  };
+
+  // Most hierarchies are a handful of classes deep, so slots live inline
+  using Slots = eastl::fixed_vector<Slot, 8, true>;
+
+  struct Retired {
+    const Snapshot* snapshot;
+    uint64_t        epoch;
+  };
+
+  void remove_locked(uintptr_t object);
+  void mark_dirty(ClassObjects& list);
+  void publish(ClassObjects& list);
+  void publish_dirty();
+  void reclaim();
+
+  std::mutex                                       mtx;
+  eastl::unordered_map<Il2CppClass*, ClassObjects> classes;
+  eastl::unordered_map<uintptr_t, Slots>           slots;
+  eastl::vector<ClassObjects*>                     dirty;
+  eastl::vector<Retired>                           retired;
+  uint64_t                                         next_sequence = 0;
+};
+
+extern TrackedObjects tracked_objects;
@@ -0,0 +1,217 @@
+#include "logging.h"
+#include "config.h"
+#include "defaultconfig.h"
+#include "file.h"
+
+#include <spdlog/async.h>
+#include <spdlog/details/file_helper.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DCC = DefaultConfig::Control;
+
+// Messages the queue holds before the overflow policy kicks in, allocated up front
+static constexpr size_t QueueSize = 8192;
+
+static constexpr size_t Megabyte = 1024 * 1024;
+
+// <stem>.<index><extension>.gz next to the log, community_patch.1.log.gz is the most recent
+static std::filesystem::path archive_path(const std::filesystem::path& log, size_t index)
+{
+  auto archive = log;
+  archive.replace_filename(log.stem().string() + "." + std::to_string(index) + log.extension().string() + ".gz");
+  return archive;
+}
+
+static bool compress_file(const std::filesystem::path& source, const std::filesystem::path& target)
+{
+  std::ifstream in(source, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+
+#if _WIN32
+  const auto out = gzopen_w(target.c_str(), "wb");
+#else
+  const auto out = gzopen(target.c_str(), "wb");
+#endif
+  if (out == nullptr) {
+    return false;
+  }
+
+  std::vector<char> buffer(256 * 1024);
+  auto              written = true;
+  while (written && in) {
+    in.read(buffer.data(), (std::streamsize)buffer.size());
+    if (const auto count = (int)in.gcount(); count > 0) {
+      written = gzwrite(out, buffer.data(), (unsigned)count) == count;
+    }
+  }
+
+  return gzclose(out) == Z_OK && written;
+}
+
+// Writes the log file and rotates it once it passes max_size: the full file is compressed into
+// archive 1 and the older archives move up by one, dropping any past max_files. This runs on the
+// logger thread, callers only notice if the queue fills up while an archive is being compressed.
+class archiving_file_sink final : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+  archiving_file_sink(spdlog::filename_t filename, size_t max_size, size_t max_files)
+      : filename(std::move(filename))
+      , maxSize(max_size)
+      , maxFiles(max_files)
+  {
+    this->file.open(this->filename, true);
+  }
+
+  void set_limits(size_t max_size, size_t max_files)
+  {
+    std::lock_guard lk(this->mutex_);
+    this->maxSize  = max_size;
+    this->maxFiles = max_files;
+  }
+
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    spdlog::memory_buf_t formatted;
+    this->formatter_->format(msg, formatted);
+
+    if (this->size > 0 && this->size + formatted.size() > this->maxSize) {
+      this->rotate();
+    }
+
+    this->file.write(formatted);
+    this->size += formatted.size();
+  }
+
+  void flush_() override
+  {
+    this->file.flush();
+  }
+
+private:
+  void rotate()
+  {
+    const std::filesystem::path log = this->filename;
+    auto                        full = log;
+    full += ".rotating";
+
+    this->file.close();
+
+    std::error_code ec;
+    std::filesystem::rename(log, full, ec);
+    this->file.open(this->filename, true);
+    this->size = 0;
+
+    if (ec) {
+      throw spdlog::spdlog_ex("Failed to rotate " + log.string() + ": " + ec.message());
+    }
+
+    if (this->maxFiles > 0) {
+      std::filesystem::remove(archive_path(log, this->maxFiles), ec);
+      for (auto i = this->maxFiles - 1; i > 0; --i) {
+        std::filesystem::rename(archive_path(log, i), archive_path(log, i + 1), ec);
+      }
+
+      if (!compress_file(full, archive_path(log, 1))) {
+        std::filesystem::remove(archive_path(log, 1), ec);
+        std::filesystem::remove(full, ec);
+        throw spdlog::spdlog_ex("Failed to compress " + archive_path(log, 1).string());
+      }
+    }
+
+    std::filesystem::remove(full, ec);
+  }
+
+  spdlog::filename_t          filename;
+  spdlog::details::file_helper file;
+  size_t                       size = 0;
+  size_t                       maxSize;
+  size_t                       maxFiles;
+};
+
+static std::shared_ptr<archiving_file_sink>                  file_sink;
+static std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> console_sink;
+
+// Loggers that were replaced. Other threads may still be inside one through spdlog's raw default
+// logger pointer, so they are never freed.
+static std::vector<std::shared_ptr<spdlog::logger>> retired_loggers;
+
+// log_overflow of the logger in place
+static std::string installed_overflow = DCC::log_overflow;
+
+static spdlog::async_overflow_policy overflow_policy(std::string_view name)
+{
+  if (name == "block") {
+    return spdlog::async_overflow_policy::block;
+  }
+
+#if SPDLOG_VERSION >= 11300
+  if (name == "drop_newest") {
+    return spdlog::async_overflow_policy::discard_new;
+  }
+#endif
+
+  if (name != "drop_oldest") {
+    spdlog::warn("Unsupported log_overflow \"{}\", dropping the oldest queued messages instead", name);
+  }
+
+  return spdlog::async_overflow_policy::overrun_oldest;
+}
+
+static void install_logger(spdlog::async_overflow_policy policy)
+{
+  auto logger = std::make_shared<spdlog::async_logger>("default", spdlog::sinks_init_list{file_sink, console_sink},
+                                                       spdlog::thread_pool(), policy);
+  logger->set_level(spdlog::get_level());
+
+  // Everything else goes out with the periodic flush
+  logger->flush_on(spdlog::level::warn);
+
+  if (auto previous = spdlog::default_logger(); previous) {
+    retired_loggers.emplace_back(std::move(previous));
+  }
+
+  spdlog::set_default_logger(std::move(logger));
+}
+
+void Logging::Init(spdlog::level::level_enum level)
+{
+  spdlog::init_thread_pool(QueueSize, 1);
+
+  file_sink    = std::make_shared<archiving_file_sink>(File::Log(), DCC::log_max_size * Megabyte, DCC::log_max_files);
+  console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+  install_logger(overflow_policy(DCC::log_overflow));
+  spdlog::set_level(level);
+  spdlog::flush_every(std::chrono::seconds(1));
+}
+
+void Logging::Configure(const Config& config)
+{
+  file_sink->set_limits((size_t)std::max(config.log_max_size, 1) * Megabyte, (size_t)std::max(config.log_max_files, 0));
+
+  if (config.log_overflow != installed_overflow) {
+    install_logger(overflow_policy(config.log_overflow));
+    installed_overflow = config.log_overflow;
+  }
+}
+
+void Logging::Shutdown()
+{
+  spdlog::shutdown();
+}
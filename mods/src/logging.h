@@ -0,0 +1,20 @@
+#pragma once
+
+#include <spdlog/common.h>
+
+class Config;
+
+// The default logger. Log calls format the message and queue it, a background thread writes it to
+// File::Log() and the console, so nothing on the calling thread waits for the disk. The log is
+// rotated by size into gzipped archives next to it.
+class Logging
+{
+public:
+  // Call before anything logs, the settings from the config are applied by Configure once it is loaded
+  static void Init(spdlog::level::level_enum level);
+  // Again after a reload that changed them, not from two threads at once
+  static void Configure(const Config& config);
+
+  // Writes out everything still queued, before the process goes away without unwinding
+  static void Shutdown();
+};
@@ -0,0 +1,188 @@
+#include "chat_filter.h"
+
+#include <simdutf.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+static constexpr uint32_t NoState = std::numeric_limits<uint32_t>::max();
+
+// Upper to lower case for ASCII, Latin-1 and Cyrillic, the scripts chat names and spam are written in
+static constexpr char16_t fold(char16_t c)
+{
+  if ((c >= u'A' && c <= u'Z') || (c >= 0xC0 && c <= 0xDE && c != 0xD7) || (c >= 0x410 && c <= 0x42F)) {
+    return c + 0x20;
+  }
+
+  if (c >= 0x400 && c <= 0x40F) {
+    return c + 0x50;
+  }
+
+  return c;
+}
+
+static std::u16string to_folded_utf16(const std::string& str)
+{
+  std::u16string out(simdutf::utf16_length_from_utf8(str.data(), str.length()), u'\0');
+  out.resize(simdutf::convert_utf8_to_utf16(str.data(), str.length(), out.data()));
+  std::ranges::transform(out, out.begin(), fold);
+  return out;
+}
+
+size_t ChatFilter::FoldedHash::operator()(std::u16string_view s) const
+{
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  for (const auto c : s) {
+    hash = (hash ^ fold(c)) * 1099511628211ull;
+  }
+
+  return static_cast<size_t>(hash);
+}
+
+bool ChatFilter::FoldedEqual::operator()(std::u16string_view a, std::u16string_view b) const
+{
+  return a.size() == b.size() && std::ranges::equal(a, b, [](char16_t x, char16_t y) { return fold(x) == fold(y); });
+}
+
+ChatFilter::ChatFilter(const Rules& block, const Rules& mute)
+{
+  std::vector<std::pair<std::u16string, Action>> keywords;
+
+  for (const auto& [rules, action] : {std::pair{&mute, Action::Mute}, std::pair{&block, Action::Block}}) {
+    const auto add = [action](Names& names, const std::vector<std::string>& entries) {
+      for (const auto& entry : entries) {
+        if (auto name = to_folded_utf16(entry); name.empty()) {
+          spdlog::warn("Ignoring chat filter entry '{}', it is not valid UTF-8", entry);
+        } else {
+          auto& current = names[std::move(name)];
+          current       = std::max(current, action);
+        }
+      }
+    };
+
+    add(this->senders, rules->senders);
+    add(this->alliances, rules->alliances);
+
+    for (const auto& entry : rules->keywords) {
+      if (auto keyword = to_folded_utf16(entry); keyword.empty()) {
+        spdlog::warn("Ignoring chat filter keyword '{}', it is not valid UTF-8", entry);
+      } else {
+        keywords.emplace_back(std::move(keyword), action);
+      }
+    }
+  }
+
+  if (keywords.empty()) {
+    return;
+  }
+
+  // Only the units that occur in a keyword get a symbol of their own, the rest share symbol 0
+  // and the rows stay as narrow as the keywords allow
+  std::vector<uint16_t> folded_symbols(0x10000, 0);
+  for (const auto& [keyword, _] : keywords) {
+    for (const auto c : keyword) {
+      if (folded_symbols[c] == 0) {
+        folded_symbols[c] = static_cast<uint16_t>(this->symbol_count++);
+      }
+    }
+  }
+
+  this->symbols.resize(0x10000);
+  for (uint32_t c = 0; c < 0x10000; ++c) {
+    this->symbols[c] = folded_symbols[fold(static_cast<char16_t>(c))];
+  }
+
+  // The trie, the root is state 0
+  const auto n = this->symbol_count;
+  this->transitions.assign(n, NoState);
+  this->outputs.assign(1, Action::None);
+
+  for (const auto& [keyword, action] : keywords) {
+    uint32_t state = 0;
+    for (const auto c : keyword) {
+      auto& next = this->transitions[state * n + folded_symbols[c]];
+      if (next == NoState) {
+        next = static_cast<uint32_t>(this->outputs.size());
+        this->transitions.resize(this->transitions.size() + n, NoState);
+        this->outputs.push_back(Action::None);
+      }
+      state = this->transitions[state * n + folded_symbols[c]];
+    }
+
+    this->outputs[state] = std::max(this->outputs[state], action);
+  }
+
+  // Breadth first, each state takes the transitions it is missing from its failure state and the
+  // output of the longest keyword that ends there
+  std::vector<uint32_t> failure(this->outputs.size(), 0);
+  std::vector<uint32_t> queue;
+  queue.reserve(this->outputs.size());
+
+  for (uint32_t symbol = 0; symbol < n; ++symbol) {
+    if (auto& next = this->transitions[symbol]; next == NoState) {
+      next = 0;
+    } else {
+      queue.push_back(next);
+    }
+  }
+
+  for (size_t i = 0; i < queue.size(); ++i) {
+    const auto state = queue[i];
+    const auto fail  = failure[state];
+
+    this->outputs[state] = std::max(this->outputs[state], this->outputs[fail]);
+
+    for (uint32_t symbol = 0; symbol < n; ++symbol) {
+      if (auto& next = this->transitions[state * n + symbol]; next == NoState) {
+        next = this->transitions[fail * n + symbol];
+      } else {
+        failure[next] = this->transitions[fail * n + symbol];
+        queue.push_back(next);
+      }
+    }
+  }
+}
+
+bool ChatFilter::Empty() const
+{
+  return this->senders.empty() && this->alliances.empty() && this->transitions.empty();
+}
+
+ChatFilter::Action ChatFilter::Check(std::u16string_view sender, std::u16string_view alliance,
+                                     std::u16string_view text) const
+{
+  auto result = Action::None;
+
+  if (const auto it = this->senders.find(sender); it != this->senders.end()) {
+    result = it->second;
+  }
+
+  if (const auto it = this->alliances.find(alliance); it != this->alliances.end()) {
+    result = std::max(result, it->second);
+  }
+
+  if (result == Action::Block || this->transitions.empty()) {
+    return result;
+  }
+
+  const auto* transitions = this->transitions.data();
+  const auto* symbols     = this->symbols.data();
+  const auto* outputs     = this->outputs.data();
+  const auto  n           = this->symbol_count;
+
+  uint32_t state = 0;
+  for (const auto c : text) {
+    state = transitions[state * n + symbols[c]];
+    if (outputs[state] > result) {
+      result = outputs[state];
+      if (result == Action::Block) {
+        break;
+      }
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Block and mute lists for galaxy and veil chat ([ui] chat_block_* and chat_mute_*), compiled when
+// the config is loaded. Blocked messages are dropped before the game creates a view for them,
+// muted ones are kept out of the chat preview but stay in the full screen chat.
+//
+// Senders and alliance tags match whole, keywords anywhere in the text. All of them ignore case
+// for Latin and Cyrillic letters. The keywords are compiled into one Aho-Corasick automaton over
+// UTF-16, so a message is scanned once, straight from the Il2CppString, whatever the number of
+// keywords.
+class ChatFilter
+{
+public:
+  enum class Action : uint8_t { None, Mute, Block };
+
+  struct Rules {
+    std::vector<std::string> senders;
+    std::vector<std::string> alliances;
+    std::vector<std::string> keywords;
+  };
+
+  ChatFilter() = default;
+  ChatFilter(const Rules& block, const Rules& mute);
+
+  bool Empty() const;
+
+  // The strongest action of any rule the message matches
+  Action Check(std::u16string_view sender, std::u16string_view alliance, std::u16string_view text) const;
+
+private:
+  struct FoldedHash {
+    using is_transparent = void;
+    size_t operator()(std::u16string_view s) const;
+  };
+
+  struct FoldedEqual {
+    using is_transparent = void;
+    bool operator()(std::u16string_view a, std::u16string_view b) const;
+  };
+
+  using Names = std::unordered_map<std::u16string, Action, FoldedHash, FoldedEqual>;
+
+  Names senders;
+  Names alliances;
+
+  // Every UTF-16 unit maps to a symbol, 0 for those in no keyword. Case is folded here, so the
+  // scan never folds.
+  std::vector<uint16_t> symbols;
+  uint32_t              symbol_count = 1;
+
+  // transitions[state * symbol_count + symbol], failure links already followed
+  std::vector<uint32_t> transitions;
+  std::vector<Action>   outputs;
+};
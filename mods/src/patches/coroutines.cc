@@ -0,0 +1,133 @@
+#include "coroutines.h"
+#include "config.h"
+#include "trace_recorder.h"
+
+#include <il2cpp/il2cpp-functions.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+struct Coroutine {
+  Coroutines::Id                        id;
+  Il2CppGCHandle                        handle;
+  Coroutines::Step                      step;
+  Coroutines::Done                      done;
+  const char*                           name;
+  int                                   steps_per_frame;
+  std::chrono::steady_clock::time_point deadline;
+  bool                                  cancelled = false;
+};
+
+static Coroutines::Id next_id = 1;
+
+// Coroutines started while Update runs wait in starting, so callbacks can start new ones safely
+static std::vector<Coroutine> running;
+static std::vector<Coroutine> starting;
+
+Coroutines::Id Coroutines::Start(Il2CppObject* object, Step step, Done done, Options options)
+{
+  const auto  config  = Config::Get();
+  const auto  steps   = options.steps_per_frame > 0 ? options.steps_per_frame : config->coroutine_steps;
+  const auto  timeout = options.timeout.count() > 0 ? options.timeout
+                                                    : std::chrono::milliseconds(config->coroutine_timeout * 1000);
+
+  auto& coroutine = starting.emplace_back(Coroutine{next_id++, il2cpp_gchandle_new(object, false), std::move(step),
+                                                    std::move(done), options.name, std::max(steps, 1),
+                                                    std::chrono::steady_clock::now() + timeout});
+
+  return coroutine.id;
+}
+
+bool Coroutines::Cancel(Id id)
+{
+  for (auto list : {&running, &starting}) {
+    const auto found = std::ranges::find(*list, id, &Coroutine::id);
+    if (found != list->end() && !found->cancelled) {
+      found->cancelled = true;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Runs up to steps_per_frame MoveNext calls, returns the result once the coroutine is finished
+static std::optional<Coroutines::Result> advance(Coroutine& coroutine, std::chrono::steady_clock::time_point now)
+{
+  if (coroutine.cancelled) {
+    return Coroutines::Result::Cancelled;
+  }
+
+  if (now >= coroutine.deadline) {
+    return Coroutines::Result::TimedOut;
+  }
+
+  TraceRecorder::Scope trace("coroutine", "frame", coroutine.name);
+  try {
+    for (auto i = 0; i < coroutine.steps_per_frame; ++i) {
+      if (!coroutine.step()) {
+        return Coroutines::Result::Completed;
+      }
+    }
+  } catch (const std::exception& e) {
+    spdlog::error("Coroutine {} failed: {}", coroutine.name, e.what());
+    return Coroutines::Result::Failed;
+  } catch (...) {
+    spdlog::error("Coroutine {} failed: unknown exception", coroutine.name);
+    return Coroutines::Result::Failed;
+  }
+
+  return std::nullopt;
+}
+
+void Coroutines::Update()
+{
+  std::ranges::move(starting, std::back_inserter(running));
+  starting.clear();
+
+  if (running.empty()) {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+
+  std::vector<std::pair<Coroutine, Result>> finished;
+  for (auto it = running.begin(); it != running.end();) {
+    if (const auto result = advance(*it, now)) {
+      finished.emplace_back(std::move(*it), *result);
+      it = running.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // Callbacks run last, they may start or cancel coroutines
+  for (auto& [coroutine, result] : finished) {
+    il2cpp_gchandle_free(coroutine.handle);
+
+    if (result == Result::TimedOut) {
+      spdlog::warn("Coroutine {} timed out", coroutine.name);
+    }
+
+    if (coroutine.done) {
+      try {
+        coroutine.done(result);
+      } catch (const std::exception& e) {
+        spdlog::error("Coroutine {} callback failed: {}", coroutine.name, e.what());
+      } catch (...) {
+        spdlog::error("Coroutine {} callback failed: unknown exception", coroutine.name);
+      }
+    }
+  }
+}
+
+size_t Coroutines::Running()
+{
+  return running.size() + starting.size();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+struct Il2CppObject;
+
+// Drives il2cpp IEnumerators the mod starts from hooks. Instead of spinning MoveNext until the
+// enumerator is done, each one is advanced a few steps per frame from the ScreenManager update and
+// its callback runs once it finishes, is cancelled or runs out of time. The enumerator is kept
+// alive with a GC handle while it is driven.
+class Coroutines
+{
+public:
+  enum class Result { Completed, Cancelled, TimedOut, Failed };
+
+  using Id   = uint64_t;
+  using Step = std::function<bool()>;
+  using Done = std::function<void(Result)>;
+
+  struct Options {
+    const char*               name            = "coroutine";
+    int                       steps_per_frame = 0;    // 0 uses coroutine_steps from the config
+    std::chrono::milliseconds timeout         = {};   // 0 uses coroutine_timeout from the config
+  };
+
+  // Main thread only. Returns 0 without calling done when there is no enumerator, the getters of
+  // the prime wrappers return nullptr when the game method is missing.
+  template <typename T> static Id Start(T* enumerator, Done done = nullptr, Options options = {})
+  {
+    if (enumerator == nullptr) {
+      return 0;
+    }
+
+    return Coroutines::Start((Il2CppObject*)enumerator, [enumerator] { return enumerator->MoveNext(); },
+                             std::move(done), options);
+  }
+
+  static Id Start(Il2CppObject* object, Step step, Done done, Options options);
+
+  // Main thread only. The callback gets Cancelled on the next Update, false when the id is not running
+  static bool Cancel(Id id);
+
+  // Main thread only, once per frame
+  static void Update();
+
+  static size_t Running();
+};
+
+constexpr const char* to_c_str(Coroutines::Result result)
+{
+  switch (result) {
+    case Coroutines::Result::Completed:
+      return "completed";
+    case Coroutines::Result::Cancelled:
+      return "cancelled";
+    case Coroutines::Result::TimedOut:
+      return "timed out";
+    case Coroutines::Result::Failed:
+      return "failed";
+  }
+
+  return "unknown";
+}
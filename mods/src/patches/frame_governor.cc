@@ -0,0 +1,167 @@
+#include "frame_governor.h"
+#include "config.h"
+#include "trace_recorder.h"
+
+#include "prime/Vector3.h"
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+
+FrameGovernor::State FrameGovernor::state = FrameGovernor::State::Focused;
+
+// While managed the governor owns targetFrameRate and vSyncCount (vsync overrides the target, so
+// it is off while managed). The game's own values are put back when no limit applies any more.
+static bool managed         = false;
+static int  applied_rate    = 0;
+static int  game_frame_rate = -1;
+static int  game_vsync      = 1;
+
+static std::chrono::steady_clock::time_point last_input = std::chrono::steady_clock::now();
+static Vector3                               last_mouse{};
+
+struct ScrollDelta {
+  float x;
+  float y;
+};
+
+static bool has_input()
+{
+  static auto get_anyKey = il2cpp_resolve_icall_typed<bool()>("UnityEngine.Input::get_anyKey()");
+  static auto get_mousePosition =
+      il2cpp_resolve_icall_typed<void(Vector3*)>("UnityEngine.Input::get_mousePosition_Injected(UnityEngine.Vector3&)");
+  static auto get_mouseScrollDelta = il2cpp_resolve_icall_typed<void(ScrollDelta*)>(
+      "UnityEngine.Input::get_mouseScrollDelta_Injected(UnityEngine.Vector2&)");
+
+  auto input = get_anyKey && get_anyKey();
+
+  if (get_mousePosition) {
+    Vector3 mouse{};
+    get_mousePosition(&mouse);
+    input      = input || mouse.x != last_mouse.x || mouse.y != last_mouse.y;
+    last_mouse = mouse;
+  }
+
+  if (get_mouseScrollDelta) {
+    ScrollDelta scroll{};
+    get_mouseScrollDelta(&scroll);
+    input = input || scroll.x != 0.0f || scroll.y != 0.0f;
+  }
+
+  return input;
+}
+
+static bool is_minimized()
+{
+#if _WIN32
+  const auto hwnd = Config::WindowHandle();
+  return hwnd != nullptr && IsIconic(hwnd);
+#else
+  return false;
+#endif
+}
+
+static bool is_focused()
+{
+  static auto get_isFocused = il2cpp_resolve_icall_typed<bool()>("UnityEngine.Application::get_isFocused()");
+  return get_isFocused == nullptr || get_isFocused();
+}
+
+// The frame rate for a state, 0 leaves it to the game
+static int target_frame_rate(FrameGovernor::State state, const Config& config)
+{
+  switch (state) {
+    case FrameGovernor::State::Minimized:
+      return config.fps_minimized;
+    case FrameGovernor::State::Unfocused:
+      return config.fps_unfocused;
+    case FrameGovernor::State::Idle:
+      return config.fps_idle;
+    case FrameGovernor::State::Focused:
+      return config.fps_focused;
+  }
+
+  return 0;
+}
+
+void FrameGovernor::Update()
+{
+  static auto get_targetFrameRate =
+      il2cpp_resolve_icall_typed<int()>("UnityEngine.Application::get_targetFrameRate()");
+  static auto set_targetFrameRate =
+      il2cpp_resolve_icall_typed<void(int)>("UnityEngine.Application::set_targetFrameRate(System.Int32)");
+  static auto get_vSyncCount = il2cpp_resolve_icall_typed<int()>("UnityEngine.QualitySettings::get_vSyncCount()");
+  static auto set_vSyncCount =
+      il2cpp_resolve_icall_typed<void(int)>("UnityEngine.QualitySettings::set_vSyncCount(System.Int32)");
+  static auto available = [] {
+    if (!get_targetFrameRate || !set_targetFrameRate || !get_vSyncCount || !set_vSyncCount) {
+      spdlog::error("Unable to find the frame rate settings, the fps_* options are ignored");
+      return false;
+    }
+    return true;
+  }();
+
+  if (!available) {
+    return;
+  }
+
+  const auto  config = Config::Get();
+  const auto  now    = std::chrono::steady_clock::now();
+
+  if (has_input()) {
+    last_input = now;
+  }
+
+  auto next = State::Focused;
+  if (is_minimized()) {
+    next = State::Minimized;
+  } else if (!is_focused()) {
+    next = State::Unfocused;
+  } else if (config->fps_idle_seconds > 0 && now - last_input >= std::chrono::seconds(config->fps_idle_seconds)) {
+    next = State::Idle;
+  }
+
+  const auto rate = target_frame_rate(next, *config);
+
+  // The game changed its own settings while managed, remember them for when the limit is lifted
+  if (managed && (get_targetFrameRate() != applied_rate || get_vSyncCount() != 0)) {
+    game_frame_rate = get_targetFrameRate();
+    game_vsync      = get_vSyncCount();
+    applied_rate    = 0;
+  }
+
+  if (next == FrameGovernor::state && (managed ? rate == applied_rate : rate <= 0)) {
+    return;
+  }
+
+  if (rate > 0) {
+    if (!managed) {
+      game_frame_rate = get_targetFrameRate();
+      game_vsync      = get_vSyncCount();
+      managed         = true;
+    }
+
+    set_vSyncCount(0);
+    set_targetFrameRate(rate);
+    applied_rate = rate;
+  } else if (managed) {
+    set_vSyncCount(game_vsync);
+    set_targetFrameRate(game_frame_rate);
+    managed      = false;
+    applied_rate = 0;
+  }
+
+  if (next != FrameGovernor::state) {
+    spdlog::debug("Client is {}, frame rate {}", to_c_str(next), rate > 0 ? std::to_string(rate) : "as the game sets it");
+    TraceRecorder::Instant("frame rate", "frame", rate > 0 ? rate : game_frame_rate);
+  }
+
+  FrameGovernor::state = next;
+}
+
+FrameGovernor::State FrameGovernor::Current()
+{
+  return FrameGovernor::state;
+}
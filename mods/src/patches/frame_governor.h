@@ -0,0 +1,34 @@
+#pragma once
+
+// Lowers Application.targetFrameRate while the client is in the background, minimized or left
+// alone, so clients nobody is looking at stop competing with the one in use. The state is checked
+// at the start of every frame, so focus or input brings the full rate back on the next frame.
+class FrameGovernor
+{
+public:
+  enum class State { Focused, Unfocused, Minimized, Idle };
+
+  // Main thread only, once per frame
+  static void Update();
+
+  static State Current();
+
+private:
+  static State state;
+};
+
+constexpr const char* to_c_str(FrameGovernor::State state)
+{
+  switch (state) {
+    case FrameGovernor::State::Focused:
+      return "focused";
+    case FrameGovernor::State::Unfocused:
+      return "unfocused";
+    case FrameGovernor::State::Minimized:
+      return "minimized";
+    case FrameGovernor::State::Idle:
+      return "idle";
+  }
+
+  return "unknown";
+}
@@ -90,6 +90,9 @@ enum GameFunction {
   LogLevelError,
   LogLevelWarn,
   LogLevelOff,
+  ResetHookProfile,
+  DumpTrace,
+  ToggleLowSpec,
   Quit,
 
   // Automatic max value
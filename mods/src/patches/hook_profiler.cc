@@ -0,0 +1,278 @@
+#include "hook_profiler.h"
+#include "file.h"
+#include "trace_recorder.h"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Self time histogram, bucket i counts calls that took under 2^i ns (the last one is open ended)
+static constexpr size_t Buckets = 32;
+
+struct HookCounters {
+  std::atomic<uint64_t>                      calls{0};
+  std::atomic<uint64_t>                      total_ns{0};
+  std::atomic<uint64_t>                      self_ns{0};
+  std::atomic<uint64_t>                      max_self_ns{0};
+  std::array<std::atomic<uint32_t>, Buckets> histogram{};
+};
+
+// Written by its thread only, read by the writer thread
+struct ThreadCounters {
+  std::atomic<uint64_t>                            generation{0};
+  std::array<HookCounters, HookProfiler::MaxHooks> hooks;
+};
+
+bool HookProfiler::enabled = false;
+
+static std::array<std::atomic<const char*>, HookProfiler::MaxHooks> hook_names{};
+static std::atomic<uint32_t>                                        hook_count{0};
+static std::mutex                                                   register_mtx;
+
+static std::vector<std::unique_ptr<ThreadCounters>> thread_counters;
+static std::mutex                                   thread_counters_mtx;
+
+// Reset bumps the generation; each thread clears its own block when it next records
+static std::atomic<uint64_t>                              generation{1};
+static std::atomic<std::chrono::steady_clock::time_point> window_start{std::chrono::steady_clock::now()};
+
+static thread_local ThreadCounters*       local_counters = nullptr;
+static thread_local HookProfiler::Sample* current_sample = nullptr;
+
+// Single writer, so a relaxed load and store is enough and avoids a locked add
+static void bump(std::atomic<uint64_t>& counter, uint64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+static ThreadCounters& thread_block()
+{
+  if (local_counters == nullptr) [[unlikely]] {
+    auto block = std::make_unique<ThreadCounters>();
+    local_counters = block.get();
+
+    std::lock_guard lk(thread_counters_mtx);
+    thread_counters.emplace_back(std::move(block));
+  }
+
+  const auto current = generation.load(std::memory_order_acquire);
+  if (local_counters->generation.load(std::memory_order_relaxed) != current) [[unlikely]] {
+    for (auto& hook : local_counters->hooks) {
+      hook.calls.store(0, std::memory_order_relaxed);
+      hook.total_ns.store(0, std::memory_order_relaxed);
+      hook.self_ns.store(0, std::memory_order_relaxed);
+      hook.max_self_ns.store(0, std::memory_order_relaxed);
+      for (auto& bucket : hook.histogram) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+    local_counters->generation.store(current, std::memory_order_release);
+  }
+
+  return *local_counters;
+}
+
+static void record(uint32_t hook, uint64_t total_ns, uint64_t self_ns)
+{
+  auto& counters = thread_block().hooks[hook];
+
+  bump(counters.calls, 1);
+  bump(counters.total_ns, total_ns);
+  bump(counters.self_ns, self_ns);
+
+  if (self_ns > counters.max_self_ns.load(std::memory_order_relaxed)) {
+    counters.max_self_ns.store(self_ns, std::memory_order_relaxed);
+  }
+
+  auto& bucket = counters.histogram[std::min<size_t>(std::bit_width(self_ns), Buckets - 1)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+HookProfiler::Sample::Sample(uint32_t hook)
+    : hook(hook)
+    , start(std::chrono::steady_clock::now())
+    , parent(current_sample)
+{
+  current_sample = this;
+}
+
+HookProfiler::Sample::~Sample()
+{
+  const auto end   = std::chrono::steady_clock::now();
+  const auto total = end - this->start;
+  current_sample   = this->parent;
+
+  // A hook reached through the parent's original is already excluded from the parent's self time
+  if (this->parent && this->parent->inOriginal == 0) {
+    this->parent->excluded += total;
+  }
+
+  if (this->hook < HookProfiler::MaxHooks) {
+    const auto total_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(total).count();
+    const auto self_ns  = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(total - this->excluded).count();
+    record(this->hook, total_ns, self_ns);
+
+    if (TraceRecorder::enabled) {
+      TraceRecorder::Complete(hook_names[this->hook].load(std::memory_order_relaxed), "hook", this->start, end);
+    }
+  }
+}
+
+uint32_t HookProfiler::Register(const char* name)
+{
+  std::lock_guard lk(register_mtx);
+
+  const auto count = hook_count.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < count; ++i) {
+    if (std::strcmp(hook_names[i].load(std::memory_order_relaxed), name) == 0) {
+      return i;
+    }
+  }
+
+  if (count == HookProfiler::MaxHooks) {
+    spdlog::warn("Hook profiler is full, not profiling {}", name);
+    return HookProfiler::MaxHooks;
+  }
+
+  hook_names[count].store(name, std::memory_order_relaxed);
+  hook_count.store(count + 1, std::memory_order_release);
+  return count;
+}
+
+void HookProfiler::Reset()
+{
+  window_start.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+  generation.fetch_add(1, std::memory_order_release);
+  spdlog::info("Hook profiler counters reset");
+}
+
+std::string HookProfiler::ToJson()
+{
+  using json = nlohmann::json;
+
+  struct Totals {
+    uint64_t                      calls       = 0;
+    uint64_t                      total_ns    = 0;
+    uint64_t                      self_ns     = 0;
+    uint64_t                      max_self_ns = 0;
+    std::array<uint64_t, Buckets> histogram{};
+  };
+
+  const auto count   = hook_count.load(std::memory_order_acquire);
+  const auto current = generation.load(std::memory_order_acquire);
+
+  std::vector<Totals> totals(count);
+  {
+    std::lock_guard lk(thread_counters_mtx);
+    for (const auto& block : thread_counters) {
+      if (block->generation.load(std::memory_order_acquire) != current) {
+        continue;
+      }
+
+      for (uint32_t i = 0; i < count; ++i) {
+        const auto& hook = block->hooks[i];
+        auto&       sum  = totals[i];
+
+        sum.calls += hook.calls.load(std::memory_order_relaxed);
+        sum.total_ns += hook.total_ns.load(std::memory_order_relaxed);
+        sum.self_ns += hook.self_ns.load(std::memory_order_relaxed);
+        sum.max_self_ns = std::max(sum.max_self_ns, hook.max_self_ns.load(std::memory_order_relaxed));
+        for (size_t b = 0; b < Buckets; ++b) {
+          sum.histogram[b] += hook.histogram[b].load(std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  // Upper bound of the bucket the given fraction of calls falls in
+  auto percentile = [](const Totals& sum, double fraction) {
+    const auto target = (uint64_t)((double)sum.calls * fraction);
+    uint64_t   seen   = 0;
+    for (size_t b = 0; b < Buckets; ++b) {
+      seen += sum.histogram[b];
+      if (seen > target) {
+        return std::min(uint64_t{1} << b, sum.max_self_ns);
+      }
+    }
+    return sum.max_self_ns;
+  };
+
+  const auto window = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                    - window_start.load(std::memory_order_relaxed))
+                          .count();
+
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < count; ++i) {
+    if (totals[i].calls > 0) {
+      order.push_back(i);
+    }
+  }
+  std::ranges::sort(order, [&totals](uint32_t a, uint32_t b) { return totals[a].self_ns > totals[b].self_ns; });
+
+  auto hooks = json::array();
+  for (const auto i : order) {
+    const auto& sum = totals[i];
+
+    hooks.push_back({{"name", hook_names[i].load(std::memory_order_relaxed)},
+                     {"calls", sum.calls},
+                     {"total_ms", sum.total_ns / 1e6},
+                     {"self_ms", sum.self_ns / 1e6},
+                     {"self_ms_per_second", window > 0 ? sum.self_ns / 1e6 / window : 0.0},
+                     {"self_avg_us", sum.self_ns / 1e3 / sum.calls},
+                     {"self_p50_us", percentile(sum, 0.50) / 1e3},
+                     {"self_p99_us", percentile(sum, 0.99) / 1e3},
+                     {"self_max_us", sum.max_self_ns / 1e3}});
+  }
+
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+  return json{{"timestamp", std::chrono::duration_cast<std::chrono::seconds>(now).count()},
+              {"window_seconds", window},
+              {"hooks", hooks}}
+      .dump(2);
+}
+
+static void write_profile_file(int interval)
+{
+  const std::filesystem::path profile_path = File::MakePath(File::Profile());
+  auto                        temp_path    = profile_path;
+  temp_path += ".tmp";
+
+  for (;;) {
+    std::this_thread::sleep_for(std::chrono::seconds(interval));
+
+    try {
+      {
+        std::ofstream profile_file(temp_path, std::ios::trunc);
+        profile_file << HookProfiler::ToJson();
+      }
+
+      std::error_code ec;
+      std::filesystem::rename(temp_path, profile_path, ec);
+      if (ec) {
+        spdlog::warn("Failed to write hook profile to {}: {}", File::Profile(), ec.message());
+      }
+    } catch (const std::exception& e) {
+      spdlog::warn("Failed to write hook profile to {}: {}", File::Profile(), e.what());
+    }
+  }
+}
+
+void HookProfiler::Start(int interval)
+{
+  HookProfiler::enabled = true;
+  window_start.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+
+  std::thread(write_profile_file, std::max(interval, 1)).detach();
+  spdlog::info("Profiling hooks, writing {} every {}s", File::Profile(), std::max(interval, 1));
+}
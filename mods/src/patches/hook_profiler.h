@@ -0,0 +1,112 @@
+#pragma once
+
+#include <spud/detour.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+// Opt-in cost accounting for every detour ([control] profile_hooks).
+//
+// SPUD_STATIC_DETOUR is redefined at the bottom of this header so each hook is entered through a
+// wrapper. With profiling off the wrapper tests HookProfiler::enabled and calls the hook as before.
+// With it on, the hook gets a timed stand-in for its original, and each call records the call
+// count, the total time including the original, and the self time: the total minus the original
+// and any other hook called directly from this one.
+//
+// Every thread records into its own block of counters, so recording never takes a lock. A writer
+// thread adds the blocks together and rewrites File::Profile() every profile_interval seconds.
+class HookProfiler
+{
+public:
+  static constexpr uint32_t MaxHooks = 128;
+
+  // One call of a hook on the current thread
+  class Sample
+  {
+  public:
+    explicit Sample(uint32_t hook);
+    ~Sample();
+
+    Sample(const Sample&)            = delete;
+    Sample& operator=(const Sample&) = delete;
+
+    // Time spent in the original counts towards the total only
+    class OriginalScope
+    {
+    public:
+      explicit OriginalScope(Sample* sample)
+          : sample(sample)
+          , start(std::chrono::steady_clock::now())
+      {
+        ++this->sample->inOriginal;
+      }
+
+      ~OriginalScope()
+      {
+        --this->sample->inOriginal;
+        this->sample->excluded += std::chrono::steady_clock::now() - this->start;
+      }
+
+    private:
+      Sample*                               sample;
+      std::chrono::steady_clock::time_point start;
+    };
+
+  private:
+    uint32_t                              hook;
+    int                                   inOriginal = 0;
+    std::chrono::steady_clock::duration   excluded{};
+    std::chrono::steady_clock::time_point start;
+    Sample*                               parent;
+  };
+
+  // Handed to the hook in place of the trampoline while profiling
+  template <typename Original> struct TimedOriginal {
+    Original original;
+    Sample*  sample;
+
+    template <typename... Args> decltype(auto) operator()(Args&&... args) const
+    {
+      Sample::OriginalScope scope(this->sample);
+      return this->original(std::forward<Args>(args)...);
+    }
+  };
+
+  template <typename Hook, typename Original, typename... Args>
+  static decltype(auto) Call(uint32_t hook, Hook hook_fn, Original original, Args&&... args)
+  {
+    Sample sample(hook);
+    return hook_fn(TimedOriginal<Original>{original, &sample}, std::forward<Args>(args)...);
+  }
+
+  // Hooks installed more than once under the same name share their counters
+  static uint32_t Register(const char* name);
+
+  static void        Start(int interval);
+  static void        Reset();
+  static std::string ToJson();
+
+  static bool enabled;
+};
+
+#undef SPUD_STATIC_DETOUR
+
+// Creates a detour that will live until the end of the program
+#define SPUD_STATIC_DETOUR(addr, fn)                                                                                   \
+  (([=]() -> auto {                                                                                                    \
+    using dh_hook_t = spud::detail::function_traits_ptr<decltype(&fn<void (*)(...)>)>::FuncType;                       \
+    static const auto dh_profile_id  = HookProfiler::Register(#fn);                                                    \
+    static auto       dh_static_hook = spud::create_detour<decltype(&fn<void (*)(...)>)>(                              \
+        addr, static_cast<dh_hook_t>([](auto original, auto... args) {                                                 \
+          if (!HookProfiler::enabled) [[likely]] {                                                                     \
+            return fn(original, args...);                                                                              \
+          }                                                                                                            \
+          return HookProfiler::Call(                                                                                   \
+              dh_profile_id,                                                                                           \
+              [](auto original, auto&&... args) { return fn(original, std::forward<decltype(args)>(args)...); },       \
+              original, args...);                                                                                      \
+        }));                                                                                                           \
+    return dh_static_hook.install().trampoline();                                                                      \
+  })())
@@ -0,0 +1,215 @@
+#include "low_spec.h"
+#include "config.h"
+
+#include "prime/TransitionManager.h"
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+struct Profile {
+  bool  blur         = false;
+  bool  shadows      = false;
+  bool  particles    = false;
+  bool  transitions  = false;
+  float render_scale = 1.0f;
+
+  bool operator==(const Profile&) const = default;
+};
+
+static Profile profile_from(const Config& config)
+{
+  if (!config.low_spec) {
+    return {};
+  }
+
+  return {config.low_spec_blur, config.low_spec_shadows, config.low_spec_particles, config.low_spec_transitions,
+          std::clamp(config.low_spec_render_scale, 0.25f, 1.0f)};
+}
+
+static Profile applied;
+
+// What the game had before the profile changed it
+static int   game_shadows         = 0;
+static bool  game_soft_particles  = false;
+static int   game_particle_budget = 0;
+static float game_width_scale     = 1.0f;
+static float game_height_scale    = 1.0f;
+static int   game_wait_frames     = 0;
+static float game_blur_frames     = 0.0f;
+
+// The transition manager lives as long as the game, the weak handle and the native pointer check
+// only guard against it being replaced
+static Il2CppGCHandle transition_manager = nullptr;
+
+static bool is_alive(void* object)
+{
+  static auto cached_ptr =
+      il2cpp_get_class_helper("UnityEngine.CoreModule", "UnityEngine", "Object").GetField("m_CachedPtr").offset();
+  return object != nullptr && *(void**)((ptrdiff_t)object + cached_ptr) != nullptr;
+}
+
+static TransitionManager* get_transition_manager()
+{
+  if (transition_manager == nullptr) {
+    return nullptr;
+  }
+
+  const auto manager = (TransitionManager*)il2cpp_gchandle_get_target(transition_manager);
+  return is_alive(manager) ? manager : nullptr;
+}
+
+static void apply_blur(TransitionManager* manager, bool low_spec)
+{
+  static auto set_enabled =
+      il2cpp_resolve_icall_typed<void(void*, bool)>("UnityEngine.Behaviour::set_enabled(System.Boolean)");
+
+  if (manager == nullptr || !is_alive(manager->SBlurController)) {
+    return;
+  }
+
+  if (set_enabled) {
+    set_enabled(manager->SBlurController, !low_spec);
+  }
+}
+
+static void apply_transitions(TransitionManager* manager, bool low_spec)
+{
+  if (manager == nullptr || !is_alive(manager->SBlurController)) {
+    return;
+  }
+
+  const auto blur = manager->SBlurController;
+  if (low_spec) {
+    // The lowest value transition_time allows
+    blur->_blurTime      = 0.02f;
+    blur->_waitFrames    = 0.0f;
+    manager->_waitFrames = 0;
+  } else {
+    blur->_blurTime      = std::clamp(Config::Get()->transition_time, 0.02f, 1.0f);
+    blur->_waitFrames    = game_blur_frames;
+    manager->_waitFrames = game_wait_frames;
+  }
+}
+
+static void apply_shadows(bool low_spec)
+{
+  static auto get_shadows = il2cpp_resolve_icall_typed<int()>("UnityEngine.QualitySettings::get_shadows()");
+  static auto set_shadows =
+      il2cpp_resolve_icall_typed<void(int)>("UnityEngine.QualitySettings::set_shadows(UnityEngine.ShadowQuality)");
+
+  if (!get_shadows || !set_shadows) {
+    spdlog::warn("Unable to find QualitySettings.shadows, low_spec_shadows has no effect");
+    return;
+  }
+
+  if (low_spec) {
+    game_shadows = get_shadows();
+    set_shadows(0); // ShadowQuality.Disable
+  } else {
+    set_shadows(game_shadows);
+  }
+}
+
+static void apply_particles(bool low_spec)
+{
+  static auto get_softParticles =
+      il2cpp_resolve_icall_typed<bool()>("UnityEngine.QualitySettings::get_softParticles()");
+  static auto set_softParticles =
+      il2cpp_resolve_icall_typed<void(bool)>("UnityEngine.QualitySettings::set_softParticles(System.Boolean)");
+  static auto get_particleRaycastBudget =
+      il2cpp_resolve_icall_typed<int()>("UnityEngine.QualitySettings::get_particleRaycastBudget()");
+  static auto set_particleRaycastBudget =
+      il2cpp_resolve_icall_typed<void(int)>("UnityEngine.QualitySettings::set_particleRaycastBudget(System.Int32)");
+
+  if (!get_softParticles || !set_softParticles || !get_particleRaycastBudget || !set_particleRaycastBudget) {
+    spdlog::warn("Unable to find the QualitySettings particle options, low_spec_particles has no effect");
+    return;
+  }
+
+  if (low_spec) {
+    game_soft_particles  = get_softParticles();
+    game_particle_budget = get_particleRaycastBudget();
+    set_softParticles(false);
+    set_particleRaycastBudget(0);
+  } else {
+    set_softParticles(game_soft_particles);
+    set_particleRaycastBudget(game_particle_budget);
+  }
+}
+
+static void apply_render_scale(float previous, float scale)
+{
+  static auto get_widthScaleFactor =
+      il2cpp_resolve_icall_typed<float()>("UnityEngine.ScalableBufferManager::get_widthScaleFactor()");
+  static auto get_heightScaleFactor =
+      il2cpp_resolve_icall_typed<float()>("UnityEngine.ScalableBufferManager::get_heightScaleFactor()");
+  static auto ResizeBuffers = il2cpp_resolve_icall_typed<void(float, float)>(
+      "UnityEngine.ScalableBufferManager::ResizeBuffers(System.Single,System.Single)");
+
+  if (!get_widthScaleFactor || !get_heightScaleFactor || !ResizeBuffers) {
+    spdlog::warn("Unable to find ScalableBufferManager, low_spec_render_scale has no effect");
+    return;
+  }
+
+  if (previous >= 1.0f) {
+    game_width_scale  = get_widthScaleFactor();
+    game_height_scale = get_heightScaleFactor();
+  }
+
+  if (scale < 1.0f) {
+    ResizeBuffers(std::min(scale, game_width_scale), std::min(scale, game_height_scale));
+  } else {
+    ResizeBuffers(game_width_scale, game_height_scale);
+  }
+}
+
+void LowSpec::Update()
+{
+  const auto wanted = profile_from(*Config::Get());
+  if (wanted == applied) [[likely]] {
+    return;
+  }
+
+  const auto manager = get_transition_manager();
+  if (wanted.blur != applied.blur) {
+    apply_blur(manager, wanted.blur);
+  }
+  if (wanted.transitions != applied.transitions) {
+    apply_transitions(manager, wanted.transitions);
+  }
+  if (wanted.shadows != applied.shadows) {
+    apply_shadows(wanted.shadows);
+  }
+  if (wanted.particles != applied.particles) {
+    apply_particles(wanted.particles);
+  }
+  if (wanted.render_scale != applied.render_scale) {
+    apply_render_scale(applied.render_scale, wanted.render_scale);
+  }
+
+  spdlog::info("Low spec profile {}", Config::Get()->low_spec ? "on" : "off");
+  applied = wanted;
+}
+
+void LowSpec::OnTransitionManager(TransitionManager* manager)
+{
+  if (transition_manager != nullptr) {
+    il2cpp_gchandle_free(transition_manager);
+  }
+
+  transition_manager = il2cpp_gchandle_new_weakref((Il2CppObject*)manager, false);
+  if (is_alive(manager->SBlurController)) {
+    game_blur_frames = manager->SBlurController->_waitFrames;
+  }
+  game_wait_frames = manager->_waitFrames;
+
+  if (applied.blur) {
+    apply_blur(manager, true);
+  }
+  if (applied.transitions) {
+    apply_transitions(manager, true);
+  }
+}
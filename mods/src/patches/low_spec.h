@@ -0,0 +1,17 @@
+#pragma once
+
+struct TransitionManager;
+
+// The [graphics] low_spec profile: no background blur or screen transitions, no shadows, cheaper
+// particles and a smaller render scale, each behind its own option. What the game had is
+// remembered on the way in and put back when the profile is switched off again.
+class LowSpec
+{
+public:
+  // Main thread only, once per frame. Applies the profile whenever its options change, so the
+  // toggle_low_spec hotkey and edits of the settings file take effect on the next frame.
+  static void Update();
+
+  // Called from the TransitionManager Awake hook, which owns the blur used by screen transitions
+  static void OnTransitionManager(TransitionManager* manager);
+};
@@ -0,0 +1,99 @@
+#include "main_thread.h"
+#include "trace_recorder.h"
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <utility>
+
+static constexpr auto PriorityCount = (size_t)MainThread::Priority::Count;
+
+struct TaskNode {
+  MainThread::Task task;
+  TaskNode*        next;
+};
+
+// Posting pushes onto a lock-free stack per priority. The main thread takes a whole stack at once,
+// reverses it back into posting order and keeps what it could not run in its own deques.
+static std::array<std::atomic<TaskNode*>, PriorityCount> incoming{};
+static std::array<std::deque<MainThread::Task>, PriorityCount> pending;
+static std::atomic<bool>                                       running{false};
+
+void MainThread::Post(Task task, Priority priority)
+{
+  auto  node = new TaskNode{std::move(task), nullptr};
+  auto& head = incoming[(size_t)priority];
+
+  node->next = head.load(std::memory_order_relaxed);
+  while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+}
+
+static void take_incoming()
+{
+  for (size_t priority = 0; priority < PriorityCount; ++priority) {
+    auto node = incoming[priority].exchange(nullptr, std::memory_order_acquire);
+
+    TaskNode* ordered = nullptr;
+    while (node) {
+      auto next  = node->next;
+      node->next = ordered;
+      ordered    = node;
+      node       = next;
+    }
+
+    while (ordered) {
+      pending[priority].emplace_back(std::move(ordered->task));
+      delete std::exchange(ordered, ordered->next);
+    }
+  }
+}
+
+void MainThread::Drain(std::chrono::microseconds budget)
+{
+  running.store(true, std::memory_order_relaxed);
+  take_incoming();
+
+  const auto start = std::chrono::steady_clock::now();
+  auto       ran   = false;
+
+  for (auto& tasks : pending) {
+    while (!tasks.empty()) {
+      if (ran && std::chrono::steady_clock::now() - start >= budget) {
+        TraceRecorder::Instant("main thread tasks deferred", "frame", (int64_t)MainThread::Deferred());
+        return;
+      }
+
+      const auto task = std::move(tasks.front());
+      tasks.pop_front();
+      ran = true;
+
+      TraceRecorder::Scope trace("main thread task", "frame");
+      try {
+        task();
+      } catch (const std::exception& e) {
+        spdlog::error("Main thread task failed: {}", e.what());
+      } catch (...) {
+        spdlog::error("Main thread task failed: unknown exception");
+      }
+    }
+  }
+}
+
+size_t MainThread::Deferred()
+{
+  size_t count = 0;
+  for (const auto& tasks : pending) {
+    count += tasks.size();
+  }
+
+  return count;
+}
+
+bool MainThread::Running()
+{
+  return running.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+// Work for the game's main thread. Any thread may post, the tasks run from the ScreenManager
+// update, where touching Unity objects is safe. Each frame runs tasks, highest priority first and
+// in posting order within a priority, until the frame's budget is spent; the rest wait for the
+// next frame. A task posted while tasks are running is picked up next frame.
+class MainThread
+{
+public:
+  enum class Priority { High, Normal, Low, Count };
+
+  using Task = std::function<void()>;
+
+  static void Post(Task task, Priority priority = Priority::Normal);
+
+  // Main thread only. At least one task runs even when the budget is already spent.
+  static void Drain(std::chrono::microseconds budget);
+
+  // Tasks taken from the queue but deferred to a later frame, main thread only
+  static size_t Deferred();
+
+  // True once the frame hook has drained the queue. Before that, or when the hook is not
+  // installed, posted tasks wait.
+  static bool Running();
+};
@@ -1,15 +1,45 @@
 #include "mapkey.h"
+#include "config.h"
 #include "gamefunctions.h"
 #include "modifierkey.h"
 #include "str_utils.h"
+#include "trace_recorder.h"
 #include <prime/KeyCode.h>
 
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <string>
 #include <string_view>
 #include <vector>
 
+// Every key Key::IsModified looks at. Bits 0-10 of a modifier mask are these keys, bits 11-15 are
+// set when either key of a left/right pair is held, so "SHIFT" needs a single bit like "LSHIFT".
+static constexpr std::array<KeyCode, 11> ModifierKeys = {
+    KeyCode::LeftShift,   KeyCode::RightShift,   KeyCode::LeftControl, KeyCode::RightControl,
+    KeyCode::LeftAlt,     KeyCode::RightAlt,     KeyCode::LeftCommand, KeyCode::RightCommand,
+    KeyCode::LeftWindows, KeyCode::RightWindows, KeyCode::AltGr,
+};
+
+static constexpr int      ModifierPairs   = 5;
+static constexpr uint16_t SingleModifiers = (1 << ModifierKeys.size()) - 1;
+
+static constexpr uint16_t pair_keys(int pair)
+{
+  return 3 << (pair * 2);
+}
+
+static constexpr uint16_t pair_bit(int pair)
+{
+  return 1 << (ModifierKeys.size() + pair);
+}
+
+static uint16_t modifier_key_bit(KeyCode key)
+{
+  const auto it = std::find(ModifierKeys.begin(), ModifierKeys.end(), key);
+  return it == ModifierKeys.end() ? 0 : 1 << (it - ModifierKeys.begin());
+}
+
 MapKey::MapKey()
 {
   this->Key          = KeyCode::None;
@@ -54,8 +84,11 @@ MapKey MapKey::Parse(std::string_view key)
 
 std::string MapKey::GetShortcuts(GameFunction gameFunction)
 {
-  const auto &mapKeys = MapKey::mappedKeys[gameFunction];
+  return MapKey::GetShortcuts(Config::Get()->shortcuts[gameFunction]);
+}
 
+std::string MapKey::GetShortcuts(const std::vector<MapKey>& mapKeys)
+{
   bool appendPipe = false;
 
   std::string shortcuts = "";
@@ -70,44 +103,134 @@ std::string MapKey::GetShortcuts(GameFunction gameFunction)
   return shortcuts;
 }
 
-void MapKey::AddMappedKey(GameFunction gameFunction, MapKey mappedKey)
+void MapKey::Compile(const Config& config)
 {
-  MapKey::mappedKeys[gameFunction].emplace_back(mappedKey);
+  MapKey::keyBindings.clear();
+  for (auto& bindings : MapKey::functionBindings) {
+    bindings.clear();
+  }
+
+  for (int gameFunction = 0; gameFunction < GameFunction::Max; gameFunction++) {
+    for (const auto& mapKey : config.shortcuts[gameFunction]) {
+      if (mapKey.Key != KeyCode::None) {
+        const Binding binding{mapKey.Key, MapKey::ModifierBits(mapKey), (GameFunction)gameFunction};
+        MapKey::keyBindings.emplace_back(binding);
+        MapKey::functionBindings[gameFunction].emplace_back(binding);
+      }
+    }
+  }
+
+  std::stable_sort(MapKey::keyBindings.begin(), MapKey::keyBindings.end(),
+                   [](const Binding& a, const Binding& b) { return a.Key < b.Key; });
+
+  MapKey::compiledGeneration = config.generation;
 }
 
-bool MapKey::IsPressed(GameFunction gameFunction)
+uint16_t MapKey::ModifierBits(const MapKey& mapKey)
 {
-  const auto &mapKeys = MapKey::mappedKeys[(int)gameFunction];
-  for (const MapKey &mapKey : mapKeys) {
-    if (mapKey.Key != KeyCode::None) {
-      if (Key::Pressed(mapKey.Key)) {
-        if (MapKey::HasCorrectModifiers(mapKey)) {
-          return true;
-        }
+  uint16_t bits = 0;
+  for (const auto& modifier : mapKey.Modifiers) {
+    uint16_t keys = 0;
+    for (const auto key : modifier.GetModifiers()) {
+      keys |= modifier_key_bit(key);
+    }
+
+    // Each modifier is either a single key or both keys of a pair, e.g. LSHIFT or SHIFT
+    auto bit = keys;
+    for (int pair = 0; pair < ModifierPairs; ++pair) {
+      if (keys == pair_keys(pair)) {
+        bit = pair_bit(pair);
       }
     }
+
+    bits |= bit;
   }
 
-  return false;
+  return bits;
 }
 
-bool MapKey::IsDown(GameFunction gameFunction)
+// Polled once a frame, the first time a shortcut needs it
+uint16_t MapKey::HeldModifiers()
 {
-  const auto &mapKeys = MapKey::mappedKeys[(int)gameFunction];
-  for (const MapKey &mapKey : mapKeys) {
-    if (mapKey.Key != KeyCode::None) {
-      if (Key::Down(mapKey.Key)) {
-        if (MapKey::HasCorrectModifiers(mapKey)) {
-          return true;
-        }
+  if (MapKey::frameModifiers < 0) {
+    uint16_t held = 0;
+    for (size_t i = 0; i < ModifierKeys.size(); ++i) {
+      if (Key::Pressed(ModifierKeys[i])) {
+        held |= 1 << i;
+      }
+    }
+
+    for (int pair = 0; pair < ModifierPairs; ++pair) {
+      if (held & pair_keys(pair)) {
+        held |= pair_bit(pair);
       }
     }
+
+    MapKey::frameModifiers = held;
+  }
+
+  return uint16_t(MapKey::frameModifiers);
+}
+
+bool MapKey::Matches(const Binding& binding, uint16_t held)
+{
+  if (binding.Modifiers == 0) {
+    return (held & SingleModifiers) == 0;
+  }
+
+  return (held & binding.Modifiers) == binding.Modifiers;
+}
+
+// Call once per frame, after Key::ResetCache. Polls each key that triggers a shortcut once, and
+// only checks the modifiers of the shortcuts whose key went down. Recompiles the bindings first if
+// a new config snapshot was published.
+void MapKey::Update()
+{
+  MapKey::functionsDown.reset();
+  MapKey::frameModifiers = -1;
+
+  if (const auto config = Config::Get(); config->generation != MapKey::compiledGeneration) {
+    MapKey::Compile(*config);
+  }
+
+  const auto& bindings = MapKey::keyBindings;
+  for (size_t first = 0, last = 0; first < bindings.size(); first = last) {
+    const auto key = bindings[first].Key;
+    while (last < bindings.size() && bindings[last].Key == key) {
+      ++last;
+    }
+
+    if (!Key::Down(key)) {
+      continue;
+    }
+
+    const auto held = MapKey::HeldModifiers();
+    for (auto i = first; i < last; ++i) {
+      if (MapKey::Matches(bindings[i], held)) {
+        MapKey::functionsDown.set(bindings[i].Function);
+        TraceRecorder::Instant("hotkey", "input", bindings[i].Function);
+      }
+    }
+  }
+}
+
+bool MapKey::IsPressed(GameFunction gameFunction)
+{
+  for (const auto& binding : MapKey::functionBindings[(int)gameFunction]) {
+    if (Key::Pressed(binding.Key) && MapKey::Matches(binding, MapKey::HeldModifiers())) {
+      return true;
+    }
   }
 
   return false;
 }
 
-bool MapKey::HasCorrectModifiers(MapKey mapKey)
+bool MapKey::IsDown(GameFunction gameFunction)
+{
+  return MapKey::functionsDown.test((int)gameFunction);
+}
+
+bool MapKey::HasCorrectModifiers(const MapKey& mapKey)
 {
   auto        result  = false;
   std::string section = "non set";
@@ -116,7 +239,7 @@ bool MapKey::HasCorrectModifiers(MapKey mapKey)
     result  = !Key::IsModified();
   } else {
     result = true;
-    for (ModifierKey modifier : mapKey.Modifiers) {
+    for (const ModifierKey& modifier : mapKey.Modifiers) {
       if (!modifier.IsPressed()) {
         section = modifier.GetParsedValues();
         result  = false;
@@ -147,7 +270,12 @@ std::string MapKey::GetParsedValues() const
   return output;
 }
 
-std::array<std::vector<MapKey>, (int)GameFunction::Max> MapKey::mappedKeys = {};
+std::vector<MapKey::Binding>                                     MapKey::keyBindings        = {};
+std::array<std::vector<MapKey::Binding>, (int)GameFunction::Max> MapKey::functionBindings   = {};
+uint64_t                                                         MapKey::compiledGeneration = 0;
+
+std::bitset<(int)GameFunction::Max> MapKey::functionsDown  = {};
+int                                 MapKey::frameModifiers = -1;
 
 std::vector<std::string> Shortcuts = {};
 std::vector<ModifierKey> Modifiers = {};
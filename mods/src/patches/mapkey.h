@@ -5,21 +5,26 @@
 #include <prime/KeyCode.h>
 
 #include <array>
+#include <bitset>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+class Config;
+
 class MapKey
 {
 public:
   MapKey();
 
   static MapKey Parse(std::string_view key);
-  static void   AddMappedKey(GameFunction gameFunction, MapKey mappedKey);
+  static void   Update();
   static bool   IsPressed(GameFunction gameFunction);
   static bool   IsDown(GameFunction gameFunction);
-  static bool   HasCorrectModifiers(MapKey mapKey);
+  static bool   HasCorrectModifiers(const MapKey& mapKey);
 
   static std::string GetShortcuts(GameFunction gameFunction);
+  static std::string GetShortcuts(const std::vector<MapKey>& mapKeys);
 
   std::string GetParsedValues() const;
 
@@ -29,7 +34,28 @@ public:
   KeyCode Key;
 
 private:
-  static std::array<std::vector<MapKey>, (int)GameFunction::Max> mappedKeys;
+  // A shortcut compiled down to its trigger key and the modifiers it needs, one bit per modifier
+  // key or left/right pair (see ModifierBits). No bits means no modifier may be held.
+  struct Binding {
+    KeyCode      Key;
+    uint16_t     Modifiers;
+    GameFunction Function;
+  };
+
+  static uint16_t ModifierBits(const MapKey& mapKey);
+  static uint16_t HeldModifiers();
+  static bool     Matches(const Binding& binding, uint16_t held);
+  static void     Compile(const Config& config);
+
+  // All bindings sorted by trigger key, and the same bindings per game function, compiled from the
+  // shortcuts of the config snapshot with this generation
+  static std::vector<Binding>                                     keyBindings;
+  static std::array<std::vector<Binding>, (int)GameFunction::Max> functionBindings;
+  static uint64_t                                                 compiledGeneration;
+
+  // Resolved once per frame by Update
+  static std::bitset<(int)GameFunction::Max> functionsDown;
+  static int                                 frameModifiers;
 
   bool hasModifiers;
 };
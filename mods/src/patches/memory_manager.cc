@@ -0,0 +1,121 @@
+#include "memory_manager.h"
+#include "config.h"
+#include "frame_governor.h"
+#include "sync_metrics.h"
+#include "trace_recorder.h"
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstdint>
+
+using memory_clock = TraceRecorder::clock;
+
+static constexpr int64_t MB = 1024 * 1024;
+
+// How often the heap size in the stats is refreshed
+static constexpr auto SampleInterval = std::chrono::seconds(1);
+
+bool                  MemoryManager::pending = false;
+MemoryManager::Reason MemoryManager::reason  = MemoryManager::Reason::SectionChange;
+
+// Bytes in use after the last collection and the last unload, growth is measured from these.
+// Both start from the first frame.
+static int64_t used_after_collect = -1;
+static int64_t used_after_unload  = -1;
+
+static void collect(MemoryManager::Reason reason)
+{
+  const auto before = il2cpp_gc_get_used_size();
+  const auto start  = memory_clock::now();
+  il2cpp_gc_collect(0);
+  const auto end = memory_clock::now();
+
+  used_after_collect = il2cpp_gc_get_used_size();
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  SyncMetrics::CountCollection("gc", to_c_str(reason), seconds);
+  TraceRecorder::Complete("collect", "gc", start, end, to_c_str(reason));
+  spdlog::debug("GC ({}) freed {} MB in {:.1f}ms, {} MB in use", to_c_str(reason),
+                (before - used_after_collect) / MB, seconds * 1000.0, used_after_collect / MB);
+}
+
+// UnloadUnusedAssets finishes over the next frames and collects on its own when it does, so no
+// collection is needed next to it
+static void unload_assets(MemoryManager::Reason reason)
+{
+  static auto UnloadUnusedAssets =
+      il2cpp_resolve_icall_typed<Il2CppObject*()>("UnityEngine.Resources::UnloadUnusedAssets()");
+
+  const auto used = il2cpp_gc_get_used_size();
+  used_after_unload  = used;
+  used_after_collect = used;
+
+  if (!UnloadUnusedAssets) {
+    return collect(reason);
+  }
+
+  const auto start = memory_clock::now();
+  UnloadUnusedAssets();
+  const auto end = memory_clock::now();
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  SyncMetrics::CountCollection("unload_assets", to_c_str(reason), seconds);
+  TraceRecorder::Complete("unload unused assets", "gc", start, end, to_c_str(reason));
+  spdlog::debug("Unloading unused assets ({}), {} MB in use", to_c_str(reason), used / MB);
+}
+
+void MemoryManager::OnSafePoint(Reason reason)
+{
+  MemoryManager::pending = true;
+  MemoryManager::reason  = reason;
+}
+
+void MemoryManager::Update()
+{
+  static memory_clock::time_point last_sample;
+
+  const auto  config = Config::Get();
+  const auto  now    = memory_clock::now();
+  const auto  used   = il2cpp_gc_get_used_size();
+
+  if (used_after_collect < 0) {
+    used_after_collect = used;
+    used_after_unload  = used;
+  }
+
+  if (now - last_sample >= SampleInterval) {
+    last_sample = now;
+    SyncMetrics::SetHeapSize(il2cpp_gc_get_heap_size(), used);
+  }
+
+  const auto state      = FrameGovernor::Current();
+  auto       safe_point = MemoryManager::pending;
+  auto       reason     = MemoryManager::reason;
+  if (!safe_point && (state == FrameGovernor::State::Unfocused || state == FrameGovernor::State::Minimized)) {
+    safe_point = true;
+    reason     = Reason::Background;
+  }
+  MemoryManager::pending = false;
+
+  const auto growth = used - used_after_collect;
+
+  if (safe_point) {
+    if (config->gc_unload_growth > 0 && used - used_after_unload >= config->gc_unload_growth * MB) {
+      unload_assets(reason);
+    } else if (config->gc_growth > 0 && growth >= config->gc_growth * MB) {
+      collect(reason);
+    }
+  } else if (config->gc_limit > 0 && growth >= config->gc_limit * MB) {
+    collect(Reason::Limit);
+  } else if (config->gc_growth > 0 && growth >= config->gc_growth * MB && il2cpp_gc_is_incremental()) {
+    TraceRecorder::Scope trace("collect a little", "gc");
+
+    // Zero once the incremental cycle is through, growth counts from what it left behind
+    if (il2cpp_gc_collect_a_little() == 0) {
+      used_after_collect = il2cpp_gc_get_used_size();
+    }
+  }
+}
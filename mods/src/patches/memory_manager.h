@@ -0,0 +1,42 @@
+#pragma once
+
+// Runs the garbage collector and Resources.UnloadUnusedAssets when nobody notices the pause: on a
+// section change, while a scene loads, or while the client is unfocused or minimized. Left to
+// itself the GC picks its own moment, which tends to be the middle of a battle, and a long session
+// keeps growing until the client stutters. Idle is no safe point: players watch battles and armadas
+// without touching the input.
+//
+// Nothing runs until the managed heap has grown by gc_growth MB since the last collection (or by
+// gc_unload_growth MB since the last unload). Past gc_limit MB of growth it collects at once,
+// safe point or not. In between, an incremental GC gets one slice per frame.
+class MemoryManager
+{
+public:
+  enum class Reason { SectionChange, SceneLoaded, Background, Limit };
+
+  // Called from the SectionManager and SceneManager detours, the work happens in the next Update
+  static void OnSafePoint(Reason reason);
+
+  // Main thread only, once per frame
+  static void Update();
+
+private:
+  static bool   pending;
+  static Reason reason;
+};
+
+constexpr const char* to_c_str(MemoryManager::Reason reason)
+{
+  switch (reason) {
+    case MemoryManager::Reason::SectionChange:
+      return "section_change";
+    case MemoryManager::Reason::SceneLoaded:
+      return "scene_loaded";
+    case MemoryManager::Reason::Background:
+      return "background";
+    case MemoryManager::Reason::Limit:
+      return "limit";
+  }
+
+  return "unknown";
+}
@@ -6,7 +6,7 @@
 #include <prime/IBuffComparer.h>
 #include <prime/IBuffData.h>
 
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 static bool BuffService_IsBuffConditionMet(auto original, void* _this, BuffCondition currentCondition,
                                            IBuffComparer *buffComparer, IBuffData *buffToCompare,
@@ -25,7 +25,7 @@ static bool BuffService_IsBuffConditionMet(auto original, void* _this, BuffCondi
 
 void InstallBuffFixHooks()
 {
-  if (Config::Get().use_out_of_dock_power) {
+  if (Config::Get()->use_out_of_dock_power) {
     auto buffHelper =
         il2cpp_get_class_helper("Digit.Client.PrimeLib.Runtime", "Digit.PrimeServer.Services", "BuffService");
     if (!buffHelper.isValidHelper()) {
@@ -1,3 +1,4 @@
+#include "prime/ChatMessage.h"
 #include "prime/ChatPreviewController.h"
 #include "prime/FullScreenChatViewController.h"
 #include "prime/GenericButtonContext.h"
@@ -5,9 +6,48 @@
 #include "config.h"
 #include "errormsg.h"
 
-#include <spud/detour.h>
+#include "patches/chat_filter.h"
+#include "patches/hook_profiler.h"
+
+#include <spdlog/spdlog.h>
+
 #include <tuple>
 
+// Set once the ChatManager receive methods are detoured, until then the preview controller drops
+// blocked messages itself
+static bool chat_manager_filtered = false;
+
+// False when this version of the game lacks a ChatMessage property the filter reads, nothing is
+// filtered then
+static bool chat_message_valid = false;
+
+// The action for the last message the ChatManager detours let through, so the preview controller
+// that receives it next doesn't run the filter a second time. Main thread only.
+static void*              passed_message = nullptr;
+static ChatFilter::Action passed_action  = ChatFilter::Action::None;
+
+static ChatFilter::Action CheckChatFilter(void* message)
+{
+  if (message == nullptr || !chat_message_valid) {
+    return ChatFilter::Action::None;
+  }
+
+  const auto filter = Config::Get()->chat_filter;
+  if (!filter || filter->Empty()) {
+    return ChatFilter::Action::None;
+  }
+
+  const auto chat_message = (ChatMessage*)message;
+  const auto action       = filter->Check(ChatMessage::View(chat_message->SenderName),
+                                          ChatMessage::View(chat_message->AllianceTag),
+                                          ChatMessage::View(chat_message->Text));
+  if (action != ChatFilter::Action::None) {
+    spdlog::trace("Chat filter {} a message", action == ChatFilter::Action::Block ? "blocked" : "muted");
+  }
+
+  return action;
+}
+
 auto GetChatTabIndices()
 {
   if (const auto chat_manager = ChatManager::Instance(); chat_manager) {
@@ -26,8 +66,8 @@ auto GetChatTabIndices()
 
 void DisableButtons(FullScreenChatViewController* _this)
 {
-  const auto disableGalaxyChat = Config::Get().disable_galaxy_chat;
-  const auto disableVeilChat = Config::Get().disable_veil_chat;
+  const auto disableGalaxyChat = Config::Get()->disable_galaxy_chat;
+  const auto disableVeilChat = Config::Get()->disable_veil_chat;
 
   if (!(disableGalaxyChat || disableVeilChat))
     return;
@@ -77,7 +117,7 @@ void FullScreenChatViewController_AboutToShow(auto original, FullScreenChatViewC
 void FullScreenChatViewController_OnDidChangeSelectedTab(auto original, FullScreenChatViewController* _this, int32_t tabIdx, void* tab)
 {
   const auto [cadetChatIdx, galaxyChatIdx, veilChatIdx, allianceChatIdx] = GetChatTabIndices();
-  if ((tabIdx == galaxyChatIdx && Config::Get().disable_galaxy_chat) || (tabIdx == veilChatIdx && Config::Get().disable_veil_chat)) {
+  if ((tabIdx == galaxyChatIdx && Config::Get()->disable_galaxy_chat) || (tabIdx == veilChatIdx && Config::Get()->disable_veil_chat)) {
     // don't show disabled chats if the associated tab was selected
     return;
   }
@@ -89,7 +129,7 @@ void ChatPreviewController_AboutToShow(auto original, ChatPreviewController* _th
 {
   original(_this);
 
-  if (Config::Get().disable_galaxy_chat || Config::Get().disable_veil_chat) {
+  if (Config::Get()->disable_galaxy_chat || Config::Get()->disable_veil_chat) {
     const auto allianceChatIdx = std::get<3>(GetChatTabIndices());
     _this->_focusedPanel       = ChatChannelCategory::Alliance;
 
@@ -101,8 +141,8 @@ void ChatPreviewController_AboutToShow(auto original, ChatPreviewController* _th
 
 void ChatPreviewController_OnPanelFocused(auto original, ChatPreviewController* _this, int32_t index)
 {
-  static const auto disableGalaxyChat = Config::Get().disable_galaxy_chat;
-  static const auto disableVeilChat   = Config::Get().disable_veil_chat;
+  static const auto disableGalaxyChat = Config::Get()->disable_galaxy_chat;
+  static const auto disableVeilChat   = Config::Get()->disable_veil_chat;
 
   if (!(disableGalaxyChat || disableVeilChat)) {
     original(_this, index);
@@ -124,9 +164,52 @@ void ChatPreviewController_OnPanelFocused(auto original, ChatPreviewController*
   original(_this, index);
 }
 
+// Blocked messages end here, before any controller builds a view for them
+static bool ManagerFiltered(void* message)
+{
+  const auto action = CheckChatFilter(message);
+  if (action == ChatFilter::Action::Block) {
+    return true;
+  }
+
+  passed_message = message;
+  passed_action  = action;
+  return false;
+}
+
+void ChatManager_OnGlobalMessageReceived(auto original, ChatManager* _this, void* message)
+{
+  if (ManagerFiltered(message)) {
+    return;
+  }
+
+  original(_this, message);
+}
+
+void ChatManager_OnRegionalMessageReceived(auto original, ChatManager* _this, void* message)
+{
+  if (ManagerFiltered(message)) {
+    return;
+  }
+
+  original(_this, message);
+}
+
+// Muted messages only stay out of the preview
+static bool PreviewFiltered(void* message)
+{
+  if (message != nullptr && message == passed_message) {
+    passed_message = nullptr;
+    return passed_action == ChatFilter::Action::Mute;
+  }
+
+  const auto action = CheckChatFilter(message);
+  return action == ChatFilter::Action::Mute || (action == ChatFilter::Action::Block && !chat_manager_filtered);
+}
+
 void ChatPreviewController_OnGlobalMessageReceived(auto original, ChatPreviewController* _this, void* message)
 {
-  if (Config::Get().disable_galaxy_chat)
+  if (Config::Get()->disable_galaxy_chat || PreviewFiltered(message))
     return;
 
   original(_this, message);
@@ -134,7 +217,7 @@ void ChatPreviewController_OnGlobalMessageReceived(auto original, ChatPreviewCon
 
 void ChatPreviewController_OnRegionalMessageReceived(auto original, ChatPreviewController* _this, void* message)
 {
-  if (Config::Get().disable_veil_chat)
+  if (Config::Get()->disable_veil_chat || PreviewFiltered(message))
     return;
 
   original(_this, message);
@@ -188,4 +271,24 @@ void InstallChatPatches()
       SPUD_STATIC_DETOUR(ptr, ChatPreviewController_OnRegionalMessageReceived);
     }
   }
+
+  chat_message_valid = ChatMessage::IsValid();
+
+  if (!chat_message_valid) {
+    ErrorMsg::MissingHelper("Chat", "ChatMessage");
+  } else if (auto chat_manager = ChatManager::get_class_helper(); !chat_manager.isValidHelper()) {
+    ErrorMsg::MissingHelper("Chat", "ChatManager");
+  } else {
+    const auto global   = chat_manager.GetMethod("OnGlobalMessageReceived");
+    const auto regional = chat_manager.GetMethod("OnRegionalMessageReceived");
+    if (global == nullptr) {
+      ErrorMsg::MissingMethod("ChatManager", "OnGlobalMessageReceived");
+    } else if (regional == nullptr) {
+      ErrorMsg::MissingMethod("ChatManager", "OnRegionalMessageReceived");
+    } else {
+      SPUD_STATIC_DETOUR(global, ChatManager_OnGlobalMessageReceived);
+      SPUD_STATIC_DETOUR(regional, ChatManager_OnRegionalMessageReceived);
+      chat_manager_filtered = true;
+    }
+  }
 }
@@ -4,15 +4,15 @@
 #include <il2cpp/il2cpp_helper.h>
 #include <prime/Toast.h>
 
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 struct ToastObserver {
 };
 
 void ToastObserver_EnqueueToast_Hook(auto original, ToastObserver *_this, Toast *toast)
 {
-  if (std::ranges::find(Config::Get().disabled_banner_types, toast->get_State())
-      != Config::Get().disabled_banner_types.end()) {
+  if (std::ranges::find(Config::Get()->disabled_banner_types, toast->get_State())
+      != Config::Get()->disabled_banner_types.end()) {
     return;
   }
 
@@ -21,8 +21,8 @@ void ToastObserver_EnqueueToast_Hook(auto original, ToastObserver *_this, Toast
 
 void ToastObserver_EnqueueOrCombineToast_Hook(auto original, ToastObserver *_this, Toast *toast, uintptr_t cmpAction)
 {
-  if (std::ranges::find(Config::Get().disabled_banner_types, toast->get_State())
-      != Config::Get().disabled_banner_types.end()) {
+  if (std::ranges::find(Config::Get()->disabled_banner_types, toast->get_State())
+      != Config::Get()->disabled_banner_types.end()) {
     return;
   }
 
@@ -6,7 +6,7 @@
 #include <prime/NavigationPan.h>
 #include <prime/TKTouch.h>
 
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 TKTouch *TKTouch_populateWithPosition_Hook(auto original, TKTouch *_this, uintptr_t pos, TouchPhase phase)
 {
@@ -21,7 +21,7 @@ bool NavigationPan_LateUpdate_Hook(auto original, NavigationPan *_this)
 {
   auto d = _this->_lastDelta;
 
-  if (!Config::Get().disable_move_keys) {
+  if (!Config::Get()->disable_move_keys) {
     original(_this);
   }
 
@@ -34,8 +34,8 @@ bool NavigationPan_LateUpdate_Hook(auto original, NavigationPan *_this)
   } else if (GetMouseButton(0) || GetTouchCount() > 0) {
     //
   } else {
-    d->x = d->x * Config::Get().system_pan_momentum_falloff;
-    d->y = d->y * Config::Get().system_pan_momentum_falloff;
+    d->x = d->x * Config::Get()->system_pan_momentum_falloff;
+    d->y = d->y * Config::Get()->system_pan_momentum_falloff;
     _this->MoveCamera(vec2{d->x, d->y}, true);
   }
   _this->_farMagRadiusRatioSystemExtended = _this->_farMagRadiusRatioSystemNormal;
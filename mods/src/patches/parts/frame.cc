@@ -0,0 +1,58 @@
+#include "config.h"
+#include "errormsg.h"
+
+#include "patches/coroutines.h"
+#include "patches/frame_governor.h"
+#include "patches/low_spec.h"
+#include "patches/main_thread.h"
+#include "patches/memory_manager.h"
+#include "patches/state_elision.h"
+#include "patches/trace_recorder.h"
+#include "patches/ui_latency.h"
+#include "prime/ScreenManager.h"
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include "patches/hook_profiler.h"
+
+#include <chrono>
+#include <functional>
+
+// Set by InstallHotkeyHooks; a second detour on ScreenManager.Update can't be stacked on this one,
+// so the hotkeys run from here and decide themselves whether the original Update is called
+void (*frame_hotkeys)(const std::function<void(ScreenManager*)>& original, ScreenManager* _this) = nullptr;
+
+void ScreenManager_Update_Frame(auto original, ScreenManager* _this)
+{
+  TraceRecorder::Frame();
+  FrameGovernor::Update();
+  LowSpec::Update();
+  UiLatency::Update();
+  StateElision::Update();
+  MemoryManager::Update();
+
+  MainThread::Drain(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::duration<float, std::milli>(Config::Get()->frame_task_budget)));
+  Coroutines::Update();
+
+  if (frame_hotkeys) {
+    return frame_hotkeys(original, _this);
+  }
+
+  return original(_this);
+}
+
+void InstallFrameHooks()
+{
+  auto screen_manager_helper = il2cpp_get_class_helper("Assembly-CSharp", "Digit.Client.UI", "ScreenManager");
+  if (!screen_manager_helper.isValidHelper()) {
+    ErrorMsg::MissingHelper("UI", "ScreenManager");
+  } else {
+    auto ptr_update = screen_manager_helper.GetMethod("Update");
+    if (ptr_update == nullptr) {
+      ErrorMsg::MissingMethod("ScreenManager", "Update");
+    } else {
+      SPUD_STATIC_DETOUR(ptr_update, ScreenManager_Update_Frame);
+    }
+  }
+}
@@ -5,7 +5,7 @@
 #include "errormsg.h"
 #include "file.h"
 
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 #include "prime/AspectRatioConstraintHandler.h"
 #include "prime/IList.h"
@@ -75,14 +75,14 @@ LONG                      SetWindowLongW_Hook(_In_ HWND hWnd, _In_ int nIndex, _
     GetClassNameA(hWnd, clsName_v, 256);
     if (clsName_v == std::string("UnityWndClass")) {
       unityWindow = hWnd;
-      if (Config::Get().free_resize) {
+      if (Config::Get()->free_resize) {
         if (!(dwNewLong & WS_POPUP)) {
           dwNewLong = WS_OVERLAPPEDWINDOW;
         }
       }
 
       if (!WndProcInstalled) {
-        if (Config::Get().borderless_fullscreen) {
+        if (Config::Get()->borderless_fullscreen) {
           oWndProc         = SetWindowLongPtr(hWnd, GWLP_WNDPROC, (LONG_PTR)WndProc);
           WndProcInstalled = true;
         }
@@ -153,7 +153,7 @@ void AspectRatioConstraintHandler_Update(auto original, void* _this)
 
 intptr_t AspectRatioConstraintHandler_WndProc(auto original, HWND hWnd, uint32_t msg, intptr_t wParam, intptr_t lParam)
 {
-  if (Config::Get().free_resize) {
+  if (Config::Get()->free_resize) {
     return CallWindowProcA(AspectRatioConstraintHandler::_unityWndProc(), hWnd, msg, wParam, lParam);
   }
   return original(hWnd, msg, wParam, lParam);
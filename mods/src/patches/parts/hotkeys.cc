@@ -1,6 +1,7 @@
 #include "config.h"
+#include "logging.h"
 
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 // Object Viewers
 #include "prime/AllianceStarbaseObjectViewerWidget.h"
@@ -30,11 +31,16 @@
 #include "prime/ScanEngageButtonsWidget.h"
 #include "prime/ScreenManager.h"
 
+#include "patches/coroutines.h"
 #include "patches/key.h"
 #include "patches/mapkey.h"
+#include "patches/sync_capture.h"
+#include "patches/trace_recorder.h"
+#include "patches/ui_state.h"
 
 #include <EASTL/vector.h>
 
+#include <functional>
 #include <iostream>
 #include <span>
 
@@ -56,6 +62,8 @@ void     GotoSection(SectionID sectionID, void* screen_data = nullptr);
 bool     CanHideViewers();
 bool     DidHideViewers();
 
+extern void (*frame_hotkeys)(const std::function<void(ScreenManager*)>& original, ScreenManager* _this);
+
 bool MoveOfficerCanvas(bool goLeft)
 {
   // ScreenManager/CanvasRoot/MainFrame/ShipManagement_Canvas/Content/Pagination/
@@ -75,32 +83,36 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
   static std::chrono::time_point<std::chrono::steady_clock> select_clock = std::chrono::steady_clock::now();
 
   Key::ResetCache();
+  MapKey::Update();
+  UiState::Verify();
 
   if (MapKey::IsDown(GameFunction::DisableHotKeys)) {
-    Config::Get().hotkeys_enabled = false;
+    Config::Update([](Config& config) { config.hotkeys_enabled = false; });
     spdlog::warn("Setting hotkeys to DISABLED");
     return;
   } else if (MapKey::IsDown(GameFunction::EnableHotKeys)) {
-    Config::Get().hotkeys_enabled = true;
+    Config::Update([](Config& config) { config.hotkeys_enabled = true; });
     spdlog::warn("Setting hotkeys to ENABLED");
     return;
   }
 
-  if (Config::Get().use_scopely_hotkeys && Config::Get().hotkeys_enabled) {
+  if (Config::Get()->use_scopely_hotkeys && Config::Get()->hotkeys_enabled) {
     return original(_this);
   }
 
-  if (!Config::Get().hotkeys_enabled) {
+  if (!Config::Get()->hotkeys_enabled) {
     return;
   }
 
   static auto GetDeltaTime = il2cpp_resolve_icall_typed<float()>("UnityEngine.Time::get_deltaTime()");
 
-  const auto is_in_chat = Hub::IsInChat();
-  const auto config     = &Config::Get();
+  const auto is_in_chat = UiState::IsInChat();
+  const auto config     = Config::Get();
 
 #ifdef _WIN32
   if (MapKey::IsDown(GameFunction::Quit)) {
+    SyncCapture::Shutdown();
+    Logging::Shutdown();
     TerminateProcess(GetCurrentProcess(), 1);
   }
 #endif
@@ -124,7 +136,7 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
     ship_select_request = 7;
   }
 
-  if (ship_select_request != -1 && !Key::IsInputFocused()) {
+  if (ship_select_request != -1 && !UiState::IsInputFocused()) {
 
     if (Key::HasShift()) {
       FleetPlayerData* foundDisco = nullptr;
@@ -137,14 +149,23 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
       }
 
       if (foundDisco) {
-        auto towedFleetId = FleetsManager::Instance()->GetFleetPlayerData(ship_select_request)->Id;
+        // A new tow replaces one whose course is still being planned
+        static Coroutines::Id plan_course = 0;
+        Coroutines::Cancel(plan_course);
+
+        auto towedFleetId  = FleetsManager::Instance()->GetFleetPlayerData(ship_select_request)->Id;
+        auto towingFleetId = foundDisco->Id;
         auto plannedCourse =
             DeploymentManger::Instance()->PlanCourse(FleetsManager::Instance()->GetFleetPlayerData(ship_select_request),
                                                      foundDisco->Address, Vector3::zero(), nullptr, nullptr, nullptr);
-        while (plannedCourse->MoveNext()) {
-          ;
-        }
-        DeploymentManger::Instance()->SetTowRequest(towedFleetId, foundDisco->Id);
+        plan_course = Coroutines::Start(
+            plannedCourse,
+            [towedFleetId, towingFleetId](Coroutines::Result result) {
+              if (result == Coroutines::Result::Completed) {
+                DeploymentManger::Instance()->SetTowRequest(towedFleetId, towingFleetId);
+              }
+            },
+            {.name = "plan course"});
       }
     } else {
       auto fleet_bar  = ObjectFinder<FleetBarViewController>::Get();
@@ -155,7 +176,7 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
             std::chrono::duration_cast<std::chrono::milliseconds>(select_now - select_clock);
         spdlog::debug("select_diff was {}ms", select_diff.count());
         if (can_locate && fleet_bar->IsIndexSelected(ship_select_request)
-            && select_diff < std::chrono::milliseconds((int)Config::Get().select_timer)) {
+            && select_diff < std::chrono::milliseconds((int)Config::Get()->select_timer)) {
           auto fleet = fleet_bar->_fleetPanelController->fleet;
           if (NavigationSectionManager::Instance() && NavigationSectionManager::Instance()->SNavigationManager) {
             NavigationSectionManager::Instance()->SNavigationManager->HideInteraction();
@@ -171,7 +192,7 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
     }
   }
 
-  if (Key::Pressed(KeyCode::Escape) && (Key::IsInputFocused() || Hub::IsInChat())) {
+  if (Key::Pressed(KeyCode::Escape) && (UiState::IsInputFocused() || UiState::IsInChat())) {
     // This fixes issues with detecting when an input is selected
     // As the game usually doesn't clear this when using Escape, only when
     // pressing the back button with the mouse...
@@ -179,7 +200,7 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
   }
 
   if (!is_in_chat) {
-    if (!Key::IsInputFocused()) {
+    if (!UiState::IsInputFocused()) {
       if (MapKey::IsDown(GameFunction::SelectCurrent)) {
         auto fleet_bar = ObjectFinder<FleetBarViewController>::Get();
         if (fleet_bar) {
@@ -195,7 +216,7 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
       }
 
       if ((MapKey::IsDown(GameFunction::ToggleQueue))) {
-        config->queue_enabled = !config->queue_enabled;
+        Config::Toggle(&Config::queue_enabled);
         return;
       }
 
@@ -289,51 +310,51 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
       } else if (MapKey::IsDown(GameFunction::ShowSettings)) {
         return GotoSection(SectionID::GameSettings);
       } else if (MapKey::IsPressed(GameFunction::UiScaleUp)) {
-        config->AdjustUiScale(true);
+        Config::AdjustUiScale(true);
       } else if (MapKey::IsPressed(GameFunction::UiScaleDown)) {
-        config->AdjustUiScale(false);
+        Config::AdjustUiScale(false);
       } else if (MapKey::IsPressed(GameFunction::UiViewerScaleUp)) {
-        config->AdjustUiViewerScale(true);
+        Config::AdjustUiViewerScale(true);
       } else if (MapKey::IsPressed(GameFunction::UiViewerScaleDown)) {
-        config->AdjustUiViewerScale(false);
+        Config::AdjustUiViewerScale(false);
       } else if (MapKey::IsDown(GameFunction::TogglePreviewLocate)) {
-        config->disable_preview_locate = !config->disable_preview_locate;
+        Config::Toggle(&Config::disable_preview_locate);
       } else if (MapKey::IsDown(GameFunction::TogglePreviewRecall)) {
-        config->disable_preview_recall = !config->disable_preview_recall;
+        Config::Toggle(&Config::disable_preview_recall);
       } else if (MapKey::IsDown(GameFunction::ToggleCargoDefault)) {
-        config->show_cargo_default = !config->show_cargo_default;
+        Config::Toggle(&Config::show_cargo_default);
       } else if (MapKey::IsDown(GameFunction::ToggleCargoPlayer)) {
-        config->show_player_cargo = !config->show_player_cargo;
+        Config::Toggle(&Config::show_player_cargo);
       } else if (MapKey::IsDown(GameFunction::ToggleCargoStation)) {
-        config->show_station_cargo = !config->show_station_cargo;
+        Config::Toggle(&Config::show_station_cargo);
       } else if (MapKey::IsDown(GameFunction::ToggleCargoHostile)) {
-        config->show_hostile_cargo = !config->show_hostile_cargo;
+        Config::Toggle(&Config::show_hostile_cargo);
       } else if (MapKey::IsDown(GameFunction::ToggleCargoArmada)) {
-        config->show_armada_cargo = !config->show_armada_cargo;
+        Config::Toggle(&Config::show_armada_cargo);
       } else if (MapKey::IsDown(GameFunction::LogLevelOff)) {
         // spdlog::log("Setting log level to OFF");
         spdlog::set_level(spdlog::level::off);
-        spdlog::flush_on(spdlog::level::off);
       } else if (MapKey::IsDown(GameFunction::LogLevelError)) {
         spdlog::set_level(spdlog::level::err);
-        spdlog::flush_on(spdlog::level::err);
         // spdlog::log("Setting log level to ERROR");
       } else if (MapKey::IsDown(GameFunction::LogLevelWarn)) {
         spdlog::set_level(spdlog::level::warn);
-        spdlog::flush_on(spdlog::level::warn);
         // spdlog::log("Setting log level to WARN");
       } else if (MapKey::IsDown(GameFunction::LogLevelInfo)) {
         spdlog::set_level(spdlog::level::info);
-        spdlog::flush_on(spdlog::level::info);
         // spdlog::log("Setting log level to INFO");
       } else if (MapKey::IsDown(GameFunction::LogLevelDebug)) {
         spdlog::set_level(spdlog::level::debug);
-        spdlog::flush_on(spdlog::level::debug);
         // spdlog::log("Setting log level to DEBUG");
       } else if (MapKey::IsDown(GameFunction::LogLevelTrace)) {
         spdlog::set_level(spdlog::level::trace);
-        spdlog::flush_on(spdlog::level::trace);
         // spdlog::log("Setting log level to TRACE");
+      } else if (MapKey::IsDown(GameFunction::ResetHookProfile)) {
+        HookProfiler::Reset();
+      } else if (MapKey::IsDown(GameFunction::DumpTrace)) {
+        TraceRecorder::Dump("hotkey");
+      } else if (MapKey::IsDown(GameFunction::ToggleLowSpec)) {
+        Config::Toggle(&Config::low_spec);
       } else if (MapKey::IsDown(GameFunction::ShowShips)) {
         auto fleet_bar        = ObjectFinder<FleetBarViewController>::Get();
         auto fleet_controller = fleet_bar->_fleetPanelController;
@@ -355,7 +376,7 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
     }
   }
 
-  if (!Key::IsInputFocused()) {
+  if (!UiState::IsInputFocused()) {
     // Lets try to remove the pre-scan because we hit escape and it's visible
     if (Key::Pressed(KeyCode::Escape) && DidHideViewers()) {
       return;
@@ -374,7 +395,7 @@ void ScreenManager_Update_Hook(auto original, ScreenManager* _this)
         || MapKey::IsDown(GameFunction::ActionRecall) || MapKey::IsDown(GameFunction::ActionRepair)
         || MapKey::IsDown(GameFunction::ActionQueue) || MapKey::IsDown(GameFunction::ActionQueueClear)
         || force_space_action_next_frame) {
-      if (Hub::IsInSystemOrGalaxyOrStarbase() && !Hub::IsInChat() && !Key::IsInputFocused()) {
+      if (UiState::IsInSystemOrGalaxyOrStarbase() && !UiState::IsInChat() && !UiState::IsInputFocused()) {
         auto fleet_bar = ObjectFinder<FleetBarViewController>::Get();
         if (fleet_bar) {
           bool was_forced = force_space_action_next_frame;
@@ -581,7 +602,7 @@ void ExecuteSpaceAction(FleetBarViewController* fleet_bar)
   auto has_queue         = MapKey::IsDown(GameFunction::ActionQueue);
   auto has_queue_clear   = MapKey::IsDown(GameFunction::ActionQueueClear);
   auto has_recall =
-      MapKey::IsDown(GameFunction::ActionRecall) && (!Config::Get().disable_preview_recall || !CanHideViewers());
+      MapKey::IsDown(GameFunction::ActionRecall) && (!Config::Get()->disable_preview_recall || !CanHideViewers());
 
   if (has_queue_clear) {
     action_queue->ClearQueue(fleet);
@@ -769,14 +790,14 @@ void ChatMessageListLocalViewController_AboutToShow_Hook(ChatMessageListLocalVie
 
 void InitializeActions_Hook(auto original, void* _this)
 {
-  if (Config::Get().use_scopely_hotkeys) {
+  if (Config::Get()->use_scopely_hotkeys) {
     return original(_this);
   }
 }
 
 bool CheckShowCargo(RewardsButtonWidget* widget)
 {
-  if (!Config::Get().show_cargo_default) {
+  if (!Config::Get()->show_cargo_default) {
     return false;
   }
 
@@ -787,16 +808,16 @@ bool CheckShowCargo(RewardsButtonWidget* widget)
   const auto target_fleet_deployed = widget->Context->TargetFleetDeployedData;
 
   if (!target_fleet_deployed) {
-    return Config::Get().show_station_cargo;
+    return Config::Get()->show_station_cargo;
   }
   auto fleet_type = target_fleet_deployed->FleetType;
   if (fleet_type == DeployedFleetType::Player) {
-    return Config::Get().show_player_cargo;
+    return Config::Get()->show_player_cargo;
   } else if (fleet_type == DeployedFleetType::Marauder) {
     if (auto hull = target_fleet_deployed->Hull; hull && hull->Type == HullType::ArmadaTarget) {
-      return Config::Get().show_armada_cargo;
+      return Config::Get()->show_armada_cargo;
     } else {
-      return Config::Get().show_hostile_cargo;
+      return Config::Get()->show_hostile_cargo;
     }
   }
 
@@ -842,17 +863,8 @@ void InstallHotkeyHooks()
     }
   }
 
-  auto screen_manager_helper = il2cpp_get_class_helper("Assembly-CSharp", "Digit.Client.UI", "ScreenManager");
-  if (!screen_manager_helper.isValidHelper()) {
-    ErrorMsg::MissingHelper("UI", "ScreenManager");
-  } else {
-    auto ptr_update = screen_manager_helper.GetMethod("Update");
-    if (ptr_update == nullptr) {
-      ErrorMsg::MissingMethod("ScreenManager", "Update");
-    } else {
-      SPUD_STATIC_DETOUR(ptr_update, ScreenManager_Update_Hook);
-    }
-  }
+  // ScreenManager.Update is detoured by InstallFrameHooks, which runs the hotkeys after the per-frame work
+  frame_hotkeys = ScreenManager_Update_Hook<const std::function<void(ScreenManager*)>&>;
 
   static auto rewards_button_widget =
       il2cpp_get_class_helper("Assembly-CSharp", "Digit.Prime.Combat", "RewardsButtonWidget");
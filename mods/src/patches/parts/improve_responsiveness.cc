@@ -1,17 +1,26 @@
 #include "config.h"
 #include "errormsg.h"
+#include "patches/low_spec.h"
 #include "prime/TransitionManager.h"
+#include "prime/Tween.h"
+#include "str_utils.h"
 
 #include <il2cpp/il2cpp_helper.h>
 
 #include <spdlog/spdlog.h>
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
 
 int64_t TransitionManager_Awake(auto original, TransitionManager* a1)
 {
-  spdlog::debug("Adjusting screen transitions to {}", Config::Get().transition_time);
+  spdlog::debug("Adjusting screen transitions to {}", Config::Get()->transition_time);
   auto r                         = original(a1);
-  a1->SBlurController->_blurTime = std::clamp(Config::Get().transition_time, 0.02f, 1.0f);
+  a1->SBlurController->_blurTime = std::clamp(Config::Get()->transition_time, 0.02f, 1.0f);
+  LowSpec::OnTransitionManager(a1);
   return r;
 }
 
@@ -20,6 +29,144 @@ int64_t TransitionManager_OnEnable(auto original, TransitionManager* a1)
   return 0;
 }
 
+// Time scale for animation_speed = 0, any UI animation is over within a frame or two
+static constexpr float FinishTimeScale = 1000.0f;
+
+static float animation_time_scale(const Config& config)
+{
+  return config.animation_speed > 0.0f ? config.animation_speed : FinishTimeScale;
+}
+
+static bool is_kept(const Config& config, std::string_view name)
+{
+  return std::ranges::find(config.animation_keep, name) != config.animation_keep.end();
+}
+
+static bool is_kept(const Config& config, Il2CppString* name)
+{
+  return name != nullptr && is_kept(config, to_string(name));
+}
+
+static bool is_kept(const Config& config, Tween* tween)
+{
+  if (auto target = tween->target; target && is_kept(config, target->klass->name)) {
+    return true;
+  }
+
+  if (auto id = tween->id; id && strcmp(id->klass->name, "String") == 0 && is_kept(config, (Il2CppString*)id)) {
+    return true;
+  }
+
+  return is_kept(config, tween->stringId);
+}
+
+// Every DOTween tween and sequence passes through here when it starts playing
+void TweenManager_AddActiveTween(auto original, Tween* t)
+{
+  original(t);
+
+  const auto config = Config::Get();
+  if (t == nullptr || config->animation_speed == 1.0f) [[likely]] {
+    return;
+  }
+
+  if (!config->animation_keep.empty() && is_kept(*config, t)) {
+    return;
+  }
+
+  t->timeScale = t->timeScale * animation_time_scale(*config);
+}
+
+// Animators whose speed was changed, by weak handle, so the speed can be put back to 1 once
+// animation_speed is 1 again or a kept state plays on them. Main thread only.
+static std::unordered_map<void*, Il2CppGCHandle> sped_up_animators;
+static size_t                                    sped_up_prune_at = 64;
+
+static bool is_same_animator(Il2CppGCHandle handle, void* animator)
+{
+  return il2cpp_gchandle_get_target(handle) == (Il2CppObject*)animator;
+}
+
+static void remember_animator(void* animator)
+{
+  if (const auto it = sped_up_animators.find(animator); it != sped_up_animators.end()) {
+    if (is_same_animator(it->second, animator)) {
+      return;
+    }
+
+    // The address belonged to an animator that has been collected since
+    il2cpp_gchandle_free(it->second);
+    sped_up_animators.erase(it);
+  }
+
+  if (sped_up_animators.size() >= sped_up_prune_at) {
+    std::erase_if(sped_up_animators, [](const auto& entry) {
+      if (il2cpp_gchandle_get_target(entry.second) != nullptr) {
+        return false;
+      }
+
+      il2cpp_gchandle_free(entry.second);
+      return true;
+    });
+    sped_up_prune_at = std::max<size_t>(64, sped_up_animators.size() * 2);
+  }
+
+  sped_up_animators.emplace(animator, il2cpp_gchandle_new_weakref((Il2CppObject*)animator, false));
+}
+
+// True when the speed of this animator was changed and it still needs putting back
+static bool forget_animator(void* animator)
+{
+  const auto it = sped_up_animators.find(animator);
+  if (it == sped_up_animators.end()) {
+    return false;
+  }
+
+  const auto same = is_same_animator(it->second, animator);
+  il2cpp_gchandle_free(it->second);
+  sped_up_animators.erase(it);
+  return same;
+}
+
+static void speed_up_animator(void* animator, Il2CppString* name)
+{
+  static auto set_speed =
+      il2cpp_resolve_icall_typed<void(void*, float)>("UnityEngine.Animator::set_speed(System.Single)");
+  static auto GetName =
+      il2cpp_resolve_icall_typed<Il2CppString*(void*)>("UnityEngine.Object::GetName(UnityEngine.Object)");
+
+  if (animator == nullptr || set_speed == nullptr) {
+    return;
+  }
+
+  const auto config = Config::Get();
+  const auto kept   = config->animation_speed == 1.0f
+                    || (!config->animation_keep.empty()
+                        && (is_kept(*config, name) || (GetName && is_kept(*config, GetName(animator)))));
+
+  if (kept) [[likely]] {
+    if (!sped_up_animators.empty() && forget_animator(animator)) {
+      set_speed(animator, 1.0f);
+    }
+    return;
+  }
+
+  set_speed(animator, animation_time_scale(*config));
+  remember_animator(animator);
+}
+
+void Animator_SetTrigger(auto original, void* _this, Il2CppString* name)
+{
+  speed_up_animator(_this, name);
+  return original(_this, name);
+}
+
+void Animator_Play(auto original, void* _this, Il2CppString* stateName, int layer, float normalizedTime)
+{
+  speed_up_animator(_this, stateName);
+  return original(_this, stateName, layer, normalizedTime);
+}
+
 void InstallImproveResponsivenessHooks()
 {
   auto transition_manager_helper =
@@ -34,4 +181,39 @@ void InstallImproveResponsivenessHooks()
       SPUD_STATIC_DETOUR(awake, TransitionManager_Awake);
     }
   }
+
+  auto tween_manager_helper = il2cpp_get_class_helper("DOTween", "DG.Tweening.Core", "TweenManager");
+  if (!tween_manager_helper.isValidHelper()) {
+    ErrorMsg::MissingHelper("Tweening.Core", "TweenManager");
+  } else {
+    auto add_active_tween = tween_manager_helper.GetMethod("AddActiveTween");
+    if (add_active_tween == nullptr) {
+      ErrorMsg::MissingMethod("TweenManager", "AddActiveTween");
+    } else {
+      SPUD_STATIC_DETOUR(add_active_tween, TweenManager_AddActiveTween);
+    }
+  }
+
+  auto animator_helper = il2cpp_get_class_helper("UnityEngine.AnimationModule", "UnityEngine", "Animator");
+  if (!animator_helper.isValidHelper()) {
+    ErrorMsg::MissingHelper("UnityEngine", "Animator");
+  } else {
+    auto set_trigger = animator_helper.GetMethodSpecial("SetTrigger", [](auto count, const Il2CppType** params) {
+      return count == 1 && params[0]->type == IL2CPP_TYPE_STRING;
+    });
+    if (set_trigger == nullptr) {
+      ErrorMsg::MissingMethod("Animator", "SetTrigger");
+    } else {
+      SPUD_STATIC_DETOUR(set_trigger, Animator_SetTrigger);
+    }
+
+    auto play = animator_helper.GetMethodSpecial("Play", [](auto count, const Il2CppType** params) {
+      return count == 3 && params[0]->type == IL2CPP_TYPE_STRING;
+    });
+    if (play == nullptr) {
+      ErrorMsg::MissingMethod("Animator", "Play");
+    } else {
+      SPUD_STATIC_DETOUR(play, Animator_Play);
+    }
+  }
 }
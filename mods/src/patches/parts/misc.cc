@@ -10,7 +10,7 @@
 
 #include <il2cpp/il2cpp_helper.h>
 
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 #if _WIN32
 #include <Windows.h>
@@ -22,8 +22,8 @@
 
 int64_t InventoryForPopup_set_MaxItemsToUse(auto original, InventoryForPopup* a1, int64_t a2)
 {
-  if (a1->IsDonationUse && a2 == 50 && Config::Get().extend_donation_slider) {
-    const auto max = Config::Get().extend_donation_max;
+  if (a1->IsDonationUse && a2 == 50 && Config::Get()->extend_donation_slider) {
+    const auto max = Config::Get()->extend_donation_max;
     if (max > 0) {
       a2 = max;
     } else {
@@ -109,11 +109,11 @@ ResolutionArray* GetResolutions_Hook(auto original)
 
   std::vector<Resolution> res;
   for (int i = 0; i < resolutions->maxlength; ++i) {
-    if (Config::Get().show_all_resolutions)
+    if (Config::Get()->show_all_resolutions)
       resolutions->data[i].m_RefreshRate = targetRefreshRate;
 
     auto ores = resolutions->data[i];
-    if (Config::Get().show_all_resolutions || (ores.m_RefreshRate == targetRefreshRate || targetRefreshRate == 0)) {
+    if (Config::Get()->show_all_resolutions || (ores.m_RefreshRate == targetRefreshRate || targetRefreshRate == 0)) {
       res.push_back(ores);
     }
   }
@@ -157,7 +157,7 @@ IList* ExtractBuffsOfType_Hook(auto original, ClientModifierType modifier, IList
 bool ShouldShowRevealHook(auto original, void* _this, bool ignore)
 {
   auto result = original(_this, ignore);
-  if (Config::Get().always_skip_reveal_sequence) {
+  if (Config::Get()->always_skip_reveal_sequence) {
     return false;
   }
   return result;
@@ -178,8 +178,8 @@ private:
 public:
   int __get__flagValue()
   {
-    static auto field = get_class_helper().GetProperty("Value");
-    return *field.GetUnboxedSelf<int>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<int32_t>("Value");
+    return field.GetUnboxedSelf(this);
   }
 };
 
@@ -199,8 +199,8 @@ private:
 public:
   int __get__flagValue()
   {
-    static auto field = get_class_helper().GetProperty("Value");
-    return *field.GetUnboxedSelf<int>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<int32_t>("Value");
+    return field.GetUnboxedSelf(this);
   }
 };
 
@@ -245,8 +245,8 @@ private:
 public:
   BundleGroupConfig* __get__bundleConfig()
   {
-    static auto field = get_class_helper().GetProperty("BundleGroup");
-    return field.GetRaw<BundleGroupConfig>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<BundleGroupConfig*>("BundleGroup");
+    return field.Get(this);
   }
 };
 
@@ -254,7 +254,7 @@ bool isFirstInterstitial = true;
 
 void InterstitialViewController_AboutToShow(auto original, InterstitialViewController* _this)
 {
-  if (Config::Get().disable_first_popup && isFirstInterstitial && _this != nullptr) {
+  if (Config::Get()->disable_first_popup && isFirstInterstitial && _this != nullptr) {
     isFirstInterstitial = false;
     _this->CloseWhenReady();
   } else {
@@ -18,51 +18,8 @@
 #include <EASTL/unordered_set.h>
 #include <EASTL/vector.h>
 #include <spdlog/spdlog.h>
-#include <spud/detour.h>
-#include <spud/signature.h>
-
-#include <mutex>
-
-std::mutex                                                   tracked_objects_mutex;
-eastl::unordered_map<Il2CppClass*, eastl::vector<uintptr_t>> tracked_objects;
-
-void add_to_tracking_recursive(Il2CppClass* klass, void* _this)
-{
-  if (!klass) {
-    return;
-  }
-
-  auto& tracked_object_vector = tracked_objects[klass];
-  tracked_object_vector.emplace_back(uintptr_t(_this));
-
-  return add_to_tracking_recursive(klass->parent, _this);
-}
-
-void remove_from_tracking_all(void* _this)
-{
-#define GET_CLASS(obj) ((Il2CppClass*)(((size_t)obj) & ~(size_t)1))
-  for (auto& [klass, tracked_object_vector] : tracked_objects) {
-    tracked_object_vector.erase_first(uintptr_t(_this));
-  }
-#undef GET_CLASS
-}
-
-void remove_from_tracking_recursive(Il2CppClass* klass, void* _this)
-{
-#define GET_CLASS(obj) ((Il2CppClass*)(((size_t)obj) & ~(size_t)1))
-  if (!GET_CLASS(klass)) {
-    return;
-  }
-
-  if (tracked_objects.find(klass) == tracked_objects.end()) {
-    return;
-  }
-
-  auto& tracked_object_vector = tracked_objects[GET_CLASS(klass->parent)];
-  tracked_object_vector.erase_first(uintptr_t(_this));
-  return remove_from_tracking_recursive(GET_CLASS(klass->parent), _this);
-#undef GET_CLASS
-}
+#include "patches/hook_profiler.h"
+#include "patches/trace_recorder.h"
 
 void (*GC_register_finalizer_inner)(unsigned __int64 obj, void (*fn)(void*, void*), void* cd,
                                     void (**ofn)(void*, void*), void** ocd) = nullptr;
@@ -71,7 +28,8 @@ void track_finalizer(void* _this, void*)
 {
 #define GET_CLASS(obj) ((Il2CppClass*)(((size_t)obj) & ~(size_t)1))
   spdlog::trace("Clearing {}({})", (void*)_this, GET_CLASS(((Il2CppObject*)_this)->klass)->name);
-  remove_from_tracking_all(_this);
+  tracked_objects.Remove(uintptr_t(_this));
+  TraceRecorder::Instant("finalizer", "gc", 1);
 #undef GET_CLASS
 }
 
@@ -82,15 +40,20 @@ void* track_ctor(auto original, void* _this)
     return _this;
   }
 
-  std::scoped_lock lk{tracked_objects_mutex};
-  auto             cls = (Il2CppObject*)_this;
+  auto cls = (Il2CppObject*)_this;
+  if (!tracked_objects.Add(cls->klass, uintptr_t(_this))) {
+    // A base class constructor of a tracked class that is hooked as well
+    return obj;
+  }
+
   spdlog::trace("Tracking {}({})", _this, cls->klass->name);
   typedef void      (*FinalizerCallback)(void* object, void* client_data);
   FinalizerCallback oldCallback = nullptr;
   void*             oldData     = nullptr;
-  GC_register_finalizer_inner((intptr_t)_this, track_finalizer, nullptr, &oldCallback, &oldData);
+  if (GC_register_finalizer_inner) {
+    GC_register_finalizer_inner((intptr_t)_this, track_finalizer, nullptr, &oldCallback, &oldData);
+  }
   assert(!oldCallback);
-  add_to_tracking_recursive(cls->klass, _this);
   return obj;
 }
 
@@ -98,9 +61,8 @@ void track_destroy(auto original, Il2CppObject* _this, uint64_t a2, uint64_t a3)
 {
 #define GET_CLASS(obj) ((Il2CppClass*)(((size_t)obj) & ~(size_t)1))
   if (_this != nullptr) {
-    std::scoped_lock lk{tracked_objects_mutex};
     spdlog::trace("Clearing {}({})", (void*)_this, GET_CLASS(_this->klass)->name);
-    remove_from_tracking_all(_this);
+    tracked_objects.Remove(uintptr_t(_this));
   }
   return original(_this, a2, a3);
 #undef GET_CLASS
@@ -110,9 +72,7 @@ void track_free(auto original, void* _this)
 {
 #define GET_CLASS(obj) ((Il2CppClass*)(((size_t)obj) & ~(size_t)1))
   if (_this != nullptr) {
-    std::scoped_lock lk{tracked_objects_mutex};
-    auto             cls = (Il2CppObject*)_this;
-    remove_from_tracking_all(_this);
+    tracked_objects.Remove(uintptr_t(_this));
     return original(_this);
   }
 #undef GET_CLASS
@@ -122,29 +82,22 @@ void calc_liveness_hook(auto original, void* state)
 {
   original(state);
 
-  std::scoped_lock                                    lk{tracked_objects_mutex};
-  eastl::vector<eastl::pair<Il2CppClass*, uintptr_t>> objects_to_free;
-  eastl::unordered_set<uintptr_t>                     objects_seen;
+  TraceRecorder::Scope trace("release tracked objects", "gc");
+
 #define IS_MARKED(obj) (((size_t)(obj)->klass) & (size_t)1)
-  for (auto& [klass, objects] : tracked_objects) {
-    for (auto object : objects) {
-      if (IS_MARKED((Il2CppObject*)object) && objects_seen.find(object) == objects_seen.end()) {
-        objects_to_free.emplace_back(klass, object);
-        objects_seen.emplace(object);
-      }
+#define GET_CLASS(obj) ((Il2CppClass*)(((size_t)obj) & ~(size_t)1))
+  const auto released = tracked_objects.RemoveIf([](uintptr_t object) {
+    if (!IS_MARKED((Il2CppObject*)object)) {
+      return false;
     }
-  }
 
-#undef IS_MARKED
+    spdlog::trace("Clearing {}({})", (void*)object, GET_CLASS(((Il2CppObject*)object)->klass)->name);
+    return true;
+  });
 
-#define GET_CLASS(obj) ((Il2CppClass*)(((size_t)obj) & ~(size_t)1))
-  for (auto& [klass, object] : objects_to_free) {
-    spdlog::trace("Clearing {}({})", (void*)object, GET_CLASS(klass)->name);
-    remove_from_tracking_all((void*)object);
-  }
+  TraceRecorder::Instant("liveness", "gc", (int64_t)released);
 #undef GET_CLASS
-
-  tracked_objects = tracked_objects;
+#undef IS_MARKED
 }
 
 static eastl::unordered_set<void*> seen_ctor;
@@ -185,18 +138,21 @@ void InstallObjectTrackers()
   SPUD_STATIC_DETOUR(il2cpp_unity_liveness_finalize, calc_liveness_hook);
 
 #if _WIN32
-  auto GC_register_finalizer_inner_matches =
-      spud::find_in_module("40 56 57 41 57 48 83 EC ? 83 3D", "GameAssembly.dll");
+  auto GC_register_finalizer_inner_address =
+      Il2CppSymbolCache::FindInModule("40 56 57 41 57 48 83 EC ? 83 3D", "GameAssembly.dll");
 #else
 #if SPUD_ARCH_ARM64
-  auto GC_register_finalizer_inner_matches = spud::find_in_module(
+  auto GC_register_finalizer_inner_address = Il2CppSymbolCache::FindInModule(
     "FF 83 02 D1 FC 6F 04 A9 FA 67 05 A9 F8 5F 06 A9 F6 57 07 A9 F4 4F 08 A9 FD 7B 09 A9 FD 43 02 91 E4 0F 03 A9", "GameAssembly.dylib");
 #else
-  auto GC_register_finalizer_inner_matches = spud::find_in_module(
+  auto GC_register_finalizer_inner_address = Il2CppSymbolCache::FindInModule(
       "55 48 89 E5 41 57 41 56 41 55 41 54 53 48 83 EC ? 4C 89 45 ? 48 89 4D ? 83 3D", "GameAssembly.dylib");
 #endif
 #endif
 
-  const auto GC_register_finalizer_inner_match = GC_register_finalizer_inner_matches.get(0);
-  GC_register_finalizer_inner = (decltype(GC_register_finalizer_inner))GC_register_finalizer_inner_match.address();
+  if (!GC_register_finalizer_inner_address) {
+    spdlog::error("Unable to find GC_register_finalizer_inner, tracked objects will not be released");
+  }
+
+  GC_register_finalizer_inner = (decltype(GC_register_finalizer_inner))GC_register_finalizer_inner_address;
 }
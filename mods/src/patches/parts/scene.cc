@@ -0,0 +1,35 @@
+#include "errormsg.h"
+
+#include <patches/memory_manager.h>
+#include <patches/ui_state.h>
+#include <prime/MonoSingleton.h>
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include "patches/hook_profiler.h"
+
+#include <cstdint>
+
+// Scene is a struct wrapping its handle, LoadSceneMode an enum
+void SceneManager_Internal_SceneLoaded(auto original, int32_t scene, int32_t mode)
+{
+  MonoSingletonCache::Invalidate();
+  UiState::Invalidate();
+  MemoryManager::OnSafePoint(MemoryManager::Reason::SceneLoaded);
+  return original(scene, mode);
+}
+
+void InstallSceneHooks()
+{
+  auto scene_manager = il2cpp_get_class_helper("UnityEngine.CoreModule", "UnityEngine.SceneManagement", "SceneManager");
+  if (!scene_manager.isValidHelper()) {
+    ErrorMsg::MissingHelper("UnityEngine.SceneManagement", "SceneManager");
+  } else {
+    auto ptr = scene_manager.GetMethod("Internal_SceneLoaded");
+    if (!ptr) {
+      ErrorMsg::MissingStaticMethod("SceneManager", "Internal_SceneLoaded");
+    } else {
+      SPUD_STATIC_DETOUR(ptr, SceneManager_Internal_SceneLoaded);
+    }
+  }
+}
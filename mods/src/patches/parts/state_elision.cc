@@ -0,0 +1,141 @@
+#include "errormsg.h"
+
+#include "patches/state_elision.h"
+#include "prime/Vector3.h"
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include "patches/hook_profiler.h"
+
+using Filter = StateElision::Filter;
+
+static bool same_vector(const Vector3* a, const Vector3* b)
+{
+  return a->x == b->x && a->y == b->y && a->z == b->z;
+}
+
+void GameObject_SetActive(auto original, void* _this, bool active)
+{
+  static auto get_activeSelf = il2cpp_resolve_icall_typed<bool(void*)>("UnityEngine.GameObject::get_activeSelf()");
+
+  if (StateElision::Enabled(Filter::SetActive) && get_activeSelf(_this) == active) {
+    return StateElision::Skipped(Filter::SetActive);
+  }
+
+  return original(_this, active);
+}
+
+void Transform_set_position(auto original, void* _this, Vector3* value)
+{
+  static auto get_position = il2cpp_resolve_icall_typed<void(void*, Vector3*)>(
+      "UnityEngine.Transform::get_position_Injected(UnityEngine.Vector3&)");
+
+  if (StateElision::Enabled(Filter::Transform)) {
+    Vector3 current;
+    get_position(_this, &current);
+    if (same_vector(&current, value)) {
+      return StateElision::Skipped(Filter::Transform);
+    }
+  }
+
+  return original(_this, value);
+}
+
+void Transform_set_localPosition(auto original, void* _this, Vector3* value)
+{
+  static auto get_localPosition = il2cpp_resolve_icall_typed<void(void*, Vector3*)>(
+      "UnityEngine.Transform::get_localPosition_Injected(UnityEngine.Vector3&)");
+
+  if (StateElision::Enabled(Filter::Transform)) {
+    Vector3 current;
+    get_localPosition(_this, &current);
+    if (same_vector(&current, value)) {
+      return StateElision::Skipped(Filter::Transform);
+    }
+  }
+
+  return original(_this, value);
+}
+
+void Transform_set_localScale(auto original, void* _this, Vector3* value)
+{
+  static auto get_localScale = il2cpp_resolve_icall_typed<void(void*, Vector3*)>(
+      "UnityEngine.Transform::get_localScale_Injected(UnityEngine.Vector3&)");
+
+  if (StateElision::Enabled(Filter::Transform)) {
+    Vector3 current;
+    get_localScale(_this, &current);
+    if (same_vector(&current, value)) {
+      return StateElision::Skipped(Filter::Transform);
+    }
+  }
+
+  return original(_this, value);
+}
+
+void Transform_SetParent(auto original, void* _this, void* parent, bool worldPositionStays)
+{
+  static auto GetParent = il2cpp_resolve_icall_typed<void*(void*)>("UnityEngine.Transform::GetParent()");
+
+  if (StateElision::Enabled(Filter::Transform) && GetParent(_this) == parent) {
+    return StateElision::Skipped(Filter::Transform);
+  }
+
+  return original(_this, parent, worldPositionStays);
+}
+
+void CanvasGroup_set_alpha(auto original, void* _this, float value)
+{
+  static auto get_alpha = il2cpp_resolve_icall_typed<float(void*)>("UnityEngine.CanvasGroup::get_alpha()");
+
+  if (StateElision::Enabled(Filter::CanvasAlpha) && get_alpha(_this) == value) {
+    return StateElision::Skipped(Filter::CanvasAlpha);
+  }
+
+  return original(_this, value);
+}
+
+// The setter to detour, or nullptr when it or the getter it compares against is missing
+static void* resolve_setter(const char* setter, const char* getter)
+{
+  auto ptr = (void*)il2cpp_resolve_icall(setter);
+  if (ptr == nullptr || il2cpp_resolve_icall(getter) == nullptr) {
+    spdlog::error("Unable to find icall '{}'", ptr == nullptr ? setter : getter);
+    return nullptr;
+  }
+
+  return ptr;
+}
+
+void InstallStateElisionHooks()
+{
+  if (auto ptr = resolve_setter("UnityEngine.GameObject::SetActive(System.Boolean)",
+                                "UnityEngine.GameObject::get_activeSelf()")) {
+    SPUD_STATIC_DETOUR(ptr, GameObject_SetActive);
+  }
+
+  if (auto ptr = resolve_setter("UnityEngine.Transform::set_position_Injected(UnityEngine.Vector3&)",
+                                "UnityEngine.Transform::get_position_Injected(UnityEngine.Vector3&)")) {
+    SPUD_STATIC_DETOUR(ptr, Transform_set_position);
+  }
+
+  if (auto ptr = resolve_setter("UnityEngine.Transform::set_localPosition_Injected(UnityEngine.Vector3&)",
+                                "UnityEngine.Transform::get_localPosition_Injected(UnityEngine.Vector3&)")) {
+    SPUD_STATIC_DETOUR(ptr, Transform_set_localPosition);
+  }
+
+  if (auto ptr = resolve_setter("UnityEngine.Transform::set_localScale_Injected(UnityEngine.Vector3&)",
+                                "UnityEngine.Transform::get_localScale_Injected(UnityEngine.Vector3&)")) {
+    SPUD_STATIC_DETOUR(ptr, Transform_set_localScale);
+  }
+
+  if (auto ptr = resolve_setter("UnityEngine.Transform::SetParent(UnityEngine.Transform,System.Boolean)",
+                                "UnityEngine.Transform::GetParent()")) {
+    SPUD_STATIC_DETOUR(ptr, Transform_SetParent);
+  }
+
+  if (auto ptr = resolve_setter("UnityEngine.CanvasGroup::set_alpha(System.Single)",
+                                "UnityEngine.CanvasGroup::get_alpha()")) {
+    SPUD_STATIC_DETOUR(ptr, CanvasGroup_set_alpha);
+  }
+}
@@ -1,6 +1,10 @@
 #include "config.h"
 #include "errormsg.h"
 #include "file.h"
+#include "patches/sync_capture.h"
+#include "patches/sync_metrics.h"
+#include "patches/sync_replay.h"
+#include "patches/trace_recorder.h"
 #include "str_utils.h"
 
 #include <il2cpp-api-types.h>
@@ -10,7 +14,7 @@
 #include <prime/HttpResponse.h>
 #include <prime/ServiceResponse.h>
 #include <prime/RealtimeDataPayload.h>
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 #include <spdlog/spdlog.h>
 #if !__cpp_lib_format
@@ -170,39 +174,60 @@ private:
   std::string m_url;
 };
 
-static void sync_log_error(const std::string& type, const std::string& target, const std::string& text)
+// The message is only formatted once the level and the sync logging switches pass, so a call below
+// the active level costs the checks and nothing else
+template <typename... Args>
+static void sync_log(spdlog::level::level_enum level, std::string_view type, std::string_view target,
+                     spdlog::format_string_t<Args...> format, Args&&... args)
 {
-  if (Config::Get().sync_logging) {
-    spdlog::error("SYNC-{} - {}: {}", type, target, text);
+  if (!spdlog::should_log(level)) {
+    return;
   }
+
+  const auto config = Config::Get();
+  if (!config->sync_logging || (level <= spdlog::level::debug && !config->sync_debug)) {
+    return;
+  }
+
+  spdlog::memory_buf_t message;
+  spdlog::fmt_lib::format_to(std::back_inserter(message), "SYNC-{} - {}: ", type, target);
+  spdlog::fmt_lib::format_to(std::back_inserter(message), format, std::forward<Args>(args)...);
+  spdlog::log(level, std::string_view(message.data(), message.size()));
 }
 
-static void sync_log_warn(const std::string& type, const std::string& target, const std::string& text)
+template <typename... Args>
+static void sync_log_error(std::string_view type, std::string_view target, spdlog::format_string_t<Args...> format,
+                           Args&&... args)
 {
-  if (Config::Get().sync_logging) {
-    spdlog::warn("SYNC-{} - {}: {}", type, target, text);
-  }
+  sync_log(spdlog::level::err, type, target, format, std::forward<Args>(args)...);
 }
 
-static void sync_log_info(const std::string& type, const std::string& target, const std::string& text)
+template <typename... Args>
+static void sync_log_warn(std::string_view type, std::string_view target, spdlog::format_string_t<Args...> format,
+                          Args&&... args)
 {
-  if (Config::Get().sync_logging) {
-    spdlog::info("SYNC-{} - {}: {}", type, target, text);
-  }
+  sync_log(spdlog::level::warn, type, target, format, std::forward<Args>(args)...);
 }
 
-static void sync_log_debug(const std::string& type, const std::string& target, const std::string& text)
+template <typename... Args>
+static void sync_log_info(std::string_view type, std::string_view target, spdlog::format_string_t<Args...> format,
+                          Args&&... args)
 {
-  if (Config::Get().sync_logging && Config::Get().sync_debug) {
-    spdlog::debug("SYNC-{} - {}: {}", type, target, text);
-  }
+  sync_log(spdlog::level::info, type, target, format, std::forward<Args>(args)...);
 }
 
-static void sync_log_trace(const std::string& type, const std::string& target, const std::string& text)
+template <typename... Args>
+static void sync_log_debug(std::string_view type, std::string_view target, spdlog::format_string_t<Args...> format,
+                           Args&&... args)
 {
-  if (Config::Get().sync_logging && Config::Get().sync_debug) {
-    spdlog::trace("SYNC-{} - {}: {}", type, target, text);
-  }
+  sync_log(spdlog::level::debug, type, target, format, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+static void sync_log_trace(std::string_view type, std::string_view target, spdlog::format_string_t<Args...> format,
+                           Args&&... args)
+{
+  sync_log(spdlog::level::trace, type, target, format, std::forward<Args>(args)...);
 }
 
 static const std::string CURL_TYPE_UPLOAD   = "UPLOAD";
@@ -216,6 +241,8 @@ struct TargetWorker {
 
   using request_t = std::tuple<std::string, std::string, bool>;
 
+  std::string                   name;
+  SyncTargetConfig              config;
   std::shared_ptr<cpr::Session> session;
   std::thread                   worker_thread;
   std::atomic_bool              stop_requested{false};
@@ -233,7 +260,10 @@ static void target_worker_thread(std::shared_ptr<TargetWorker> worker)
   WinRtApartmentGuard apartmentGuard;
 #endif
 
-  while (!worker->stop_requested.load(std::memory_order_acquire)) {
+  TraceRecorder::NameThread("sync " + worker->name);
+
+  // A retired worker keeps going until its queue is empty
+  for (;;) {
     std::string identifier;
     std::string post_data;
     bool is_first_sync = false;
@@ -255,6 +285,8 @@ static void target_worker_thread(std::shared_ptr<TargetWorker> worker)
         post_data = std::move(std::get<1>(item));
         is_first_sync = std::get<2>(item);
       }
+
+      SyncMetrics::SetQueueDepth(worker->name, worker->request_queue.size());
     }
 
     if (post_data.empty()) {
@@ -275,33 +307,92 @@ static void target_worker_thread(std::shared_ptr<TargetWorker> worker)
 
       httpClient->SetBody(cpr::Body{post_data});
 
-      sync_log_debug(CURL_TYPE_UPLOAD, identifier, "Sending data to " + httpClient->GetFullRequestUrl());
+      sync_log_debug(CURL_TYPE_UPLOAD, identifier, "Sending data to {}", httpClient->GetFullRequestUrl());
 
       // Synchronously wait for response
-      const auto response = httpClient->Post();
+      const auto response = [&httpClient] {
+        TraceRecorder::Scope trace("http send", "sync");
+        return httpClient->Post();
+      }();
+
+      TraceRecorder::Scope trace("http response", "sync");
+
+      SyncMetrics::CountBytes(worker->name, post_data.size(), static_cast<size_t>(response.uploaded_bytes));
+      SyncMetrics::CountResponse(worker->name, response.status_code, response.elapsed);
 
       if (response.status_code == 0) {
-        sync_log_error(CURL_TYPE_UPLOAD, identifier, "Failed to send request: " + response.error.message);
+        sync_log_error(CURL_TYPE_UPLOAD, identifier, "Failed to send request: {}", response.error.message);
+        SyncMetrics::CountDrop(worker->name, "transport");
       } else if (response.status_code >= 400) {
-        sync_log_error(CURL_TYPE_UPLOAD, identifier, STR_FORMAT("Failed to communicate with server: {} (after {:.1f}s)", response.status_line, response.elapsed));
+        sync_log_error(CURL_TYPE_UPLOAD, identifier, "Failed to communicate with server: {} (after {:.1f}s)", response.status_line, response.elapsed);
+        SyncMetrics::CountDrop(worker->name, "status");
       } else {
-        sync_log_debug(CURL_TYPE_UPLOAD, identifier, STR_FORMAT("Response: {} ({:.1f}s elapsed)", response.status_line, response.elapsed));
+        sync_log_debug(CURL_TYPE_UPLOAD, identifier, "Response: {} ({:.1f}s elapsed)", response.status_line, response.elapsed);
       }
     } catch (const std::runtime_error& e) {
       ErrorMsg::SyncRuntime(identifier.c_str(), e);
+      SyncMetrics::CountDrop(worker->name, "exception");
     } catch (const std::exception& e) {
       ErrorMsg::SyncException(identifier.c_str(), e);
+      SyncMetrics::CountDrop(worker->name, "exception");
 #if _WIN32
     } catch (winrt::hresult_error const& ex) {
       ErrorMsg::SyncWinRT(identifier.c_str(), ex);
+      SyncMetrics::CountDrop(worker->name, "exception");
 #endif
     } catch (...) {
       ErrorMsg::SyncMsg(identifier.c_str(), "Unknown error occurred");
+      SyncMetrics::CountDrop(worker->name, "exception");
     }
   }
 }
 
-static std::shared_ptr<TargetWorker> get_curl_client_sync(const std::string& target)
+static bool same_endpoint(const SyncTargetConfig& a, const SyncTargetConfig& b)
+{
+  return a.url == b.url && a.token == b.token && a.proxy == b.proxy && a.verify_ssl == b.verify_ssl;
+}
+
+// The worker finishes sending what is already queued, then exits
+static void retire_worker(const std::shared_ptr<TargetWorker>& worker)
+{
+  {
+    std::lock_guard lk(worker->queue_mtx);
+    worker->stop_requested.store(true, std::memory_order_release);
+  }
+  worker->queue_cv.notify_all();
+  worker->worker_thread.detach();
+}
+
+// After the settings were reloaded, drops the workers of targets that were removed or whose
+// endpoint changed, so the next request builds a fresh session for them
+static void refresh_target_workers(const Config& config)
+{
+  static uint64_t refreshed_generation = 0;
+
+  std::lock_guard lk(target_workers_mtx);
+
+  if (config.generation <= refreshed_generation) {
+    return;
+  }
+  refreshed_generation = config.generation;
+
+  std::erase_if(target_workers, [&config](auto& entry) {
+    auto& [target, worker] = entry;
+
+    if (const auto it = config.sync_targets.find(target);
+        it != config.sync_targets.end() && same_endpoint(it->second, worker->config)) {
+      std::lock_guard queue_lk(worker->queue_mtx);
+      worker->config = it->second;
+      return false;
+    }
+
+    spdlog::info("Sync target '{}' changed, restarting its worker", target);
+    retire_worker(worker);
+    return true;
+  });
+}
+
+static std::shared_ptr<TargetWorker> get_curl_client_sync(const std::string& target, const SyncTargetConfig& target_config)
 {
   std::lock_guard lk(target_workers_mtx);
 
@@ -314,8 +405,9 @@ static std::shared_ptr<TargetWorker> get_curl_client_sync(const std::string& tar
   auto worker = std::make_shared<TargetWorker>();
 
   // Initialize session
+  worker->name    = target;
+  worker->config  = target_config;
   worker->session = std::make_shared<cpr::Session>();
-  const auto& target_config = Config::Get().sync_targets[target];
 
   worker->session->SetUrl(target_config.url);
   worker->session->SetUserAgent("stfc community patch " VER_FILE_VERSION_STR " (libcurl/" LIBCURL_VERSION ")");
@@ -351,10 +443,55 @@ static std::shared_ptr<TargetWorker> get_curl_client_sync(const std::string& tar
   return worker;
 }
 
-static void send_data(SyncConfig::Type type, const std::string& post_data, bool is_first_sync)
+static bool filter_matches(const nlohmann::json& value, const std::unordered_set<int64_t>& ids,
+                           const std::unordered_set<std::string>& names)
+{
+  if (value.is_number_integer()) {
+    return ids.contains(value.get<int64_t>());
+  }
+
+  if (value.is_string()) {
+    return names.contains(value.get_ref<const std::string&>());
+  }
+
+  return false;
+}
+
+static std::string serialize_filtered(const SyncTargetConfig::Filter& filter, const nlohmann::json& records)
+{
+  const bool has_allow = filter.has_allow();
+  const bool has_deny  = filter.has_deny();
+
+  auto filtered = nlohmann::json::array();
+
+  for (const auto& record : records) {
+    if (has_allow || has_deny) {
+      if (const auto it = record.find(filter.key); it == record.end()) {
+        if (has_allow) {
+          continue;
+        }
+      } else if ((has_allow && !filter_matches(*it, filter.allow_ids, filter.allow_names))
+                 || (has_deny && filter_matches(*it, filter.deny_ids, filter.deny_names))) {
+        continue;
+      }
+    }
+
+    auto& projected = filtered.emplace_back(record);
+    for (const auto& field : filter.drop) {
+      projected.erase(field);
+    }
+  }
+
+  return filtered.empty() ? std::string() : filtered.dump();
+}
+
+static void send_data(SyncConfig::Type type, const nlohmann::json& records, bool is_first_sync)
 {
   static std::once_flag emit_warning;
-  const auto& targets = Config::Get().sync_targets;
+  const auto  config  = Config::Get();
+  const auto& targets = config->sync_targets;
+
+  refresh_target_workers(*config);
 
   std::call_once(emit_warning, [targets] {
     if (targets.empty()) {
@@ -362,30 +499,56 @@ static void send_data(SyncConfig::Type type, const std::string& post_data, bool
     }
   });
 
-  for (const auto& target : targets
-       | std::views::filter([type](const auto& t) { return t.second.enabled(type); })
-       | std::views::keys) {
+  // unfiltered targets share a single serialization of the records
+  std::string unfiltered_data;
+
+  for (const auto& [target, target_config] : targets
+       | std::views::filter([type](const auto& t) { return t.second.enabled(type); })) {
 
     const auto target_identifier = STR_FORMAT("{} ({})", target, to_string(type));
 
     try {
-      const auto worker = get_curl_client_sync(target);
+      std::string post_data;
+
+      if (const auto filter = target_config.filter(type); filter != nullptr) {
+        TraceRecorder::Scope trace("serialize", "sync", to_c_str(type));
+        post_data = serialize_filtered(*filter, records);
+
+        if (post_data.empty()) {
+          sync_log_trace(CURL_TYPE_UPLOAD, target_identifier, "All records removed by filter, nothing to send");
+          SyncMetrics::CountDrop(target, "filtered");
+          continue;
+        }
+      } else {
+        if (unfiltered_data.empty()) {
+          TraceRecorder::Scope trace("serialize", "sync", to_c_str(type));
+          unfiltered_data = records.dump();
+        }
+
+        post_data = unfiltered_data;
+      }
+
+      const auto worker = get_curl_client_sync(target, target_config);
 
       // Enqueue the request for this target's worker
       {
-        std::lock_guard lk(worker->queue_mtx);
-        worker->request_queue.emplace(target_identifier, post_data, is_first_sync);
-        sync_log_trace(CURL_TYPE_UPLOAD, target_identifier,
-                       STR_FORMAT("Queued request (queue size: {})", worker->request_queue.size()));
+        TraceRecorder::Scope trace("enqueue", "sync", to_c_str(type));
+        std::lock_guard      lk(worker->queue_mtx);
+        worker->request_queue.emplace(target_identifier, std::move(post_data), is_first_sync);
+        sync_log_trace(CURL_TYPE_UPLOAD, target_identifier, "Queued request (queue size: {})", worker->request_queue.size());
+        SyncMetrics::SetQueueDepth(target, worker->request_queue.size());
       }
       worker->queue_cv.notify_all();
 
     } catch (const std::runtime_error& e) {
       spdlog::error("Failed to send sync data to target '{}' - Runtime error: {}", target_identifier, e.what());
+      SyncMetrics::CountDrop(target, "exception");
     } catch (const std::exception& e) {
       spdlog::error("Failed to send sync data to target '{}' - Exception: {}", target_identifier, e.what());
+      SyncMetrics::CountDrop(target, "exception");
     } catch (...) {
       spdlog::error("Failed to send sync data to target '{}' - Unknown error occurred", target_identifier);
+      SyncMetrics::CountDrop(target, "exception");
     }
   }
 }
@@ -401,10 +564,10 @@ static std::shared_ptr<cpr::Session> get_curl_client_scopely()
     session->SetAcceptEncoding(cpr::AcceptEncoding{});
     session->SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_1_1});
 
-    if (!Config::Get().sync_options.proxy.empty()) {
-      session->SetProxies({{"https", Config::Get().sync_options.proxy}});
+    if (!Config::Get()->sync_options.proxy.empty()) {
+      session->SetProxies({{"https", Config::Get()->sync_options.proxy}});
 
-      if (!Config::Get().sync_options.verify_ssl) {
+      if (!Config::Get()->sync_options.verify_ssl) {
         session->SetSslOptions(
           cpr::Ssl(cpr::ssl::VerifyHost{false}, cpr::ssl::VerifyPeer{false}, cpr::ssl::NoRevoke{true})
         );
@@ -428,11 +591,25 @@ static std::shared_ptr<cpr::Session> get_curl_client_scopely()
   return session;
 }
 
+// Game server responses from a capture, keyed like the captured target, stand in for the game
+// server during a replay
+static std::unordered_map<std::string, std::string> replay_responses;
+
+static std::string scopely_capture_target(const std::string& path, const std::string& post_data)
+{
+  return path + '\n' + post_data;
+}
+
 static std::string get_scopely_data(const std::string& path, const std::string& post_data)
 {
   static std::once_flag emit_warning;
 
-  if (Config::Get().sync_targets.empty()) {
+  if (!replay_responses.empty()) {
+    const auto it = replay_responses.find(scopely_capture_target(path, post_data));
+    return it != replay_responses.end() ? it->second : std::string{};
+  }
+
+  if (Config::Get()->sync_targets.empty()) {
     std::call_once(emit_warning, [] {
       sync_log_warn(CURL_TYPE_UPLOAD, "GLOBAL", "No target found, will not attempt to retrieve data");
     });
@@ -461,12 +638,12 @@ static std::string get_scopely_data(const std::string& path, const std::string&
     const auto response = httpClient->Post();
 
     if (response.status_code == 0) {
-      sync_log_error(CURL_TYPE_DOWNLOAD, path, "Failed to send request: " + response.error.message);
+      sync_log_error(CURL_TYPE_DOWNLOAD, path, "Failed to send request: {}", response.error.message);
       return {};
     }
 
     if (response.status_code >= 400) {
-      sync_log_error(CURL_TYPE_DOWNLOAD, path, "Failed to communicate with server: " + response.status_line);
+      sync_log_error(CURL_TYPE_DOWNLOAD, path, "Failed to communicate with server: {}", response.status_line);
       return {};
     }
 
@@ -479,11 +656,15 @@ static std::string get_scopely_data(const std::string& path, const std::string&
       type = "unknown";
     }
 
-    sync_log_debug(CURL_TYPE_DOWNLOAD, path,
-                   STR_FORMAT("Response: {} ({}), {:.1f}s elapsed,", response.status_line, type, response.elapsed));
+    sync_log_debug(CURL_TYPE_DOWNLOAD, path, "Response: {} ({}), {:.1f}s elapsed,", response.status_line, type,
+                   response.elapsed);
     response_text = response.text;
   }
 
+  if (SyncCapture::Enabled()) {
+    SyncCapture::Write(SyncCapture::ScopelyType, scopely_capture_target(path, post_data), response_text);
+  }
+
   return response_text;
 }
 
@@ -539,9 +720,9 @@ template <> struct adl_serializer<SyncConfig::Type> {
 };
 NLOHMANN_JSON_NAMESPACE_END
 
-std::mutex                                                  sync_data_mtx;
-std::condition_variable                                     sync_data_cv;
-std::queue<std::tuple<SyncConfig::Type, std::string, bool>> sync_data_queue;
+std::mutex                                                     sync_data_mtx;
+std::condition_variable                                        sync_data_cv;
+std::queue<std::tuple<SyncConfig::Type, nlohmann::json, bool>> sync_data_queue;
 
 std::mutex              combat_log_data_mtx;
 std::condition_variable combat_log_data_cv;
@@ -565,23 +746,22 @@ struct CachedAllianceData {
 std::unordered_map<int64_t, CachedAllianceData> alliance_data_cache;
 std::mutex                                      alliance_data_cache_mtx;
 
-void queue_data(SyncConfig::Type type, const std::string& data, bool is_first_sync = false)
-{
-  {
-    std::lock_guard lk(sync_data_mtx);
-    sync_data_queue.emplace(type, data, is_first_sync);
-    http::sync_log_debug("QUEUE", to_string(type), "Added data to sync queue");
-  }
-
-  sync_data_cv.notify_all();
-}
+static SyncReplay::RecordSink record_sink;
 
 void queue_data(SyncConfig::Type type, const nlohmann::json& data, bool is_first_sync = false)
 {
+  if (record_sink) {
+    record_sink(type, data);
+    return;
+  }
+
   {
-    std::lock_guard lk(sync_data_mtx);
-    sync_data_queue.emplace(type, data.dump(), is_first_sync);
-    http::sync_log_debug("QUEUE", to_string(type), STR_FORMAT("Added {} entries to sync queue", data.size()));
+    TraceRecorder::Scope trace("queue records", "sync", to_c_str(type));
+    std::lock_guard      lk(sync_data_mtx);
+    sync_data_queue.emplace(type, data, is_first_sync);
+    http::sync_log_debug("QUEUE", to_c_str(type), "Added {} entries to sync queue", data.size());
+    SyncMetrics::CountRecords(type, data.size());
+    SyncMetrics::SetQueueDepth("global", sync_data_queue.size());
   }
 
   sync_data_cv.notify_all();
@@ -715,13 +895,14 @@ static void save_previously_sent_logs()
 void process_active_missions(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Missions);
   static std::unordered_set<int64_t> active_mission_states;
   static std::mutex                  active_mission_states_mtx;
 
   if (auto response = Digit::PrimeServer::Models::ActiveMissionsResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "active missions",
-                         STR_FORMAT("Processing {} active missions", response.activemissions_size()));
+    http::sync_log_trace("PROCESS", "active missions", "Processing {} active missions", response.activemissions_size());
 
     std::unordered_set<int64_t> active_missions;
     for (const auto& mission : response.activemissions()) {
@@ -737,6 +918,8 @@ void process_active_missions(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (changed && !active_mission_states.empty()) {
       auto mission_array = json::array();
 
@@ -754,13 +937,15 @@ void process_active_missions(std::unique_ptr<std::string>&& bytes)
 void process_completed_missions(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Missions);
   static std::vector<int64_t> completed_mission_states;
   static std::mutex           completed_mission_states_mtx;
 
   if (auto response = Digit::PrimeServer::Models::CompletedMissionsResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "completed missions",
-                         STR_FORMAT("Processing {} completed missions", response.completedmissions_size()));
+    http::sync_log_trace("PROCESS", "completed missions", "Processing {} completed missions",
+                         response.completedmissions_size());
 
     const auto&          missions = response.completedmissions();
     std::vector<int64_t> completed_missions{missions.begin(), missions.end()};
@@ -776,6 +961,8 @@ void process_completed_missions(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!diff.empty()) {
       auto mission_array = json::array();
 
@@ -797,11 +984,12 @@ void process_player_inventories(std::unique_ptr<std::string>&& bytes)
   static std::unordered_map<std::pair<item_t, int64_t>, int64_t, pairhash> inventory_states;
   static std::mutex                                                        inventory_states_mtx;
   static std::atomic_bool                                                  is_first_sync{true};
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Inventory);
 
   if (auto response = Digit::PrimeServer::Models::InventoryResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "player inventories",
-                         STR_FORMAT("Processing {} inventories", response.inventories_size()));
+    http::sync_log_trace("PROCESS", "player inventories", "Processing {} inventories", response.inventories_size());
 
     auto inventory_items = json::array();
     {
@@ -826,6 +1014,8 @@ void process_player_inventories(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!inventory_items.empty()) {
       const bool first_sync = is_first_sync.exchange(false, std::memory_order_acq_rel);
       queue_data(SyncConfig::Type::Inventory, inventory_items, first_sync);
@@ -838,13 +1028,15 @@ void process_player_inventories(std::unique_ptr<std::string>&& bytes)
 void process_research_trees_state(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Research);
   static std::unordered_map<int64_t, int32_t> research_states;
   static std::mutex                           research_states_mtx;
 
   if (auto response = Digit::PrimeServer::Models::ResearchTreesState(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "research trees state",
-                         STR_FORMAT("Processing {} research projects", response.researchprojectlevels_size()));
+    http::sync_log_trace("PROCESS", "research trees state", "Processing {} research projects",
+                         response.researchprojectlevels_size());
 
     auto research_array = json::array();
     {
@@ -858,6 +1050,8 @@ void process_research_trees_state(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!research_array.empty()) {
       queue_data(SyncConfig::Type::Research, research_array);
     }
@@ -869,12 +1063,14 @@ void process_research_trees_state(std::unique_ptr<std::string>&& bytes)
 void process_officers(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Officer);
   static std::unordered_map<uint64_t, RankLevelShardsState> officer_states;
   static std::mutex                                         officer_states_mtx;
 
   if (auto response = Digit::PrimeServer::Models::OfficersResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "officers", STR_FORMAT("Processing {} officers", response.officers_size()));
+    http::sync_log_trace("PROCESS", "officers", "Processing {} officers", response.officers_size());
 
     auto officers_array = json::array();
     {
@@ -895,6 +1091,8 @@ void process_officers(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!officers_array.empty()) {
       queue_data(SyncConfig::Type::Officer, officers_array);
     }
@@ -906,13 +1104,14 @@ void process_officers(std::unique_ptr<std::string>&& bytes)
 void process_forbidden_techs(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Tech);
   static std::unordered_map<uint64_t, RankLevelShardsState> tech_states;
   static std::mutex                                         tech_states_mtx;
 
   if (auto response = Digit::PrimeServer::Models::ForbiddenTechsResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "techs",
-                         STR_FORMAT("Processing {} forbidden/chaos techs", response.forbiddentechs_size()));
+    http::sync_log_trace("PROCESS", "techs", "Processing {} forbidden/chaos techs", response.forbiddentechs_size());
 
     auto tech_array = json::array();
     {
@@ -932,6 +1131,8 @@ void process_forbidden_techs(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!tech_array.empty()) {
       queue_data(SyncConfig::Type::Tech, tech_array);
     }
@@ -943,13 +1144,15 @@ void process_forbidden_techs(std::unique_ptr<std::string>&& bytes)
 void process_active_officer_traits(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Traits);
   static std::unordered_map<std::pair<int64_t, int64_t>, int32_t, pairhash> trait_states;
   static std::mutex                                                         trait_states_mtx;
 
   if (auto response = Digit::PrimeServer::Models::OfficerTraitsResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "active officer traits",
-                         STR_FORMAT("Processing {} active officer traits", response.activeofficertraits_size()));
+    http::sync_log_trace("PROCESS", "active officer traits", "Processing {} active officer traits",
+                         response.activeofficertraits_size());
 
     auto trait_array = json::array();
     {
@@ -970,6 +1173,8 @@ void process_active_officer_traits(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!trait_array.empty()) {
       queue_data(SyncConfig::Type::Traits, trait_array);
     }
@@ -981,15 +1186,16 @@ void process_active_officer_traits(std::unique_ptr<std::string>&& bytes)
 void process_global_active_buffs(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Buffs);
   static std::unordered_map<int64_t, std::pair<int32_t, int64_t>> buff_states;
   static std::mutex                                               buff_states_mtx;
   static std::atomic_bool                                         is_first_sync{true};
 
 
   if (auto response = Digit::PrimeServer::Models::GlobalActiveBuffsResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "global buffs",
-                         STR_FORMAT("Processing {} active buffs", response.globalactivebuffs_size()));
+    http::sync_log_trace("PROCESS", "global buffs", "Processing {} active buffs", response.globalactivebuffs_size());
 
     auto buff_array = json::array();
     {
@@ -1027,6 +1233,8 @@ void process_global_active_buffs(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!buff_array.empty()) {
       const bool first_sync = is_first_sync.exchange(false, std::memory_order_acq_rel);
       queue_data(SyncConfig::Type::Buffs, buff_array, first_sync);
@@ -1065,10 +1273,12 @@ inline std::optional<std::chrono::time_point<std::chrono::system_clock>> parse_t
 void process_entity_slots(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Slots);
 
   if (auto response = Digit::PrimeServer::Models::EntitySlots(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "entity slots", STR_FORMAT("Processing {} slots", response.entityslots__size()));
+    http::sync_log_trace("PROCESS", "entity slots", "Processing {} slots", response.entityslots__size());
 
     auto slot_array = json::array();
     {
@@ -1135,6 +1345,8 @@ void process_entity_slots(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!slot_array.empty()) {
       queue_data(SyncConfig::Type::Slots, slot_array);
     }
@@ -1237,13 +1449,15 @@ void process_entity_slots_rtc(std::unique_ptr<std::string>&& json_payload)
 void process_jobs(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::Jobs);
   static std::unordered_set<std::string> jobs_active;
   static std::mutex                      jobs_active_mtx;
   static std::atomic_bool                is_first_sync{true};
 
   if (auto response = Digit::PrimeServer::Models::JobResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
-    http::sync_log_trace("PROCESS", "jobs", STR_FORMAT("Processing {} jobs", response.jobs_size()));
+    http::sync_log_trace("PROCESS", "jobs", "Processing {} jobs", response.jobs_size());
 
     std::unordered_set<std::string> uuids_in_response;
     uuids_in_response.reserve(response.jobs_size());
@@ -1313,6 +1527,8 @@ void process_jobs(std::unique_ptr<std::string>&& bytes)
       }
     }
 
+    stopwatch.Diffed();
+
     if (!job_array.empty()) {
       bool first_sync = is_first_sync.exchange(false, std::memory_order_acq_rel);
       queue_data(SyncConfig::Type::Jobs, job_array, first_sync);
@@ -1325,9 +1541,11 @@ void process_jobs(std::unique_ptr<std::string>&& bytes)
 void process_alliance_games_props(std::unique_ptr<std::string>&& bytes)
 {
   using json = nlohmann::json;
+  SyncMetrics::Stopwatch stopwatch(SyncConfig::Type::EmeraldChain);
   static std::atomic_int32_t emerald_chain_level{-1};
 
   if (auto response = Digit::PrimeServer::Models::AllianceGamePropertiesResponse(); response.ParseFromString(*bytes)) {
+    stopwatch.Parsed();
 
     for (const auto& prop : response.properties()) {
       if (prop.propertyname() == "claimed_loyalty_tiers") {
@@ -1353,7 +1571,7 @@ void process_alliance_games_props(std::unique_ptr<std::string>&& bytes)
 
 void process_battle_headers(const nlohmann::json& section)
 {
-  http::sync_log_trace("PROCESS", "battle headers", STR_FORMAT("Processing {} battle headers", section.size()));
+  http::sync_log_trace("PROCESS", "battle headers", "Processing {} battle headers", section.size());
 
   std::vector<uint64_t> battle_ids;
   battle_ids.reserve(section.size());
@@ -1377,8 +1595,7 @@ void process_battle_headers(const nlohmann::json& section)
   }
 
   if (!to_enqueue.empty()) {
-    http::sync_log_trace("PROCESS", "battle headers",
-                         STR_FORMAT("Queuing {} battles for background processing", to_enqueue.size()));
+    http::sync_log_trace("PROCESS", "battle headers", "Queuing {} battles for background processing", to_enqueue.size());
 
     {
       std::lock_guard lk(combat_log_data_mtx);
@@ -1399,7 +1616,7 @@ void process_resources(const nlohmann::json& section)
   static std::mutex                           resource_states_mtx;
   static std::atomic_bool                     is_first_sync{true};
 
-  http::sync_log_trace("PROCESS", "resources", STR_FORMAT("Processing {} resources", section.size()));
+  http::sync_log_trace("PROCESS", "resources", "Processing {} resources", section.size());
 
   auto resource_array = json::array();
   {
@@ -1428,7 +1645,7 @@ void process_starbase_modules(const nlohmann::json& section)
   static std::unordered_map<int64_t, int32_t> module_states;
   static std::mutex                           module_states_mtx;
 
-  http::sync_log_trace("PROCESS", "starbase modules", STR_FORMAT("Processing {} buildings", section.size()));
+  http::sync_log_trace("PROCESS", "starbase modules", "Processing {} buildings", section.size());
 
   auto starbase_array = json::array();
   {
@@ -1457,7 +1674,7 @@ void process_ships(const nlohmann::json& section)
   static std::mutex                             ship_states_mtx;
   static std::atomic_bool                       is_first_sync{true};
 
-  http::sync_log_trace("PROCESS", "ships", STR_FORMAT("Processing {} ships", section.size()));
+  http::sync_log_trace("PROCESS", "ships", "Processing {} ships", section.size());
 
   auto ship_array = json::array();
   {
@@ -1499,28 +1716,28 @@ void process_json(std::unique_ptr<std::string>&& bytes)
 
     for (const auto& [key, section] : result.items()) {
       if (key == "battle_result_headers") {
-        if (!Config::Get().sync_options.battlelogs) {
+        if (!Config::Get()->sync_options.battlelogs) {
           continue;
         }
 
         process_battle_headers(section);
 
       } else if (key == "resources") {
-        if (!Config::Get().sync_options.resources) {
+        if (!Config::Get()->sync_options.resources) {
           continue;
         }
 
         process_resources(section);
 
       } else if (key == "starbase_modules") {
-        if (!Config::Get().sync_options.buildings) {
+        if (!Config::Get()->sync_options.buildings) {
           continue;
         }
 
         process_starbase_modules(section);
 
       } else if (key == "ships") {
-        if (!Config::Get().sync_options.ships) {
+        if (!Config::Get()->sync_options.ships) {
           continue;
         }
 
@@ -1538,7 +1755,7 @@ void cache_player_names(std::unique_ptr<std::string>&& bytes)
 
     std::unordered_map<std::string, CachedPlayerData> names;
     const auto                                        expires_at =
-        std::chrono::steady_clock::now() + std::chrono::seconds(Config::Get().sync_resolver_cache_ttl);
+        std::chrono::steady_clock::now() + std::chrono::seconds(Config::Get()->sync_resolver_cache_ttl);
 
     for (const auto& profile : response.userprofiles()) {
       names.insert_or_assign(profile.userid(), CachedPlayerData{profile.name(), profile.allianceid(), expires_at});
@@ -1559,7 +1776,7 @@ void cache_alliance_names(std::unique_ptr<std::string>&& bytes)
 
     std::unordered_map<int64_t, CachedAllianceData> names;
     const auto                                      expires_at =
-        std::chrono::steady_clock::now() + std::chrono::seconds(Config::Get().sync_resolver_cache_ttl);
+        std::chrono::steady_clock::now() + std::chrono::seconds(Config::Get()->sync_resolver_cache_ttl);
 
     for (const auto& alliance : response.allianceprofiles()) {
       if (alliance.id() > 0) {
@@ -1583,15 +1800,18 @@ void ship_sync_data()
   WinRtApartmentGuard apartmentGuard;
 #endif
 
+  TraceRecorder::NameThread("sync ship");
+
   try {
     for (;;) {
-      std::tuple<SyncConfig::Type, std::string, bool> sync_data;
+      std::tuple<SyncConfig::Type, nlohmann::json, bool> sync_data;
       {
         std::unique_lock lock(sync_data_mtx);
         sync_data_cv.wait(lock, []() { return !sync_data_queue.empty(); });
         // Move the item out while holding the lock to avoid races/UB
         sync_data = std::move(sync_data_queue.front());
         sync_data_queue.pop();
+        SyncMetrics::SetQueueDepth("global", sync_data_queue.size());
       }
 
       try {
@@ -1693,264 +1913,262 @@ void resolve_alliance_names(const std::unordered_set<int64_t>& alliance_ids, nlo
   }
 }
 
-void ship_combat_log_data()
+// Fetches the journal of one battle and the names of everyone in it, then sends it
+static void ship_combat_log(uint64_t journal_id)
 {
   using json = nlohmann::json;
 
-#if _WIN32
-  WinRtApartmentGuard apartmentGuard;
-#endif
+  try {
+    http::sync_log_trace("PROCESS", "combat log", "Fetching combat log for battle {}", journal_id);
 
+    const json journals_body{{"journal_id", journal_id}};
+    auto       battle_log = http::get_scopely_data("/journals/get", journals_body.dump());
+    json       battle_json;
 
-  for (;;) {
-    uint64_t journal_id;
-    {
-      std::unique_lock lock(combat_log_data_mtx);
-      combat_log_data_cv.wait(lock, [] { return !combat_log_data_queue.empty(); });
-      // Move the item out while holding the lock to avoid races/UB
-      journal_id = combat_log_data_queue.front();
-      combat_log_data_queue.pop();
+    if (battle_log.empty()) {
+      return;
     }
 
     try {
-      http::sync_log_trace("PROCESS", "combat log", STR_FORMAT("Fetching combat log for battle {}", journal_id));
-
-      const json journals_body{{"journal_id", journal_id}};
-      auto       battle_log = http::get_scopely_data("/journals/get", journals_body.dump());
-      json       battle_json;
-
-      if (battle_log.empty()) {
-        continue;
-      }
-
-      try {
-        battle_json = std::move(json::parse(battle_log));
-      } catch (const json::exception& e) {
-        spdlog::error("Error parsing journal response from game server: {}", e.what());
-        continue;
-      }
+      battle_json = std::move(json::parse(battle_log));
+    } catch (const json::exception& e) {
+      spdlog::error("Error parsing journal response from game server: {}", e.what());
+      return;
+    }
 
-      const auto& journal              = battle_json["journal"];
-      const auto& target_fleet_data    = journal["target_fleet_data"];
-      const auto& initiator_fleet_data = journal["initiator_fleet_data"];
+    const auto& journal              = battle_json["journal"];
+    const auto& target_fleet_data    = journal["target_fleet_data"];
+    const auto& initiator_fleet_data = journal["initiator_fleet_data"];
 
-      auto       names      = json::object();
-      const auto now        = std::chrono::steady_clock::now();
-      const auto expires_at = now + std::chrono::seconds(Config::Get().sync_resolver_cache_ttl);
+    auto       names      = json::object();
+    const auto now        = std::chrono::steady_clock::now();
+    const auto expires_at = now + std::chrono::seconds(Config::Get()->sync_resolver_cache_ttl);
 
-      {
-        std::unordered_set<std::string> user_ids;
-        collect_user_ids_from_fleet(target_fleet_data, user_ids);
-        collect_user_ids_from_fleet(initiator_fleet_data, user_ids);
+    {
+      std::unordered_set<std::string> user_ids;
+      collect_user_ids_from_fleet(target_fleet_data, user_ids);
+      collect_user_ids_from_fleet(initiator_fleet_data, user_ids);
 
-        json profiles_request{{"user_ids", json::array()}};
-        resolve_player_names(user_ids, names, profiles_request["user_ids"], now);
+      json profiles_request{{"user_ids", json::array()}};
+      resolve_player_names(user_ids, names, profiles_request["user_ids"], now);
 
-        const auto fetch_count = profiles_request["user_ids"].size();
-        if (fetch_count > 0) {
-          http::sync_log_trace("PROCESS", "combat log", STR_FORMAT("Fetching {} player profiles", fetch_count));
+      const auto fetch_count = profiles_request["user_ids"].size();
+      if (fetch_count > 0) {
+        http::sync_log_trace("PROCESS", "combat log", "Fetching {} player profiles", fetch_count);
 
-          auto profiles      = http::get_scopely_data("/user_profile/profiles", profiles_request.dump());
-          auto profiles_json = json::parse(profiles);
+        auto profiles      = http::get_scopely_data("/user_profile/profiles", profiles_request.dump());
+        auto profiles_json = json::parse(profiles);
 
-          std::lock_guard lk(player_data_cache_mtx);
+        std::lock_guard lk(player_data_cache_mtx);
 
-          try {
-            for (const auto& [player_id, profile] : profiles_json["user_profiles"].get<json::object_t>()) {
-              const auto& name        = profile["name"].get<std::string>();
-              const auto& alliance_id = profile["alliance_id"].get<int64_t>();
+        try {
+          for (const auto& [player_id, profile] : profiles_json["user_profiles"].get<json::object_t>()) {
+            const auto& name        = profile["name"].get<std::string>();
+            const auto& alliance_id = profile["alliance_id"].get<int64_t>();
 
-              names[player_id] = {
-                  {"name", name}, {"alliance_id", alliance_id}, {"alliance_name", nullptr}, {"alliance_tag", nullptr}};
-              player_data_cache[player_id] = {name, alliance_id, expires_at};
-            }
-          } catch (const json::exception& e) {
-            spdlog::error("Failed to parse user profiles: {}", e.what());
+            names[player_id] = {
+                {"name", name}, {"alliance_id", alliance_id}, {"alliance_name", nullptr}, {"alliance_tag", nullptr}};
+            player_data_cache[player_id] = {name, alliance_id, expires_at};
           }
+        } catch (const json::exception& e) {
+          spdlog::error("Failed to parse user profiles: {}", e.what());
         }
       }
+    }
 
-      {
-        std::unordered_set<int64_t> alliance_ids;
-        json alliances_request{{"user_current_rank", 0}, {"alliance_id", 0}, {"alliance_ids", json::array()}};
+    {
+      std::unordered_set<int64_t> alliance_ids;
+      json alliances_request{{"user_current_rank", 0}, {"alliance_id", 0}, {"alliance_ids", json::array()}};
 
-        collect_alliance_ids(names, alliance_ids);
-        resolve_alliance_names(alliance_ids, names, alliances_request["alliance_ids"], now);
+      collect_alliance_ids(names, alliance_ids);
+      resolve_alliance_names(alliance_ids, names, alliances_request["alliance_ids"], now);
 
-        const auto fetch_count = alliances_request["alliance_ids"].size();
-        if (fetch_count > 0) {
-          http::sync_log_trace("PROCESS", "combat log", STR_FORMAT("Fetching {} alliance profiles", fetch_count));
+      const auto fetch_count = alliances_request["alliance_ids"].size();
+      if (fetch_count > 0) {
+        http::sync_log_trace("PROCESS", "combat log", "Fetching {} alliance profiles", fetch_count);
 
-          auto profiles      = http::get_scopely_data("/alliance/get_alliances_public_info", alliances_request.dump());
-          auto profiles_json = json::parse(profiles);
+        auto profiles      = http::get_scopely_data("/alliance/get_alliances_public_info", alliances_request.dump());
+        auto profiles_json = json::parse(profiles);
 
-          std::lock_guard lk(alliance_data_cache_mtx);
+        std::lock_guard lk(alliance_data_cache_mtx);
 
-          try {
-            for (const auto& [alliance_id_str, profile] : profiles_json["alliances_info"].get<json::object_t>()) {
-              const auto  id   = profile["id"].get<int64_t>();
-              const auto& name = profile["name"].get<std::string>();
-              const auto& tag  = profile["tag"].get<std::string>();
+        try {
+          for (const auto& [alliance_id_str, profile] : profiles_json["alliances_info"].get<json::object_t>()) {
+            const auto  id   = profile["id"].get<int64_t>();
+            const auto& name = profile["name"].get<std::string>();
+            const auto& tag  = profile["tag"].get<std::string>();
 
-              alliance_data_cache[id] = {name, tag, expires_at};
-            }
-          } catch (json::exception& e) {
-            spdlog::error("Failed to parse alliance profiles: {}", e.what());
+            alliance_data_cache[id] = {name, tag, expires_at};
           }
+        } catch (json::exception& e) {
+          spdlog::error("Failed to parse alliance profiles: {}", e.what());
+        }
 
-          for (auto& [player_id, entry] : names.items()) {
-            try {
-              if (entry.contains("alliance_id")) {
-                const auto alliance_id = entry["alliance_id"].get<int64_t>();
-                const auto it          = alliance_data_cache.find(alliance_id);
-                if (it != alliance_data_cache.end()) {
-                  entry["alliance_name"] = it->second.name;
-                  entry["alliance_tag"]  = it->second.tag;
-                  entry.erase("alliance_id");
-                }
+        for (auto& [player_id, entry] : names.items()) {
+          try {
+            if (entry.contains("alliance_id")) {
+              const auto alliance_id = entry["alliance_id"].get<int64_t>();
+              const auto it          = alliance_data_cache.find(alliance_id);
+              if (it != alliance_data_cache.end()) {
+                entry["alliance_name"] = it->second.name;
+                entry["alliance_tag"]  = it->second.tag;
+                entry.erase("alliance_id");
               }
-            } catch (json::exception& e) {
-              spdlog::error("Failed to update cached player data: {}", e.what());
             }
+          } catch (json::exception& e) {
+            spdlog::error("Failed to update cached player data: {}", e.what());
           }
         }
       }
+    }
 
-      auto battle_array = json::array();
-      battle_array.push_back(
-          {{"type", SyncConfig::Type::Battles}, {"names", names}, {"journal", battle_json["journal"]}});
+    auto battle_array = json::array();
+    battle_array.push_back(
+        {{"type", SyncConfig::Type::Battles}, {"names", names}, {"journal", battle_json["journal"]}});
 
-      try {
-        auto ship_data = battle_array.dump();
-        http::send_data(SyncConfig::Type::Battles, ship_data, false);
-      } catch (const std::runtime_error& e) {
-        ErrorMsg::SyncRuntime("combat", e);
-      } catch (const std::exception& e) {
-        ErrorMsg::SyncException("combat", e);
-      } catch (const std::wstring& sz) {
-        ErrorMsg::SyncMsg("combat", sz);
+    if (record_sink) {
+      record_sink(SyncConfig::Type::Battles, battle_array);
+      return;
+    }
+
+    try {
+      http::send_data(SyncConfig::Type::Battles, battle_array, false);
+    } catch (const std::runtime_error& e) {
+      ErrorMsg::SyncRuntime("combat", e);
+    } catch (const std::exception& e) {
+      ErrorMsg::SyncException("combat", e);
+    } catch (const std::wstring& sz) {
+      ErrorMsg::SyncMsg("combat", sz);
 #if _WIN32
-      } catch (winrt::hresult_error const& ex) {
-        ErrorMsg::SyncWinRT("combat", ex);
+    } catch (winrt::hresult_error const& ex) {
+      ErrorMsg::SyncWinRT("combat", ex);
 #endif
-      } catch (...) {
-        ErrorMsg::SyncMsg("combat", "Unknown error during sending of sync data");
-      }
-
-    } catch (json::exception& e) {
-      spdlog::error("Error parsing combat log or profiles: {}", e.what());
-    } catch (std::exception& e) {
-      spdlog::error("Error processing combat log: {}", e.what());
     } catch (...) {
-      spdlog::error("Unknown error during processing of combat log data");
+      ErrorMsg::SyncMsg("combat", "Unknown error during sending of sync data");
     }
+
+  } catch (json::exception& e) {
+    spdlog::error("Error parsing combat log or profiles: {}", e.what());
+  } catch (std::exception& e) {
+    spdlog::error("Error processing combat log: {}", e.what());
+  } catch (...) {
+    spdlog::error("Unknown error during processing of combat log data");
   }
 }
 
-void HandleEntityGroup(EntityGroup* entity_group)
+void ship_combat_log_data()
 {
-  if (entity_group == nullptr || entity_group->Group == nullptr || entity_group->Group->bytes == nullptr
-      || entity_group->Group->Length <= 0) {
-    return;
-  }
-
-  const auto byteCount = static_cast<size_t>(entity_group->Group->Length);
-  auto       bytesPtr  = reinterpret_cast<const char*>(entity_group->Group->bytes->m_Items);
+#if _WIN32
+  WinRtApartmentGuard apartmentGuard;
+#endif
 
-  // Helper to run processing asynchronously with exception handling
-  auto submit_async = [bytesPtr, byteCount]<typename T>(T&& func) {
-    auto payload = std::make_unique<std::string>(bytesPtr, byteCount);
 
-    try {
-      std::thread([f = std::forward<T>(func), p = std::move(payload)]() mutable {
-        try {
-          f(std::move(p));
-        } catch (const std::exception& e) {
-          spdlog::error("Exception in HandleEntityGroup: {}", e.what());
-        } catch (...) {
-          spdlog::error("Unknown exception in HandleEntityGroup");
-        }
-      }).detach();
-    } catch (const std::exception& e) {
-      spdlog::error("Failed to spawn async task: {}", e.what());
-    } catch (...) {
-      spdlog::error("Failed to spawn async task: unknown exception");
+  for (;;) {
+    uint64_t journal_id;
+    {
+      std::unique_lock lock(combat_log_data_mtx);
+      combat_log_data_cv.wait(lock, [] { return !combat_log_data_queue.empty(); });
+      // Move the item out while holding the lock to avoid races/UB
+      journal_id = combat_log_data_queue.front();
+      combat_log_data_queue.pop();
     }
-  };
 
-  switch (entity_group->Type_) {
+    ship_combat_log(journal_id);
+  }
+}
+
+using EntityGroupProcessor = void (*)(std::unique_ptr<std::string>&&);
+
+static EntityGroupProcessor get_entity_group_processor(const EntityGroup::Type type)
+{
+  const auto  config  = Config::Get();
+  const auto& options = config->sync_options;
+
+  switch (type) {
     case EntityGroup::Type::ActiveMissions:
-      if (Config::Get().sync_options.missions) {
-        submit_async(process_active_missions);
-      }
-      break;
+      return options.missions ? process_active_missions : nullptr;
     case EntityGroup::Type::CompletedMissions:
-      if (Config::Get().sync_options.missions) {
-        submit_async(process_completed_missions);
-      }
-      break;
+      return options.missions ? process_completed_missions : nullptr;
     case EntityGroup::Type::PlayerInventories:
-      if (Config::Get().sync_options.inventory) {
-        submit_async(process_player_inventories);
-      }
-      break;
+      return options.inventory ? process_player_inventories : nullptr;
     case EntityGroup::Type::ResearchTreesState:
-      if (Config::Get().sync_options.research) {
-        submit_async(process_research_trees_state);
-      }
-      break;
+      return options.research ? process_research_trees_state : nullptr;
     case EntityGroup::Type::Officers:
-      if (Config::Get().sync_options.officer) {
-        submit_async(process_officers);
-      }
-      break;
+      return options.officer ? process_officers : nullptr;
     case EntityGroup::Type::ForbiddenTechs:
-      if (Config::Get().sync_options.tech) {
-        submit_async(process_forbidden_techs);
-      }
-      break;
+      return options.tech ? process_forbidden_techs : nullptr;
     case EntityGroup::Type::ActiveOfficerTraits:
-      if (Config::Get().sync_options.traits) {
-        submit_async(process_active_officer_traits);
-      }
-      break;
+      return options.traits ? process_active_officer_traits : nullptr;
     case EntityGroup::Type::Json:
-      if (const auto& o = Config::Get().sync_options; o.battlelogs || o.resources || o.ships || o.buildings) {
-        submit_async(process_json);
+      if (options.battlelogs || options.resources || options.ships || options.buildings) {
+        return process_json;
       }
-      break;
+      return nullptr;
     case EntityGroup::Type::Jobs:
-      if (Config::Get().sync_options.jobs) {
-        submit_async(process_jobs);
-      }
-      break;
+      return options.jobs ? process_jobs : nullptr;
     case EntityGroup::Type::GlobalActiveBuffs:
-      if (Config::Get().sync_options.buffs) {
-        submit_async(process_global_active_buffs);
-      }
-      break;
+      return options.buffs ? process_global_active_buffs : nullptr;
     case EntityGroup::Type::EntitySlots:
-      if (Config::Get().sync_options.slots) {
-        submit_async(process_entity_slots);
-      }
-      break;
+      return options.slots ? process_entity_slots : nullptr;
     case EntityGroup::Type::AllianceGetGameProperties:
-      if (Config::Get().sync_options.buffs) {
-        submit_async(process_alliance_games_props);
-      }
-      break;
+      return options.buffs ? process_alliance_games_props : nullptr;
     case EntityGroup::Type::UserProfiles:
-      if (Config::Get().sync_options.battlelogs) {
-        submit_async(cache_player_names);
-      }
-      break;
+      return options.battlelogs ? cache_player_names : nullptr;
     case EntityGroup::Type::AllianceProfiles:
-      if (Config::Get().sync_options.battlelogs) {
-        submit_async(cache_alliance_names);
-      }
-      break;
+      return options.battlelogs ? cache_alliance_names : nullptr;
     default:
-      break;
+      return nullptr;
+  }
+}
+
+static bool is_slot_rtc_target(const std::string_view target)
+{
+  return target == "slot:assign" || target == "slot:clear";
+}
+
+void HandleEntityGroup(EntityGroup* entity_group)
+{
+  if (entity_group == nullptr || entity_group->Group == nullptr || entity_group->Group->bytes == nullptr
+      || entity_group->Group->Length <= 0) {
+    return;
+  }
+
+  const auto type = entity_group->Type_;
+  SyncMetrics::CountEntityGroup(type);
+
+  const auto processor = get_entity_group_processor(type);
+  if (processor == nullptr) {
+    return;
+  }
+
+  std::unique_ptr<std::string> payload;
+  {
+    TraceRecorder::Scope trace("payload copy", "sync");
+
+    const auto byteCount = static_cast<size_t>(entity_group->Group->Length);
+    auto       bytesPtr  = reinterpret_cast<const char*>(entity_group->Group->bytes->m_Items);
+    payload              = std::make_unique<std::string>(bytesPtr, byteCount);
+
+    if (SyncCapture::Enabled()) {
+      SyncCapture::Write(type, {}, *payload);
+    }
+  }
+
+  // Run processing asynchronously with exception handling
+  try {
+    std::thread([processor, p = std::move(payload)]() mutable {
+      try {
+        processor(std::move(p));
+      } catch (const std::exception& e) {
+        spdlog::error("Exception in HandleEntityGroup: {}", e.what());
+      } catch (...) {
+        spdlog::error("Unknown exception in HandleEntityGroup");
+      }
+    }).detach();
+  } catch (const std::exception& e) {
+    spdlog::error("Failed to spawn async task: {}", e.what());
+  } catch (...) {
+    spdlog::error("Failed to spawn async task: unknown exception");
   }
 }
 
@@ -1969,7 +2187,7 @@ void DataContainer_ParseRtcPayload(auto original, void* _this, bool incrementalJ
   }
 
   const auto target = to_string(data->Target);
-  if (target != "slot:assign" && target != "slot:clear") {
+  if (!is_slot_rtc_target(target)) {
     return;
   }
 
@@ -1978,8 +2196,16 @@ void DataContainer_ParseRtcPayload(auto original, void* _this, bool incrementalJ
     return;
   }
 
-  const auto rtcData = to_string(data->Data);
-  auto payload = std::make_unique<std::string>(rtcData);
+  std::unique_ptr<std::string> payload;
+  {
+    TraceRecorder::Scope trace("payload copy", "sync");
+
+    payload = std::make_unique<std::string>(to_string(data->Data));
+
+    if (SyncCapture::Enabled()) {
+      SyncCapture::Write(SyncCapture::RtcType, target, *payload);
+    }
+  }
 
   std::thread([p = std::move(payload)]() mutable {
     try {
@@ -1992,6 +2218,58 @@ void DataContainer_ParseRtcPayload(auto original, void* _this, bool incrementalJ
   }).detach();
 }
 
+void SyncReplay::SetRecordSink(RecordSink sink)
+{
+  record_sink = std::move(sink);
+}
+
+bool SyncReplay::ProcessEntityGroup(int32_t type, std::unique_ptr<std::string>&& payload)
+{
+  const auto processor = get_entity_group_processor(static_cast<EntityGroup::Type>(type));
+  if (processor == nullptr) {
+    return false;
+  }
+
+  processor(std::move(payload));
+  return true;
+}
+
+void SyncReplay::AddScopelyResponse(std::string_view target, std::string response)
+{
+  http::replay_responses.insert_or_assign(std::string(target), std::move(response));
+}
+
+size_t SyncReplay::DrainCombatLogs()
+{
+  size_t drained = 0;
+
+  for (;;) {
+    uint64_t journal_id;
+    {
+      std::lock_guard lock(combat_log_data_mtx);
+      if (combat_log_data_queue.empty()) {
+        return drained;
+      }
+
+      journal_id = combat_log_data_queue.front();
+      combat_log_data_queue.pop();
+    }
+
+    ship_combat_log(journal_id);
+    drained++;
+  }
+}
+
+bool SyncReplay::ProcessRtc(std::string_view target, std::unique_ptr<std::string>&& payload)
+{
+  if (!is_slot_rtc_target(target)) {
+    return false;
+  }
+
+  process_entity_slots_rtc(std::move(payload));
+  return true;
+}
+
 void GameServerModelRegistry_ProcessResultInternal(auto original, void* _this, HttpResponse* http_response,
                                                    ServiceResponse* service_response, void* callback,
                                                    void* callback_error)
@@ -22,7 +22,7 @@
 #include <prime/UIBehaviour.h>
 
 #include <il2cpp/il2cpp_helper.h>
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 #include <spud/signature.h>
 
 class AppConfig
@@ -43,38 +43,38 @@ private:
 public:
   Il2CppString* __get_PlatformSettingsUrl()
   {
-    static auto prop = get_class_helper().GetProperty("PlatformSettingsUrl");
-    return prop.GetRaw<Il2CppString>((void*)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("PlatformSettingsUrl");
+    return prop.Get((void*)this);
   }
 
   void __set_PlatformSettingsUrl(Il2CppString* v)
   {
-    static auto prop = get_class_helper().GetProperty("PlatformSettingsUrl");
-    return prop.SetRaw((void*)this, *v);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("PlatformSettingsUrl");
+    prop.Set((void*)this, v);
   }
 
   Il2CppString* __get_PlatformApiKey()
   {
-    static auto prop = get_class_helper().GetProperty("PlatformApiKey");
-    return prop.GetRaw<Il2CppString>((void*)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("PlatformApiKey");
+    return prop.Get((void*)this);
   }
 
   void __set_PlatformApiKey(Il2CppString* v)
   {
-    static auto prop = get_class_helper().GetProperty("PlatformApiKey");
-    return prop.SetRaw((void*)this, *v);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("PlatformApiKey");
+    prop.Set((void*)this, v);
   }
 
   Il2CppString* __get_AssetUrlOverride()
   {
-    static auto prop = get_class_helper().GetProperty("AssetUrlOverride");
-    return prop.GetRaw<Il2CppString>((void*)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("AssetUrlOverride");
+    return prop.Get((void*)this);
   }
 
   void __set_AssetUrlOverride(Il2CppString* v)
   {
-    static auto prop = get_class_helper().GetProperty("AssetUrlOverride");
-    return prop.SetRaw((void*)this, *v);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("AssetUrlOverride");
+    prop.Set((void*)this, v);
   }
 };
 
@@ -101,7 +101,7 @@ public:
 void Cursor_SetCursor(auto original, void* _this, ptrdiff_t texture, Vector2* hotspot, int cursorMode)
 {
 #if _WIN32
-  if (!Config::Get().allow_cursor) {
+  if (!Config::Get()->allow_cursor) {
     SetCursor(LoadCursor(NULL, IDC_ARROW));
     ClipCursor(nullptr); // free cursor from any Unity clipping
     return;
@@ -116,33 +116,22 @@ AppConfig* Model_LoadConfigs(auto original, Model* _this)
   original(_this);
   auto config = _this->AppConfig_;
 
-  if (!Config::Get().config_settings_url.empty()) {
-    auto new_settings_url       = il2cpp_string_new(Config::Get().config_settings_url.c_str());
+  if (!Config::Get()->config_settings_url.empty()) {
+    auto new_settings_url       = il2cpp_string_new(Config::Get()->config_settings_url.c_str());
     config->PlatformSettingsUrl = new_settings_url;
   }
 
-  if (!Config::Get().config_assets_url_override.empty()) {
-    auto new_url             = il2cpp_string_new(Config::Get().config_assets_url_override.c_str());
+  if (!Config::Get()->config_assets_url_override.empty()) {
+    auto new_url             = il2cpp_string_new(Config::Get()->config_assets_url_override.c_str());
     config->AssetUrlOverride = new_url;
   }
 
   return config;
 }
 
-void SetActive_hook(auto original, void* _this, bool active)
-{
-  static auto IsActiveSelf = il2cpp_resolve_icall_typed<bool(void*)>("UnityEngine.GameObject::get_activeSelf()");
-
-  if (active && IsActiveSelf(_this)) {
-    return;
-    // __debugbreak();
-  }
-  return original(_this, active);
-}
-
 bool IsQueueEnabled(auto original, void* _this)
 {
-  if (Config::Get().queue_enabled) {
+  if (Config::Get()->queue_enabled) {
     return original(_this);
   }
 
@@ -175,20 +164,6 @@ void InstallTestPatches()
     }
   }
 
-  auto battle_target_data =
-      il2cpp_get_class_helper("Digit.Client.PrimeLib.Runtime", "Digit.PrimeServer.Models", "BattleTargetData");
-  if (!battle_target_data.isValidHelper()) {
-    ErrorMsg::MissingHelper("Models", "BattleTargetData");
-  } else {
-    static auto SetActive =
-        il2cpp_resolve_icall_typed<void(void*, bool)>("UnityEngine.GameObject::SetActive(System.Boolean)");
-    if (SetActive == nullptr) {
-      ErrorMsg::MissingStaticMethod("GameObject", "SetActive");
-    } else {
-      SPUD_STATIC_DETOUR(SetActive, SetActive_hook);
-    }
-  }
-
   auto queue_manager = il2cpp_get_class_helper("Assembly-CSharp", "Prime.ActionQueue", "ActionQueueManager");
   if (!queue_manager.isValidHelper()) {
     ErrorMsg::MissingHelper("ActionQueue", "ActionQueueManager");
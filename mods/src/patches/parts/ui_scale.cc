@@ -8,7 +8,7 @@
 #include <prime/Transform.h>
 
 #include <spdlog/spdlog.h>
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 #include <prime/Vector3.h>
 #include <str_utils.h>
@@ -19,12 +19,12 @@ void ScreenManager_UpdateCanvasRootScaleFactor_Hook(auto original, ScreenManager
 
   #if _WIN32
   static auto cursor = LoadCursor(NULL, IDC_ARROW);
-  if (!Config::Get().allow_cursor) {
+  if (!Config::Get()->allow_cursor) {
     SetCursor(cursor);
   }
   #endif
 
-  if (Config::Get().ui_scale != 0.0f) {
+  if (Config::Get()->ui_scale != 0.0f) {
     static auto get_height_method = il2cpp_resolve_icall_typed<int()>("UnityEngine.Screen::get_height()");
     static auto get_width_method  = il2cpp_resolve_icall_typed<int()>("UnityEngine.Screen::get_width()");
 
@@ -37,11 +37,11 @@ void ScreenManager_UpdateCanvasRootScaleFactor_Hook(auto original, ScreenManager
 
     auto adjustedFactor = scr_height / (float)ref_height;
 
-    if (!Config::Get().adjust_scale_res) {
+    if (!Config::Get()->adjust_scale_res) {
       adjustedFactor = 1.0f;
     }
 
-    auto n = (Config::Get().ui_scale * adjustedFactor * dpi);
+    auto n = (Config::Get()->ui_scale * adjustedFactor * dpi);
     if (isnan(n)) {
       n = 1.0f;
     }
@@ -53,13 +53,13 @@ void ScreenManager_UpdateCanvasRootScaleFactor_Hook(auto original, ScreenManager
 
 void CanvasController_Show(auto original, CanvasController* _this, int desiredEntryPoint, bool instant)
 {
-  const auto ui_scale_viewer = Config::Get().ui_scale_viewer;
+  const auto ui_scale_viewer = Config::Get()->ui_scale_viewer;
   if (ui_scale_viewer != 0.0f && to_wstring(_this->name) == L"ObjectViewerTemplate_Canvas") {
     auto transform        = _this->transform;
     auto localScale       = transform->localScale;
-    localScale->x         = ui_scale_viewer;
-    localScale->y         = ui_scale_viewer;
-    localScale->z         = ui_scale_viewer;
+    localScale.x          = ui_scale_viewer;
+    localScale.y          = ui_scale_viewer;
+    localScale.z          = ui_scale_viewer;
     transform->localScale = localScale;
   }
   return original(_this, desiredEntryPoint, instant);
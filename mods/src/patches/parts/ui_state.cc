@@ -0,0 +1,86 @@
+#include "errormsg.h"
+
+#include "patches/memory_manager.h"
+#include "patches/ui_latency.h"
+#include "patches/ui_state.h"
+#include "prime/EventSystem.h"
+#include "prime/TMP_InputField.h"
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include "patches/hook_profiler.h"
+
+void SectionManager_set_CurrentSection(auto original, void* _this, SectionID section)
+{
+  original(_this, section);
+  UiState::OnSectionChanged(section);
+  UiLatency::OnSectionChanged(section);
+  MemoryManager::OnSafePoint(MemoryManager::Reason::SectionChange);
+}
+
+void EventSystem_SetSelectedGameObject(auto original, EventSystem* _this, GameObject* selected, void* pointer)
+{
+  original(_this, selected, pointer);
+  UiState::OnSelectionChanged(_this, selected);
+}
+
+// isFocused flips in ActivateInputFieldInternal (run from LateUpdate after ActivateInputField) and
+// DeactivateInputField
+void TMP_InputField_ActivateInputFieldInternal(auto original, TMP_InputField* _this)
+{
+  original(_this);
+  UiState::OnInputFocusChanged(_this, _this->isFocused);
+}
+
+void TMP_InputField_DeactivateInputField(auto original, TMP_InputField* _this, bool clear_selection)
+{
+  original(_this, clear_selection);
+  UiState::OnInputFocusChanged(_this, _this->isFocused);
+}
+
+void InstallUiStateHooks()
+{
+  auto section_manager = il2cpp_get_class_helper("Assembly-CSharp", "Digit.Client.Sections", "SectionManager");
+  if (!section_manager.isValidHelper()) {
+    ErrorMsg::MissingHelper("Sections", "SectionManager");
+  } else {
+    auto ptr = section_manager.GetMethod("set_CurrentSection");
+    if (!ptr) {
+      ErrorMsg::MissingMethod("SectionManager", "set_CurrentSection");
+    } else {
+      SPUD_STATIC_DETOUR(ptr, SectionManager_set_CurrentSection);
+      UiState::sectionHooked = true;
+    }
+  }
+
+  auto event_system = il2cpp_get_class_helper("UnityEngine.UI", "UnityEngine.EventSystems", "EventSystem");
+  if (!event_system.isValidHelper()) {
+    ErrorMsg::MissingHelper("EventSystems", "EventSystem");
+  } else {
+    // The single argument overload forwards to this one
+    auto ptr = event_system.GetMethod("SetSelectedGameObject", 2);
+    if (!ptr) {
+      ErrorMsg::MissingMethod("EventSystem", "SetSelectedGameObject");
+    } else {
+      SPUD_STATIC_DETOUR(ptr, EventSystem_SetSelectedGameObject);
+      UiState::selectionHooked = true;
+    }
+  }
+
+  auto input_field = il2cpp_get_class_helper("Unity.TextMeshPro", "TMPro", "TMP_InputField");
+  if (!input_field.isValidHelper()) {
+    ErrorMsg::MissingHelper("TMPro", "TMP_InputField");
+  } else {
+    auto activate   = input_field.GetMethod("ActivateInputFieldInternal");
+    auto deactivate = input_field.GetMethod("DeactivateInputField", 1);
+    if (!activate) {
+      ErrorMsg::MissingMethod("TMP_InputField", "ActivateInputFieldInternal");
+    } else if (!deactivate) {
+      ErrorMsg::MissingMethod("TMP_InputField", "DeactivateInputField");
+    } else {
+      SPUD_STATIC_DETOUR(activate, TMP_InputField_ActivateInputFieldInternal);
+      SPUD_STATIC_DETOUR(deactivate, TMP_InputField_DeactivateInputField);
+      UiState::focusHooked = true;
+    }
+  }
+}
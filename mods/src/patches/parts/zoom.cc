@@ -2,6 +2,7 @@
 #include "errormsg.h"
 
 #include <patches/mapkey.h>
+#include <patches/ui_state.h>
 
 #include <il2cpp/il2cpp_helper.h>
 
@@ -9,7 +10,7 @@
 #include <prime/NavigationZoom.h>
 
 #include <spdlog/spdlog.h>
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
 
 vec3 GetMouseWorldPos(void *cam, vec3 *pos)
 {
@@ -24,11 +25,13 @@ vec3 GetMouseWorldPos(void *cam, vec3 *pos)
 
 auto do_default_zoom = false;
 
-inline void StoreZoom(std::string label, float &zoom, NavigationZoom *_this)
+inline void StoreZoom(std::string label, float Config::*preset, NavigationZoom *_this)
 {
-  auto old_zoom = zoom;
-  zoom          = (_this->Distance - _this->_minimum) / (_this->_maximum - _this->_minimum) * Config::Get().zoom;
-  spdlog::info("Changing {} from {} to {}", label, old_zoom, zoom);
+  Config::Update([&](Config &config) {
+    auto old_zoom  = config.*preset;
+    config.*preset = (_this->Distance - _this->_minimum) / (_this->_maximum - _this->_minimum) * config.zoom;
+    spdlog::info("Changing {} from {} to {}", label, old_zoom, config.*preset);
+  });
 }
 
 void NavigationZoom_Update_Hook(auto original, NavigationZoom *_this)
@@ -41,21 +44,21 @@ void NavigationZoom_Update_Hook(auto original, NavigationZoom *_this)
   auto       zoomDelta        = 0.0f;
   bool       do_absolute_zoom = false;
   bool       do_store_zoom    = false;
-  auto       config           = &Config::Get();
+  auto       config           = Config::Get();
 
-  if (!Key::IsInputFocused()) {
+  if (!UiState::IsInputFocused()) {
     if (MapKey::IsDown(GameFunction::SetZoomPreset1)) {
-      return StoreZoom("System Preset 1", config->system_zoom_preset_1, _this);
+      return StoreZoom("System Preset 1", &Config::system_zoom_preset_1, _this);
     } else if (MapKey::IsDown(GameFunction::SetZoomPreset2)) {
-      return StoreZoom("System Preset 2", config->system_zoom_preset_2, _this);
+      return StoreZoom("System Preset 2", &Config::system_zoom_preset_2, _this);
     } else if (MapKey::IsDown(GameFunction::SetZoomPreset3)) {
-      return StoreZoom("System Preset 3", config->system_zoom_preset_3, _this);
+      return StoreZoom("System Preset 3", &Config::system_zoom_preset_3, _this);
     } else if (MapKey::IsDown(GameFunction::SetZoomPreset4)) {
-      return StoreZoom("System Preset 4", config->system_zoom_preset_4, _this);
+      return StoreZoom("System Preset 4", &Config::system_zoom_preset_4, _this);
     } else if (MapKey::IsDown(GameFunction::SetZoomPreset5)) {
-      return StoreZoom("System Preset 5", config->system_zoom_preset_5, _this);
+      return StoreZoom("System Preset 5", &Config::system_zoom_preset_5, _this);
     } else if (MapKey::IsDown(GameFunction::SetZoomDefault)) {
-      return StoreZoom("System Default", config->default_system_zoom, _this);
+      return StoreZoom("System Default", &Config::default_system_zoom, _this);
     }
 
     do_absolute_zoom = true;
@@ -111,7 +114,7 @@ void NavigationZoom_Update_Hook(auto original, NavigationZoom *_this)
       auto worldPos      = GetMouseWorldPos(_this->_sceneCamera, &mousePos);
       _this->_worldPoint = worldPos;
       _this->ZoomCameraAtWorldPoint();
-    } else if (MapKey::IsPressed(GameFunction::ZoomOut) && !Key::IsInputFocused()) {
+    } else if (MapKey::IsPressed(GameFunction::ZoomOut) && !UiState::IsInputFocused()) {
       vec3 mousePos;
       GetMousePosition(&mousePos);
       _this->_zoomLocation  = vec2{mousePos.x, mousePos.y};
@@ -124,7 +127,7 @@ void NavigationZoom_Update_Hook(auto original, NavigationZoom *_this)
   }
 
   if (zoomDelta > 0.0f && config->use_presets_as_default && do_store_zoom) {
-    StoreZoom("System Preset Default from Preset", config->default_system_zoom, _this);
+    StoreZoom("System Preset Default from Preset", &Config::default_system_zoom, _this);
   }
 
   do_default_zoom = false;
@@ -135,11 +138,11 @@ void NavigationZoom_Update_Hook(auto original, NavigationZoom *_this)
 void NavigationZoom_SetViewParameters_Hook(auto original, NavigationZoom *_this, float radius, NodeDepth depth)
 {
   if (depth == NodeDepth::SolarSystem) {
-    auto ratio                     = (Config::Get().zoom / radius);
+    auto ratio                     = (Config::Get()->zoom / radius);
     _this->_farRatioSystemNormal   = 0.55f * ratio;
     _this->_farRatioSystemExtended = 1 * ratio;
     original(_this, radius, depth);
-    _this->_sceneCamera->farClipPlane = Config::Get().zoom * 2.75f;
+    _this->_sceneCamera->farClipPlane = Config::Get()->zoom * 2.75f;
     do_default_zoom                   = true;
   } else {
     original(_this, radius, depth);
@@ -149,11 +152,11 @@ void NavigationZoom_SetViewParameters_Hook(auto original, NavigationZoom *_this,
 void NavigationZoom_ApplyRangeChanges_Hook(auto original, NavigationZoom *_this)
 {
   if (_this->_depth == NodeDepth::SolarSystem) {
-    auto ratio                     = (Config::Get().zoom / _this->_viewRadius);
+    auto ratio                     = (Config::Get()->zoom / _this->_viewRadius);
     _this->_farRatioSystemNormal   = 0.55f * ratio;
     _this->_farRatioSystemExtended = 1 * ratio;
     original(_this);
-    _this->_sceneCamera->farClipPlane = Config::Get().zoom * 2.75f;
+    _this->_sceneCamera->farClipPlane = Config::Get()->zoom * 2.75f;
     do_default_zoom                   = true;
   } else {
     original(_this);
@@ -163,12 +166,12 @@ void NavigationZoom_ApplyRangeChanges_Hook(auto original, NavigationZoom *_this)
 void NavigationZoom_SetDepth_Hook(auto original, NavigationZoom *_this, NodeDepth depth)
 {
   if (depth == NodeDepth::SolarSystem) {
-    auto ratio                        = (Config::Get().zoom / _this->_viewRadius);
+    auto ratio                        = (Config::Get()->zoom / _this->_viewRadius);
     _this->_farRatioSystemNormal      = 0.55f * ratio;
     _this->_farRatioSystemExtended    = 1 * ratio;
-    _this->_sceneCamera->farClipPlane = Config::Get().zoom * 3.75f;
+    _this->_sceneCamera->farClipPlane = Config::Get()->zoom * 3.75f;
     original(_this, depth);
-    _this->_sceneCamera->farClipPlane = Config::Get().zoom * 3.75f;
+    _this->_sceneCamera->farClipPlane = Config::Get()->zoom * 3.75f;
     do_default_zoom                   = true;
   } else {
     original(_this, depth);
@@ -180,11 +183,11 @@ void NavigationCamera_SetSystemViewSizeData_Hook(auto original, uint8_t *_this_c
 {
   if (depth == NodeDepth::SolarSystem) {
     auto _this                     = *(NavigationZoom **)(_this_cam + 0x20);
-    auto ratio                     = (Config::Get().zoom / radius);
+    auto ratio                     = (Config::Get()->zoom / radius);
     _this->_farRatioSystemNormal   = 0.55f * ratio;
     _this->_farRatioSystemExtended = 1 * ratio;
     original(_this_cam, radius, systemPos, depth);
-    _this->_sceneCamera->farClipPlane = Config::Get().zoom * 2.75f;
+    _this->_sceneCamera->farClipPlane = Config::Get()->zoom * 2.75f;
     do_default_zoom                   = true;
   } else {
     original(_this_cam, radius, systemPos, depth);
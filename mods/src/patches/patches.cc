@@ -1,13 +1,16 @@
 #include "patches.h"
 #include "file.h"
+#include "logging.h"
 #include "version.h"
 
 #include <il2cpp/il2cpp-functions.h>
+#include <il2cpp/il2cpp_index.h>
+#include <il2cpp/il2cpp_symbol_cache.h>
 
-#include <spud/detour.h>
+#include "patches/hook_profiler.h"
+#include "patches/sync_metrics.h"
+#include "patches/trace_recorder.h"
 
-#include <spdlog/sinks/basic_file_sink.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
 #if _WIN32
@@ -15,9 +18,16 @@
 #else
 #include <dlfcn.h>
 #include <libgen.h>
+#if __APPLE__
 #include <mach-o/dyld.h>
+#else
+#include <climits>
+#include <unistd.h>
+#endif
 #endif
 
+#include <chrono>
+
 void InstallUiScaleHooks();
 void InstallZoomHooks();
 void InstallBuffFixHooks();
@@ -35,12 +45,16 @@ void InstallResolutionListFix();
 void InstallTempCrashFixes();
 void InstallSyncPatches();
 void InstallObjectTrackers();
+void InstallStateElisionHooks();
+void InstallSceneHooks();
+void InstallFrameHooks();
+void InstallUiStateHooks();
 
 __int64 il2cpp_init_hook(auto original, const char* domain_name)
 {
   struct PatchEntry {
-    const char*                  name;
-    std::pair<void (*)(), bool*> fnAndEnabled;
+    const char*                        name;
+    std::pair<void (*)(), const bool*> fnAndEnabled;
   };
 
 #if _WIN32
@@ -53,16 +67,10 @@ __int64 il2cpp_init_hook(auto original, const char* domain_name)
 
   File::Init();
 
-  auto file_logger = spdlog::basic_logger_mt("default", File::Log(), true);
-  auto sink        = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-  file_logger->sinks().push_back(sink);
-  spdlog::set_default_logger(file_logger);
-
   const auto log_level =
       File::hasTrace() ? spdlog::level::trace : (File::hasDebug() ? spdlog::level::debug : spdlog::level::info);
 
-  spdlog::set_level(log_level);
-  spdlog::flush_on(log_level);
+  Logging::Init(log_level);
 
   spdlog::info("Initializing STFC Community Patch ({})", VER_PRODUCT_VERSION_STR);
   spdlog::info("");
@@ -92,7 +100,8 @@ __int64 il2cpp_init_hook(auto original, const char* domain_name)
   spdlog::info("Loading Configuration...");
   spdlog::info("");
 
-  static auto& cfg = Config::Get();
+  const auto cfg = Config::Get();
+  Logging::Configure(*cfg);
 
   spdlog::info("");
   spdlog::info("=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=");
@@ -100,30 +109,57 @@ __int64 il2cpp_init_hook(auto original, const char* domain_name)
 
   spdlog::info("Initializing code hooks:");
   const PatchEntry patches[] = {
-      {"UiScaleHooks", {InstallUiScaleHooks, &cfg.installUiScaleHooks}},
-      {"ZoomHooks", {InstallZoomHooks, &cfg.installZoomHooks}},
-      {"BuffFixHooks", {InstallBuffFixHooks, &cfg.installBuffFixHooks}},
-      {"ToastBannerHooks", {InstallToastBannerHooks, &cfg.installToastBannerHooks}},
-      {"PanHooks", {InstallPanHooks, &cfg.installPanHooks}},
-      {"ImproveResponsivenessHooks", {InstallImproveResponsivenessHooks, &cfg.installImproveResponsivenessHooks}},
-      {"HotkeyHooks", {InstallHotkeyHooks, &cfg.installHotkeyHooks}},
+      {"UiScaleHooks", {InstallUiScaleHooks, &cfg->installUiScaleHooks}},
+      {"ZoomHooks", {InstallZoomHooks, &cfg->installZoomHooks}},
+      {"BuffFixHooks", {InstallBuffFixHooks, &cfg->installBuffFixHooks}},
+      {"ToastBannerHooks", {InstallToastBannerHooks, &cfg->installToastBannerHooks}},
+      {"PanHooks", {InstallPanHooks, &cfg->installPanHooks}},
+      {"ImproveResponsivenessHooks", {InstallImproveResponsivenessHooks, &cfg->installImproveResponsivenessHooks}},
+      {"HotkeyHooks", {InstallHotkeyHooks, &cfg->installHotkeyHooks}},
 #if _WIN32
-      {"FreeResizeHooks", {InstallFreeResizeHooks, &cfg.installFreeResizeHooks}},
+      {"FreeResizeHooks", {InstallFreeResizeHooks, &cfg->installFreeResizeHooks}},
 #endif
-      {"TempCrashFixes", {InstallTempCrashFixes, &cfg.installTempCrashFixes}},
-      {"TestPatches", {InstallTestPatches, &cfg.installTestPatches}},
-      {"MiscPatches", {InstallMiscPatches, &cfg.installMiscPatches}},
-      {"ChatPatches", {InstallChatPatches, &cfg.installChatPatches}},
-      {"ResolutionListFix", {InstallResolutionListFix, &cfg.installResolutionListFix}},
-      {"SyncPatches", {InstallSyncPatches, &cfg.installSyncPatches}},
-      {"ObjectTracker", {InstallObjectTrackers, &cfg.installObjectTracker}},
+      {"TempCrashFixes", {InstallTempCrashFixes, &cfg->installTempCrashFixes}},
+      {"TestPatches", {InstallTestPatches, &cfg->installTestPatches}},
+      {"MiscPatches", {InstallMiscPatches, &cfg->installMiscPatches}},
+      {"ChatPatches", {InstallChatPatches, &cfg->installChatPatches}},
+      {"ResolutionListFix", {InstallResolutionListFix, &cfg->installResolutionListFix}},
+      {"SyncPatches", {InstallSyncPatches, &cfg->installSyncPatches}},
+      {"ObjectTracker", {InstallObjectTrackers, &cfg->installObjectTracker}},
+      {"StateElisionHooks", {InstallStateElisionHooks, &cfg->installStateElisionHooks}},
   };
   printf("il2cpp_init_hook(%s)\n", domain_name);
 
   auto r = original(domain_name);
 
-  auto patch_count = 0;
-  auto patch_total = sizeof(patches) / sizeof(patches[0]);
+  Il2CppIndex::Build();
+  Il2CppSymbolCache::Load(std::filesystem::path(File::MakePath(File::Symbols())), VER_PRODUCT_VERSION_STR);
+
+  if (cfg->profile_hooks) {
+    HookProfiler::Start(cfg->profile_interval);
+  }
+
+  if (cfg->trace_events) {
+    TraceRecorder::Start(cfg->trace_seconds, cfg->trace_hitch_ms);
+  }
+
+  // metrics_port and stats_interval decide, the stats cover more than the sync targets
+  SyncMetrics::Start();
+
+  // always installed, MonoSingleton<T>::Instance relies on it to drop stale instances
+  InstallSceneHooks();
+
+  // always installed, the hotkey and zoom hooks read the UI state every frame
+  InstallUiStateHooks();
+
+  // always installed, the frame governor, memory manager, main thread queue and coroutines are driven from it
+  InstallFrameHooks();
+
+  using clock = std::chrono::steady_clock;
+
+  auto patch_count   = 0;
+  auto patch_total   = sizeof(patches) / sizeof(patches[0]);
+  auto install_start = clock::now();
 
   for (const auto& patch : patches) {
     patch_count++;
@@ -133,11 +169,21 @@ __int64 il2cpp_init_hook(auto original, const char* domain_name)
     spdlog::info(" {}ing {:>2} of {} ({})", patch_mode, patch_count, patch_total, patch.name);
 
     if (patch_install) {
+      const auto start = clock::now();
       patch_func();
+      spdlog::debug("   {} took {:.2f}ms", patch.name,
+                    std::chrono::duration<double, std::milli>(clock::now() - start).count());
     }
   }
 
   spdlog::info("");
+  spdlog::info("Hooks installed in {:.2f}ms",
+               std::chrono::duration<double, std::milli>(clock::now() - install_start).count());
+
+  Il2CppSymbolCache::Save(std::filesystem::path(File::MakePath(File::Symbols())));
+
+  // hooks stay as installed, everything else picks up edits to the settings file as they are saved
+  Config::Watch();
 
 #if VERSION_PATCH
   spdlog::info("Installed beta version {}.{}.{} (Patch {})", VERSION_MAJOR, VERSION_MINOR, VERSION_REVISION,
@@ -158,12 +204,18 @@ void ApplyPatches()
 #if _WIN32
   auto assembly = LoadLibraryA("GameAssembly.dll");
 #else
-  char     buf[PATH_MAX];
+  char buf[PATH_MAX] = {};
+#if __APPLE__
   uint32_t bufsize = PATH_MAX;
   _NSGetExecutablePath(buf, &bufsize);
+  const auto library = "../Frameworks/GameAssembly.dylib";
+#else
+  readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+  const auto library = "GameAssembly.so";
+#endif
 
   char assembly_path[PATH_MAX];
-  snprintf(assembly_path, sizeof(assembly_path), "%s/%s", dirname(buf), "../Frameworks/GameAssembly.dylib");
+  snprintf(assembly_path, sizeof(assembly_path), "%s/%s", dirname(buf), library);
   printf("Loading %s\n", assembly_path);
   auto assembly = dlopen(assembly_path, RTLD_LAZY | RTLD_GLOBAL);
 
@@ -0,0 +1,53 @@
+#include "config.h"
+#include "state_elision.h"
+#include "trace_recorder.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <string>
+
+std::array<bool, (size_t)StateElision::Filter::Count>     StateElision::enabled{};
+std::array<uint64_t, (size_t)StateElision::Filter::Count> StateElision::frame{};
+std::array<uint64_t, (size_t)StateElision::Filter::Count> StateElision::total{};
+
+static constexpr auto LogInterval = std::chrono::minutes(1);
+
+void StateElision::Update()
+{
+  static auto last_log = std::chrono::steady_clock::now();
+
+  {
+    const auto config = Config::Get();
+    StateElision::enabled[(size_t)Filter::SetActive]   = config->elide_set_active;
+    StateElision::enabled[(size_t)Filter::Transform]   = config->elide_transform;
+    StateElision::enabled[(size_t)Filter::CanvasAlpha] = config->elide_canvas_alpha;
+  }
+
+  uint64_t skipped = 0;
+  for (size_t i = 0; i < (size_t)Filter::Count; ++i) {
+    skipped += StateElision::frame[i];
+    StateElision::total[i] += StateElision::frame[i];
+    StateElision::frame[i] = 0;
+  }
+
+  if (skipped > 0) {
+    TraceRecorder::Instant("redundant state changes", "ui", (int64_t)skipped);
+  }
+
+  if (const auto now = std::chrono::steady_clock::now(); now - last_log >= LogInterval) {
+    last_log = now;
+
+    std::string totals;
+    for (size_t i = 0; i < (size_t)Filter::Count; ++i) {
+      totals += spdlog::fmt_lib::format("{}{} {}", totals.empty() ? "" : ", ", to_c_str((Filter)i),
+                                        StateElision::total[i]);
+    }
+    spdlog::debug("Redundant state changes skipped so far: {}", totals);
+  }
+}
+
+uint64_t StateElision::Total(Filter filter)
+{
+  return StateElision::total[(size_t)filter];
+}
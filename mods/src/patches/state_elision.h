@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Counts the Unity state changes the detours in patches/parts/state_elision.cc drop because they
+// would not change anything: activating an active object, moving a transform to where it is,
+// and so on. Each of those calls would otherwise dirty the object's canvas and have it rebuilt.
+// TMP_Text.text is left alone, its setter already returns early for the text it shows.
+class StateElision
+{
+public:
+  enum class Filter { SetActive, Transform, CanvasAlpha, Count };
+
+  // Main thread only, called by the detours
+  static void Skipped(Filter filter)
+  {
+    ++StateElision::frame[(size_t)filter];
+  }
+
+  // Main thread only, called by the detours. The elide_* switches as of the last Update, so the
+  // detours don't take a config snapshot on every call; all off until the first frame.
+  static bool Enabled(Filter filter)
+  {
+    return StateElision::enabled[(size_t)filter];
+  }
+
+  // Main thread only, once per frame. Adds the frame's counts to the totals, puts them in the
+  // trace, logs the totals once a minute and reads the elide_* switches.
+  static void Update();
+
+  static uint64_t Total(Filter filter);
+
+private:
+  static std::array<bool, (size_t)Filter::Count>     enabled;
+  static std::array<uint64_t, (size_t)Filter::Count> frame;
+  static std::array<uint64_t, (size_t)Filter::Count> total;
+};
+
+constexpr const char* to_c_str(StateElision::Filter filter)
+{
+  switch (filter) {
+    case StateElision::Filter::SetActive:
+      return "SetActive";
+    case StateElision::Filter::Transform:
+      return "Transform";
+    case StateElision::Filter::CanvasAlpha:
+      return "CanvasGroup.alpha";
+    case StateElision::Filter::Count:
+      break;
+  }
+
+  return "unknown";
+}
@@ -0,0 +1,199 @@
+#include "sync_capture.h"
+#include "config.h"
+#include "file.h"
+#include "trace_recorder.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// Records are queued by the hooks and written by one thread, which flushes at most this often
+static constexpr auto FlushInterval = std::chrono::seconds(1);
+
+// How long Shutdown waits for the writer to let go of the file
+static constexpr auto ShutdownTimeout = std::chrono::seconds(1);
+
+static std::mutex               queue_mtx;
+static std::condition_variable  queue_cv;
+static std::vector<std::string> queued_records;
+static bool                     writer_started = false;
+static bool                     stopped        = false;
+
+static std::timed_mutex file_mtx;
+static std::ofstream    capture_file;
+
+template <typename T> static void append_value(std::string& out, T value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T> static bool read_value(std::ifstream& in, T& value)
+{
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool SyncCapture::Enabled()
+{
+  return Config::Get()->sync_capture;
+}
+
+// Called with file_mtx held
+static void write_records(const std::vector<std::string>& records)
+{
+  if (!capture_file.is_open()) {
+    capture_file.open(std::filesystem::path(File::MakePath(File::Capture())),
+                      std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!capture_file) {
+      spdlog::error("Failed to open sync capture file {}", File::Capture());
+      return;
+    }
+
+    capture_file.write(SyncCapture::Magic.data(), SyncCapture::Magic.size());
+    spdlog::info("Capturing sync payloads to {}", File::Capture());
+  }
+
+  for (const auto& record : records) {
+    capture_file.write(record.data(), record.size());
+  }
+}
+
+static void capture_writer_thread()
+{
+  TraceRecorder::NameThread("sync capture");
+
+  auto                     last_flush = std::chrono::steady_clock::now();
+  std::vector<std::string> records;
+
+  for (;;) {
+    std::unique_lock<std::timed_mutex> file_lk;
+
+    {
+      std::unique_lock lk(queue_mtx);
+      queue_cv.wait_for(lk, FlushInterval, [] { return stopped || !queued_records.empty(); });
+
+      if (stopped) {
+        break;
+      }
+
+      records.swap(queued_records);
+
+      // Taken before the queue is let go, so Shutdown's leftovers are written after this batch
+      file_lk = std::unique_lock(file_mtx);
+    }
+
+    write_records(records);
+    records.clear();
+
+    if (const auto now = std::chrono::steady_clock::now(); now - last_flush >= FlushInterval) {
+      last_flush = now;
+      if (capture_file.is_open()) {
+        capture_file.flush();
+      }
+    }
+  }
+}
+
+void SyncCapture::Write(int32_t type, std::string_view target, std::string_view payload)
+{
+  const auto timestamp =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+          .count();
+
+  const auto length = sizeof(int32_t) + sizeof(int64_t) + sizeof(uint32_t) + target.size() + payload.size();
+
+  std::string record;
+  record.reserve(sizeof(uint32_t) + length);
+  append_value(record, static_cast<uint32_t>(length));
+  append_value(record, type);
+  append_value(record, static_cast<int64_t>(timestamp));
+  append_value(record, static_cast<uint32_t>(target.size()));
+  record.append(target);
+  record.append(payload);
+
+  {
+    std::lock_guard lk(queue_mtx);
+    if (stopped) {
+      return;
+    }
+
+    queued_records.emplace_back(std::move(record));
+
+    if (!writer_started) {
+      writer_started = true;
+      std::thread(capture_writer_thread).detach();
+    }
+  }
+
+  queue_cv.notify_one();
+}
+
+void SyncCapture::Shutdown()
+{
+  std::vector<std::string> records;
+
+  {
+    std::lock_guard lk(queue_mtx);
+    stopped = true;
+    records.swap(queued_records);
+  }
+
+  queue_cv.notify_one();
+
+  // The writer may be gone already, or stuck in a write the process is being torn down under
+  std::unique_lock lk(file_mtx, ShutdownTimeout);
+  if (!lk.owns_lock()) {
+    return;
+  }
+
+  if (!records.empty()) {
+    write_records(records);
+  }
+
+  if (capture_file.is_open()) {
+    capture_file.close();
+  }
+}
+
+std::vector<SyncCapture::Entry> SyncCapture::Read(const std::filesystem::path& path)
+{
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("unable to open " + path.string());
+  }
+
+  std::string magic(Magic.size(), '\0');
+  if (!in.read(magic.data(), magic.size()) || magic != Magic) {
+    throw std::runtime_error(path.string() + " is not a sync capture");
+  }
+
+  std::vector<Entry> entries;
+  uint32_t           length;
+
+  while (read_value(in, length)) {
+    Entry    entry;
+    uint32_t target_length;
+
+    constexpr auto header_length = sizeof(int32_t) + sizeof(int64_t) + sizeof(uint32_t);
+    if (length < header_length || !read_value(in, entry.type) || !read_value(in, entry.timestamp)
+        || !read_value(in, target_length) || target_length > length - header_length) {
+      throw std::runtime_error(path.string() + " is truncated or corrupt");
+    }
+
+    entry.target.resize(target_length);
+    entry.payload.resize(length - header_length - target_length);
+
+    if (!in.read(entry.target.data(), entry.target.size()) || !in.read(entry.payload.data(), entry.payload.size())) {
+      throw std::runtime_error(path.string() + " is truncated or corrupt");
+    }
+
+    entries.emplace_back(std::move(entry));
+  }
+
+  return entries;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Records raw sync payloads so they can be replayed through the processors without the game.
+//
+// File layout: the 8 byte magic, then one record per payload:
+//   uint32 length of the rest of the record
+//   int32  EntityGroup::Type, RtcType for realtime payloads or ScopelyType for game server responses
+//   int64  capture time in milliseconds since the epoch
+//   uint32 target length, followed by the target (RTC, and the path and request body of game
+//          server requests, separated by a newline)
+//   payload bytes
+class SyncCapture
+{
+public:
+  static constexpr int32_t          RtcType     = -1;
+  static constexpr int32_t          ScopelyType = -2;
+  static constexpr std::string_view Magic       = "STFCCAP1";
+
+  struct Entry {
+    int32_t     type;
+    int64_t     timestamp;
+    std::string target;
+    std::string payload;
+  };
+
+  static bool Enabled();
+  // Queues the record for the writer thread, which flushes the file once a second
+  static void Write(int32_t type, std::string_view target, std::string_view payload);
+  // Writes what is still queued and closes the file, later records are dropped
+  static void Shutdown();
+
+  static std::vector<Entry> Read(const std::filesystem::path& path);
+};
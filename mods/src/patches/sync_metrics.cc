@@ -0,0 +1,435 @@
+#if _WIN32
+// winsock2 must be seen before windows.h (pulled in through config.h)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include "sync_metrics.h"
+#include "file.h"
+#include "trace_recorder.h"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if _WIN32
+using socket_t = SOCKET;
+#else
+using socket_t                    = int;
+constexpr socket_t INVALID_SOCKET = -1;
+#define closesocket close
+#endif
+
+using Labels    = std::vector<std::pair<std::string, std::string>>;
+using MetricKey = std::pair<std::string, Labels>;
+
+struct MetricInfo {
+  std::string_view name;
+  std::string_view type;
+  std::string_view help;
+};
+
+// Prometheus names, kept in the order they are exported
+static constexpr std::array metric_info{
+    MetricInfo{"stfc_sync_entity_groups_total", "counter", "Entity groups seen by the sync hooks, by group type"},
+    MetricInfo{"stfc_sync_parse_seconds", "histogram", "Time spent parsing entity group payloads"},
+    MetricInfo{"stfc_sync_diff_seconds", "histogram", "Time spent diffing parsed payloads against the last sent state"},
+    MetricInfo{"stfc_sync_records_total", "counter", "Records emitted to the sync queue"},
+    MetricInfo{"stfc_sync_queue_depth", "gauge", "Pending requests per target"},
+    MetricInfo{"stfc_sync_sent_bytes_total", "counter", "Request body bytes sent per target"},
+    MetricInfo{"stfc_sync_http_request_seconds", "histogram", "Sync request latency per target"},
+    MetricInfo{"stfc_sync_http_responses_total", "counter", "Sync responses per target and status code"},
+    MetricInfo{"stfc_sync_dropped_total", "counter", "Sync payloads dropped per target and reason"},
+    MetricInfo{"stfc_gc_heap_bytes", "gauge", "Managed heap size, in total and in use"},
+    MetricInfo{"stfc_gc_collections_total", "counter", "Collections and asset unloads run by the mod, by reason"},
+    MetricInfo{"stfc_gc_collection_seconds", "histogram", "Time the main thread spent in those collections"},
+};
+
+static constexpr std::array histogram_buckets{0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 2.5, 5.0, 10.0};
+
+struct Histogram {
+  std::array<uint64_t, histogram_buckets.size()> buckets{};
+  uint64_t                                       count = 0;
+  double                                         sum   = 0.0;
+
+  void observe(double value)
+  {
+    for (size_t i = 0; i < histogram_buckets.size(); ++i) {
+      if (value <= histogram_buckets[i]) {
+        ++buckets[i];
+        break;
+      }
+    }
+
+    ++count;
+    sum += value;
+  }
+};
+
+static std::mutex                     metrics_mtx;
+static std::map<MetricKey, double>    counters;
+static std::map<MetricKey, double>    gauges;
+static std::map<MetricKey, Histogram> histograms;
+
+static void add_counter(std::string_view name, Labels&& labels, double value)
+{
+  std::lock_guard lk(metrics_mtx);
+  counters[{std::string(name), std::move(labels)}] += value;
+}
+
+static void set_gauge(std::string_view name, Labels&& labels, double value)
+{
+  std::lock_guard lk(metrics_mtx);
+  gauges[{std::string(name), std::move(labels)}] = value;
+}
+
+static void observe(std::string_view name, Labels&& labels, double value)
+{
+  std::lock_guard lk(metrics_mtx);
+  histograms[{std::string(name), std::move(labels)}].observe(value);
+}
+
+SyncMetrics::Stopwatch::Stopwatch(SyncConfig::Type type)
+    : type(type)
+    , start(std::chrono::steady_clock::now())
+{
+}
+
+void SyncMetrics::Stopwatch::Parsed()
+{
+  const auto now = std::chrono::steady_clock::now();
+  observe("stfc_sync_parse_seconds", {{"type", to_string(this->type)}},
+          std::chrono::duration<double>(now - this->start).count());
+  TraceRecorder::Complete("parse", "sync", this->start, now, to_c_str(this->type));
+  this->start = now;
+}
+
+void SyncMetrics::Stopwatch::Diffed()
+{
+  const auto now = std::chrono::steady_clock::now();
+  observe("stfc_sync_diff_seconds", {{"type", to_string(this->type)}},
+          std::chrono::duration<double>(now - this->start).count());
+  TraceRecorder::Complete("diff", "sync", this->start, now, to_c_str(this->type));
+  this->start = now;
+}
+
+void SyncMetrics::CountEntityGroup(int type)
+{
+  add_counter("stfc_sync_entity_groups_total", {{"type", std::to_string(type)}}, 1);
+}
+
+void SyncMetrics::CountRecords(SyncConfig::Type type, size_t count)
+{
+  add_counter("stfc_sync_records_total", {{"type", to_string(type)}}, static_cast<double>(count));
+}
+
+void SyncMetrics::CountBytes(std::string_view target, size_t raw, size_t wire)
+{
+  add_counter("stfc_sync_sent_bytes_total", {{"target", std::string(target)}, {"encoding", "raw"}},
+              static_cast<double>(raw));
+  add_counter("stfc_sync_sent_bytes_total", {{"target", std::string(target)}, {"encoding", "wire"}},
+              static_cast<double>(wire));
+}
+
+void SyncMetrics::CountResponse(std::string_view target, long status_code, double seconds)
+{
+  add_counter("stfc_sync_http_responses_total", {{"target", std::string(target)}, {"code", std::to_string(status_code)}},
+              1);
+  observe("stfc_sync_http_request_seconds", {{"target", std::string(target)}}, seconds);
+}
+
+void SyncMetrics::CountDrop(std::string_view target, std::string_view reason)
+{
+  add_counter("stfc_sync_dropped_total", {{"target", std::string(target)}, {"reason", std::string(reason)}}, 1);
+}
+
+void SyncMetrics::SetQueueDepth(std::string_view target, size_t depth)
+{
+  set_gauge("stfc_sync_queue_depth", {{"target", std::string(target)}}, static_cast<double>(depth));
+}
+
+void SyncMetrics::SetHeapSize(int64_t heap, int64_t used)
+{
+  set_gauge("stfc_gc_heap_bytes", {{"kind", "heap"}}, static_cast<double>(heap));
+  set_gauge("stfc_gc_heap_bytes", {{"kind", "used"}}, static_cast<double>(used));
+}
+
+void SyncMetrics::CountCollection(std::string_view kind, std::string_view reason, double seconds)
+{
+  add_counter("stfc_gc_collections_total", {{"kind", std::string(kind)}, {"reason", std::string(reason)}}, 1);
+  observe("stfc_gc_collection_seconds", {{"kind", std::string(kind)}}, seconds);
+}
+
+static std::string format_labels(const Labels& labels, std::string_view extra_name = {}, std::string_view extra = {})
+{
+  if (labels.empty() && extra_name.empty()) {
+    return {};
+  }
+
+  std::string out = "{";
+
+  auto append = [&out](std::string_view name, std::string_view value) {
+    if (out.size() > 1) {
+      out += ',';
+    }
+
+    out += name;
+    out += "=\"";
+    for (const auto c : value) {
+      switch (c) {
+        case '\\':
+          out += "\\\\";
+          break;
+        case '"':
+          out += "\\\"";
+          break;
+        case '\n':
+          out += "\\n";
+          break;
+        default:
+          out += c;
+      }
+    }
+    out += '"';
+  };
+
+  for (const auto& [name, value] : labels) {
+    append(name, value);
+  }
+
+  if (!extra_name.empty()) {
+    append(extra_name, extra);
+  }
+
+  return out + "}";
+}
+
+static std::string format_value(double value)
+{
+  return nlohmann::json(value).dump();
+}
+
+std::string SyncMetrics::ToPrometheus()
+{
+  std::lock_guard lk(metrics_mtx);
+  std::string     out;
+
+  for (const auto& info : metric_info) {
+    out += "# HELP " + std::string(info.name) + " " + std::string(info.help) + "\n";
+    out += "# TYPE " + std::string(info.name) + " " + std::string(info.type) + "\n";
+
+    const auto& values = info.type == "gauge" ? gauges : counters;
+
+    if (info.type != "histogram") {
+      for (auto it = values.lower_bound({std::string(info.name), {}}); it != values.end() && it->first.first == info.name;
+           ++it) {
+        out += std::string(info.name) + format_labels(it->first.second) + " " + format_value(it->second) + "\n";
+      }
+      continue;
+    }
+
+    for (auto it = histograms.lower_bound({std::string(info.name), {}});
+         it != histograms.end() && it->first.first == info.name; ++it) {
+      const auto& [key, histogram] = *it;
+
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < histogram_buckets.size(); ++i) {
+        cumulative += histogram.buckets[i];
+        out += std::string(info.name) + "_bucket"
+               + format_labels(key.second, "le", format_value(histogram_buckets[i])) + " "
+               + std::to_string(cumulative) + "\n";
+      }
+
+      out += std::string(info.name) + "_bucket" + format_labels(key.second, "le", "+Inf") + " "
+             + std::to_string(histogram.count) + "\n";
+      out += std::string(info.name) + "_sum" + format_labels(key.second) + " " + format_value(histogram.sum) + "\n";
+      out += std::string(info.name) + "_count" + format_labels(key.second) + " " + std::to_string(histogram.count)
+             + "\n";
+    }
+  }
+
+  return out;
+}
+
+std::string SyncMetrics::ToJson()
+{
+  using json = nlohmann::json;
+
+  auto labels_json = [](const Labels& labels) {
+    auto out = json::object();
+    for (const auto& [name, value] : labels) {
+      out[name] = value;
+    }
+    return out;
+  };
+
+  std::lock_guard lk(metrics_mtx);
+
+  auto metrics = json::object();
+
+  for (const auto& info : metric_info) {
+    auto entries = json::array();
+
+    if (info.type == "histogram") {
+      for (auto it = histograms.lower_bound({std::string(info.name), {}});
+           it != histograms.end() && it->first.first == info.name; ++it) {
+        const auto& [key, histogram] = *it;
+
+        auto buckets = json::object();
+        for (size_t i = 0; i < histogram_buckets.size(); ++i) {
+          buckets[format_value(histogram_buckets[i])] = histogram.buckets[i];
+        }
+
+        entries.push_back({{"labels", labels_json(key.second)},
+                           {"count", histogram.count},
+                           {"sum", histogram.sum},
+                           {"buckets", buckets}});
+      }
+    } else {
+      const auto& values = info.type == "gauge" ? gauges : counters;
+      for (auto it = values.lower_bound({std::string(info.name), {}}); it != values.end() && it->first.first == info.name;
+           ++it) {
+        entries.push_back({{"labels", labels_json(it->first.second)}, {"value", it->second}});
+      }
+    }
+
+    metrics[std::string(info.name)] = std::move(entries);
+  }
+
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+  return json{{"timestamp", std::chrono::duration_cast<std::chrono::seconds>(now).count()}, {"metrics", metrics}}
+      .dump(2);
+}
+
+static void write_stats_file(int interval)
+{
+  const std::filesystem::path stats_path = File::MakePath(File::Stats());
+  auto                        temp_path  = stats_path;
+  temp_path += ".tmp";
+
+  for (;;) {
+    std::this_thread::sleep_for(std::chrono::seconds(interval));
+
+    try {
+      {
+        std::ofstream stats_file(temp_path, std::ios::trunc);
+        stats_file << SyncMetrics::ToJson();
+      }
+
+      std::error_code ec;
+      std::filesystem::rename(temp_path, stats_path, ec);
+      if (ec) {
+        spdlog::warn("Failed to write sync stats to {}: {}", File::Stats(), ec.message());
+      }
+    } catch (const std::exception& e) {
+      spdlog::warn("Failed to write sync stats to {}: {}", File::Stats(), e.what());
+    }
+  }
+}
+
+// A scraper that connects and then says nothing, or stops reading, is dropped after this long
+// instead of holding up the requests behind it
+static constexpr int ClientTimeoutMs = 2000;
+
+static void set_client_timeout(socket_t client)
+{
+#if _WIN32
+  const DWORD timeout = ClientTimeoutMs;
+#else
+  const timeval timeout{.tv_sec = ClientTimeoutMs / 1000, .tv_usec = (ClientTimeoutMs % 1000) * 1000};
+#endif
+  setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+  setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+}
+
+static void serve_metrics(socket_t listener)
+{
+  for (;;) {
+    const socket_t client = accept(listener, nullptr, nullptr);
+    if (client == INVALID_SOCKET) {
+      continue;
+    }
+
+    set_client_timeout(client);
+
+    char       request[1024];
+    const auto received = recv(client, request, sizeof(request) - 1, 0);
+    if (received <= 0) {
+      // Timed out or closed before sending a request
+      closesocket(client);
+      continue;
+    }
+
+    std::string response;
+    if (std::string_view(request, received).starts_with("GET /metrics")) {
+      const auto body = SyncMetrics::ToPrometheus();
+      response        = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: "
+                 + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    } else {
+      response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+
+    send(client, response.data(), static_cast<int>(response.size()), 0);
+    closesocket(client);
+  }
+}
+
+static bool start_metrics_server(int port)
+{
+#if _WIN32
+  WSADATA wsa_data;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+    return false;
+  }
+#endif
+
+  const socket_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (listener == INVALID_SOCKET) {
+    return false;
+  }
+
+  sockaddr_in address{};
+  address.sin_family      = AF_INET;
+  address.sin_port        = htons(static_cast<uint16_t>(port));
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 4) != 0) {
+    closesocket(listener);
+    return false;
+  }
+
+  std::thread(serve_metrics, listener).detach();
+  return true;
+}
+
+void SyncMetrics::Start()
+{
+  const auto config = Config::Get();
+
+  if (config->sync_stats_interval > 0) {
+    std::thread(write_stats_file, config->sync_stats_interval).detach();
+    spdlog::info("Writing sync stats to {} every {}s", File::Stats(), config->sync_stats_interval);
+  }
+
+  if (config->sync_metrics_port > 0) {
+    if (start_metrics_server(config->sync_metrics_port)) {
+      spdlog::info("Serving sync metrics on http://127.0.0.1:{}/metrics", config->sync_metrics_port);
+    } else {
+      spdlog::error("Failed to start sync metrics server on port {}", config->sync_metrics_port);
+    }
+  }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "config.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class SyncMetrics
+{
+public:
+  // Measures the parse and diff stages of a sync processor
+  class Stopwatch
+  {
+  public:
+    explicit Stopwatch(SyncConfig::Type type);
+
+    void Parsed();
+    void Diffed();
+
+  private:
+    SyncConfig::Type                      type;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  static void Start();
+
+  static void CountEntityGroup(int type);
+  static void CountRecords(SyncConfig::Type type, size_t count);
+  static void CountBytes(std::string_view target, size_t raw, size_t wire);
+  static void CountResponse(std::string_view target, long status_code, double seconds);
+  static void CountDrop(std::string_view target, std::string_view reason);
+  static void SetQueueDepth(std::string_view target, size_t depth);
+
+  // Managed heap, from the memory manager
+  static void SetHeapSize(int64_t heap, int64_t used);
+  static void CountCollection(std::string_view kind, std::string_view reason, double seconds);
+
+  static std::string ToPrometheus();
+  static std::string ToJson();
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "config.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Entry points for driving the sync processors without the game, used by tools/sync_replay
+namespace SyncReplay
+{
+using RecordSink = std::function<void(SyncConfig::Type type, const nlohmann::json& records)>;
+
+// Hands queued records to the sink instead of the HTTP workers
+void SetRecordSink(RecordSink sink);
+
+// Run the matching processor on the calling thread, false when no processor handles the payload
+bool ProcessEntityGroup(int32_t type, std::unique_ptr<std::string>&& payload);
+bool ProcessRtc(std::string_view target, std::unique_ptr<std::string>&& payload);
+
+// Answers the game server requests the combat log worker makes with a captured response
+void AddScopelyResponse(std::string_view target, std::string response);
+
+// Ships the combat logs the battle processors queued on the calling thread, returns how many
+size_t DrainCombatLogs();
+} // namespace SyncReplay
@@ -0,0 +1,331 @@
+#include "trace_recorder.h"
+#include "file.h"
+#include "hook_profiler.h"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr size_t EventsPerThread = 1 << 14;
+
+struct TraceEvent {
+  std::atomic<int64_t>     start_ns{0};
+  std::atomic<int64_t>     duration_ns{0}; // negative for instant events
+  std::atomic<int64_t>     value{0};
+  std::atomic<const char*> name{nullptr};
+  std::atomic<const char*> category{nullptr};
+  std::atomic<const char*> detail{nullptr};
+  std::atomic<uint32_t>    tid{0};
+};
+
+// Written by the thread that owns it, copied out by the dump thread. head counts every event ever
+// written to the ring, event i lives in events[i % EventsPerThread]. A ring is handed to the next
+// new thread once its owner exits, short lived threads like the sync processors would otherwise
+// leave a ring each behind.
+struct TraceRing {
+  std::atomic<uint64_t>                   head{0};
+  std::atomic<bool>                       owned{true};
+  std::array<TraceEvent, EventsPerThread> events;
+};
+
+struct RingOwner {
+  TraceRing* ring = nullptr;
+
+  ~RingOwner()
+  {
+    if (this->ring) {
+      this->ring->owned.store(false, std::memory_order_release);
+    }
+  }
+};
+
+bool TraceRecorder::enabled = false;
+
+static const TraceRecorder::clock::time_point origin = TraceRecorder::clock::now();
+
+static std::vector<std::unique_ptr<TraceRing>> rings;
+static std::map<uint32_t, std::string>         thread_names;
+static std::mutex                              rings_mtx;
+
+static std::atomic<uint32_t>  next_tid{1};
+static thread_local uint32_t  local_tid = 0;
+static thread_local RingOwner local_ring;
+
+static std::chrono::nanoseconds window{};
+static std::chrono::nanoseconds hitch{};
+
+static std::mutex              dump_mtx;
+static std::condition_variable dump_cv;
+static const char*             dump_reason = nullptr;
+
+static int64_t since_origin(TraceRecorder::clock::time_point time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin).count();
+}
+
+static uint32_t thread_id()
+{
+  if (local_tid == 0) [[unlikely]] {
+    local_tid = next_tid.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return local_tid;
+}
+
+static TraceRing& thread_ring()
+{
+  if (local_ring.ring == nullptr) [[unlikely]] {
+    std::lock_guard lk(rings_mtx);
+
+    for (const auto& ring : rings) {
+      if (!ring->owned.load(std::memory_order_acquire)) {
+        ring->owned.store(true, std::memory_order_relaxed);
+        local_ring.ring = ring.get();
+        break;
+      }
+    }
+
+    if (local_ring.ring == nullptr) {
+      local_ring.ring = rings.emplace_back(std::make_unique<TraceRing>()).get();
+    }
+  }
+
+  return *local_ring.ring;
+}
+
+static void record(const char* name, const char* category, const char* detail, int64_t start_ns, int64_t duration_ns,
+                   int64_t value)
+{
+  auto&      ring  = thread_ring();
+  const auto index = ring.head.load(std::memory_order_relaxed);
+  auto&      event = ring.events[index % EventsPerThread];
+
+  // Pairs with the fence in collect: a reader that sees any of the stores below also sees the head
+  // from the previous event, which tells it the slot is being overwritten
+  std::atomic_thread_fence(std::memory_order_release);
+
+  event.start_ns.store(start_ns, std::memory_order_relaxed);
+  event.duration_ns.store(duration_ns, std::memory_order_relaxed);
+  event.value.store(value, std::memory_order_relaxed);
+  event.name.store(name, std::memory_order_relaxed);
+  event.category.store(category, std::memory_order_relaxed);
+  event.detail.store(detail, std::memory_order_relaxed);
+  event.tid.store(thread_id(), std::memory_order_relaxed);
+
+  ring.head.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::Complete(const char* name, const char* category, clock::time_point start, clock::time_point end,
+                             const char* detail)
+{
+  if (!TraceRecorder::enabled) {
+    return;
+  }
+
+  const auto start_ns = since_origin(start);
+  record(name, category, detail, start_ns, std::max<int64_t>(since_origin(end) - start_ns, 0), 0);
+}
+
+void TraceRecorder::Instant(const char* name, const char* category, int64_t value)
+{
+  if (!TraceRecorder::enabled) {
+    return;
+  }
+
+  record(name, category, nullptr, since_origin(clock::now()), -1, value);
+}
+
+void TraceRecorder::NameThread(std::string name)
+{
+  const auto tid = thread_id();
+
+  std::lock_guard lk(rings_mtx);
+  thread_names.insert_or_assign(tid, std::move(name));
+}
+
+struct CollectedEvent {
+  int64_t     start_ns;
+  int64_t     duration_ns;
+  int64_t     value;
+  const char* name;
+  const char* category;
+  const char* detail;
+  uint32_t    tid;
+};
+
+// Copies the events of one ring that end after cutoff_ns, skipping any the owner overwrote meanwhile
+static void collect(const TraceRing& ring, int64_t cutoff_ns, std::vector<CollectedEvent>& out)
+{
+  const auto head  = ring.head.load(std::memory_order_acquire);
+  const auto first = head > EventsPerThread ? head - EventsPerThread : 0;
+
+  std::vector<CollectedEvent> copied;
+  copied.reserve(head - first);
+  for (auto i = first; i < head; ++i) {
+    const auto& event = ring.events[i % EventsPerThread];
+    copied.push_back({event.start_ns.load(std::memory_order_relaxed), event.duration_ns.load(std::memory_order_relaxed),
+                      event.value.load(std::memory_order_relaxed), event.name.load(std::memory_order_relaxed),
+                      event.category.load(std::memory_order_relaxed), event.detail.load(std::memory_order_relaxed),
+                      event.tid.load(std::memory_order_relaxed)});
+  }
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  // The owner may be part way through writing event `after`, which reuses the slot of after - EventsPerThread
+  const auto after = ring.head.load(std::memory_order_relaxed);
+  const auto valid = after >= EventsPerThread ? after - EventsPerThread + 1 : 0;
+
+  for (auto i = std::max(first, valid); i < head; ++i) {
+    const auto& event = copied[i - first];
+    if (event.start_ns + std::max<int64_t>(event.duration_ns, 0) >= cutoff_ns) {
+      out.push_back(event);
+    }
+  }
+}
+
+static void write_trace_file(const char* reason)
+{
+  using json = nlohmann::json;
+
+  const auto cutoff_ns = since_origin(TraceRecorder::clock::now() - window);
+
+  std::vector<CollectedEvent> events;
+  std::map<uint32_t, std::string> names;
+  {
+    std::lock_guard lk(rings_mtx);
+    for (const auto& ring : rings) {
+      collect(*ring, cutoff_ns, events);
+    }
+    names = thread_names;
+  }
+
+  std::ranges::sort(events, {}, &CollectedEvent::start_ns);
+
+  auto trace_events = json::array();
+  trace_events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", 1}, {"args", {{"name", "STFC"}}}});
+  for (const auto& [tid, name] : names) {
+    trace_events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", tid}, {"args", {{"name", name}}}});
+  }
+
+  for (const auto& event : events) {
+    json entry{{"name", event.name}, {"cat", event.category}, {"pid", 1}, {"tid", event.tid},
+               {"ts", event.start_ns / 1e3}};
+
+    if (event.duration_ns < 0) {
+      entry["ph"]   = "i";
+      entry["s"]    = "t";
+      entry["args"] = {{"value", event.value}};
+    } else {
+      entry["ph"]  = "X";
+      entry["dur"] = event.duration_ns / 1e3;
+      if (event.detail) {
+        entry["args"] = {{"detail", event.detail}};
+      }
+    }
+
+    trace_events.push_back(std::move(entry));
+  }
+
+  const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+
+  std::filesystem::path trace_path = File::MakePath(File::Trace());
+  const auto            extension  = trace_path.extension();
+  trace_path.replace_filename(trace_path.stem().string() + "-" + reason + "-" + std::to_string(timestamp));
+  trace_path += extension;
+
+  try {
+    std::ofstream trace_file(trace_path, std::ios::trunc);
+    trace_file << json{{"displayTimeUnit", "ms"}, {"traceEvents", trace_events}}.dump();
+    spdlog::info("Wrote {} trace events to {}", events.size(), trace_path.string());
+  } catch (const std::exception& e) {
+    spdlog::warn("Failed to write trace to {}: {}", trace_path.string(), e.what());
+  }
+}
+
+static void dump_thread()
+{
+  for (;;) {
+    const char* reason;
+    {
+      std::unique_lock lk(dump_mtx);
+      dump_cv.wait(lk, [] { return dump_reason != nullptr; });
+      reason      = dump_reason;
+      dump_reason = nullptr;
+    }
+
+    write_trace_file(reason);
+  }
+}
+
+void TraceRecorder::Start(int seconds, int hitch_ms)
+{
+  window = std::chrono::seconds(std::max(seconds, 1));
+  hitch  = std::chrono::milliseconds(std::max(hitch_ms, 0));
+
+  TraceRecorder::enabled = true;
+
+  // Hook events come from the profiler's wrapper
+  HookProfiler::enabled = true;
+
+  std::thread(dump_thread).detach();
+
+  if (hitch_ms > 0) {
+    spdlog::info("Tracing, keeping the last {}s and dumping frames over {}ms", std::max(seconds, 1), hitch_ms);
+  } else {
+    spdlog::info("Tracing, keeping the last {}s", std::max(seconds, 1));
+  }
+}
+
+void TraceRecorder::Frame()
+{
+  if (!TraceRecorder::enabled) {
+    return;
+  }
+
+  static clock::time_point last_frame;
+  static clock::time_point last_hitch;
+
+  const auto now = clock::now();
+  if (last_frame == clock::time_point{}) {
+    TraceRecorder::NameThread("main");
+  } else {
+    TraceRecorder::Complete("frame", "frame", last_frame, now);
+
+    // At most one hitch dump per window, the next one would mostly repeat it
+    if (hitch.count() > 0 && now - last_frame > hitch
+        && (last_hitch == clock::time_point{} || now - last_hitch >= window)) {
+      last_hitch = now;
+      TraceRecorder::Dump("hitch");
+    }
+  }
+
+  last_frame = now;
+}
+
+void TraceRecorder::Dump(const char* reason)
+{
+  if (!TraceRecorder::enabled) {
+    spdlog::info("Tracing is off, set trace_events in [control] to record a trace");
+    return;
+  }
+
+  {
+    std::lock_guard lk(dump_mtx);
+    dump_reason = reason;
+  }
+
+  dump_cv.notify_one();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Timeline of the last few seconds ([control] trace_events), written as Chrome trace event JSON
+// that chrome://tracing and ui.perfetto.dev open directly.
+//
+// Every thread records into its own ring of events, so recording never takes a lock and old events
+// are overwritten rather than piling up. A dump copies whatever is still in the rings and covers
+// the last trace_seconds. Dumps are written by a background thread, either from the dump_trace
+// hotkey or when a frame takes longer than trace_hitch_ms.
+class TraceRecorder
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  // Records one complete event from construction to destruction. Names are not copied, pass literals.
+  class Scope
+  {
+  public:
+    explicit Scope(const char* name, const char* category, const char* detail = nullptr)
+        : name(name)
+        , category(category)
+        , detail(detail)
+        , active(TraceRecorder::enabled)
+    {
+      if (this->active) {
+        this->start = clock::now();
+      }
+    }
+
+    ~Scope()
+    {
+      if (this->active) {
+        TraceRecorder::Complete(this->name, this->category, this->start, clock::now(), this->detail);
+      }
+    }
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    const char*       name;
+    const char*       category;
+    const char*       detail;
+    bool              active;
+    clock::time_point start;
+  };
+
+  static void Complete(const char* name, const char* category, clock::time_point start, clock::time_point end,
+                       const char* detail = nullptr);
+  static void Instant(const char* name, const char* category, int64_t value);
+
+  // Shown in place of the thread id in the viewer
+  static void NameThread(std::string name);
+
+  static void Start(int seconds, int hitch_ms);
+
+  // Call once per frame from the main thread, records the frame and checks it against the hitch threshold
+  static void Frame();
+
+  static void Dump(const char* reason);
+
+  static bool enabled;
+};
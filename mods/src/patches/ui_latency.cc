@@ -0,0 +1,103 @@
+#include "errormsg.h"
+
+#include "ui_latency.h"
+#include "config.h"
+#include "trace_recorder.h"
+
+#include "prime/Tween.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+using latency_clock = TraceRecorder::clock;
+
+// A section change this long after the last input is not taken as caused by it
+static constexpr auto InputWindow = std::chrono::milliseconds(500);
+
+// Screens that keep animating are given up on
+static constexpr auto MaxLatency = std::chrono::seconds(10);
+
+struct Measurement {
+  SectionID                 section;
+  latency_clock::time_point input;
+  // Tweens playing the frame before, the screen is ready once no more than these are left
+  int tweens_before;
+};
+
+struct SectionLatency {
+  uint64_t                 count = 0;
+  std::chrono::nanoseconds total{};
+};
+
+static latency_clock::time_point               last_input;
+static int                                     tweens_last_frame = 0;
+static std::optional<Measurement>              measuring;
+static std::unordered_map<int, SectionLatency> latencies;
+
+// Input is true for the whole frame it happened in, whichever of the section change and Update
+// runs first sees it
+static bool any_key_down()
+{
+  static auto get_anyKeyDown = il2cpp_resolve_icall_typed<bool()>("UnityEngine.Input::get_anyKeyDown()");
+  return get_anyKeyDown && get_anyKeyDown();
+}
+
+void UiLatency::OnSectionChanged(SectionID section)
+{
+  const auto now = latency_clock::now();
+  if (any_key_down()) {
+    last_input = now;
+  }
+
+  if (last_input != latency_clock::time_point{} && now - last_input <= InputWindow) {
+    measuring = Measurement{section, last_input, tweens_last_frame};
+  }
+}
+
+void UiLatency::Update()
+{
+  const auto now = latency_clock::now();
+  if (any_key_down()) {
+    last_input = now;
+  }
+
+  const auto playing = DOTween::TotalPlayingTweens();
+  tweens_last_frame  = playing;
+
+  if (!measuring) {
+    return;
+  }
+
+  using ms = std::chrono::duration<double, std::milli>;
+
+  const auto elapsed = now - measuring->input;
+  if (elapsed > MaxLatency) {
+    TraceRecorder::Instant("screen ready timed out", "ui", playing);
+    if (Config::Get()->log_ui_latency) {
+      spdlog::info("Section {} timed out after {:.1f}ms, {} tweens still playing ({} before)",
+                   (int)measuring->section, ms(elapsed).count(), playing, measuring->tweens_before);
+    }
+    measuring.reset();
+    return;
+  }
+
+  if (playing > measuring->tweens_before) {
+    return;
+  }
+
+  auto& latency = latencies[(int)measuring->section];
+  latency.count += 1;
+  latency.total += elapsed;
+
+  TraceRecorder::Complete("screen ready", "ui", measuring->input, now);
+
+  if (Config::Get()->log_ui_latency) {
+    spdlog::info("Section {} ready {:.1f}ms after input (average {:.1f}ms over {})", (int)measuring->section,
+                 ms(elapsed).count(), ms(latency.total).count() / (double)latency.count, latency.count);
+  }
+
+  measuring.reset();
+}
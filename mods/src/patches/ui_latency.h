@@ -0,0 +1,18 @@
+#pragma once
+
+#include <prime/Hub.h>
+
+// Measures how long a screen takes to become usable: from the key or click that changed the
+// section until no more tweens are playing than the frame before it. Tweens that were already
+// playing, such as looping ones, are not waited for. Each measurement goes to the trace, and with log_ui_latency
+// also to the log together with the running average for that section; screens that are still
+// animating after MaxLatency are logged as timed out.
+class UiLatency
+{
+public:
+  // Called from the SectionManager detour
+  static void OnSectionChanged(SectionID section);
+
+  // Main thread only, once per frame
+  static void Update();
+};
@@ -0,0 +1,153 @@
+#include "errormsg.h"
+
+#include "ui_state.h"
+#include "key.h"
+#include "prime/EventSystem.h"
+#include <prime/TMP_InputField.h>
+
+#include <spdlog/spdlog.h>
+
+bool UiState::sectionHooked   = false;
+bool UiState::selectionHooked = false;
+bool UiState::focusHooked     = false;
+
+bool UiState::sectionKnown   = false;
+bool UiState::selectionKnown = false;
+
+SectionID       UiState::section       = SectionID::AppInit;
+TMP_InputField* UiState::selectedInput = nullptr;
+TMP_InputField* UiState::focusedInput  = nullptr;
+
+SectionID UiState::PollSection()
+{
+  return Hub::get_SectionManager()->CurrentSection;
+}
+
+void UiState::PollSelection()
+{
+  UiState::selectedInput = nullptr;
+  UiState::focusedInput  = nullptr;
+
+  try {
+    if (auto eventSystem = EventSystem::current(); eventSystem) {
+      if (auto selected = eventSystem->currentSelectedGameObject; selected) {
+        UiState::selectedInput = selected->GetComponentFastPath2<TMP_InputField>();
+        if (UiState::selectedInput && UiState::selectedInput->isFocused) {
+          UiState::focusedInput = UiState::selectedInput;
+        }
+      }
+    }
+  } catch (...) {
+  }
+
+  UiState::selectionKnown = true;
+}
+
+SectionID UiState::CurrentSection()
+{
+  if (!UiState::sectionHooked) {
+    return UiState::PollSection();
+  }
+
+  if (!UiState::sectionKnown) {
+    UiState::section      = UiState::PollSection();
+    UiState::sectionKnown = true;
+  }
+
+  return UiState::section;
+}
+
+bool UiState::IsInChat()
+{
+  const auto current_section = UiState::CurrentSection();
+  return current_section == SectionID::Chat_Private_Message || current_section == SectionID::Chat_Alliance
+         || current_section == SectionID::Chat_Main || current_section == SectionID::Chat_Private_List;
+}
+
+bool UiState::IsInSystemOrGalaxyOrStarbase()
+{
+  const auto current_section = UiState::CurrentSection();
+  return current_section == SectionID::Navigation_Galaxy || current_section == SectionID::Navigation_System
+         || current_section == SectionID::Starbase_Interior || current_section == SectionID::Starbase_Exterior;
+}
+
+bool UiState::IsInputFocused()
+{
+  if (!UiState::selectionHooked || !UiState::focusHooked) {
+    return Key::IsInputFocused();
+  }
+
+  if (!UiState::selectionKnown) {
+    UiState::PollSelection();
+  }
+
+  return UiState::selectedInput && UiState::selectedInput == UiState::focusedInput;
+}
+
+void UiState::Verify()
+{
+#ifdef _MODDBG
+  if (UiState::sectionHooked && UiState::sectionKnown) {
+    if (const auto polled = UiState::PollSection(); polled != UiState::section) {
+      spdlog::warn("UiState: cached section {} but the game is in {}", (int)UiState::section, (int)polled);
+      UiState::section = polled;
+    }
+  }
+
+  if (UiState::selectionHooked && UiState::focusHooked && UiState::selectionKnown) {
+    const auto cached = UiState::IsInputFocused();
+    if (const auto polled = Key::IsInputFocused(); polled != cached) {
+      spdlog::warn("UiState: cached input focus {} but polling says {}", cached, polled);
+      UiState::PollSelection();
+    }
+  }
+#endif
+}
+
+void UiState::OnSectionChanged(SectionID section)
+{
+  spdlog::trace("UiState: section {} -> {}", (int)UiState::section, (int)section);
+  UiState::section      = section;
+  UiState::sectionKnown = true;
+}
+
+void UiState::OnSelectionChanged(EventSystem* event_system, GameObject* selected)
+{
+  if (!UiState::selectionKnown) {
+    return UiState::PollSelection();
+  }
+
+  if (event_system != EventSystem::current()) {
+    return;
+  }
+
+  UiState::selectedInput = nullptr;
+  try {
+    if (selected) {
+      UiState::selectedInput = selected->GetComponentFastPath2<TMP_InputField>();
+    }
+  } catch (...) {
+  }
+
+  if (UiState::selectedInput && UiState::selectedInput->isFocused) {
+    UiState::focusedInput = UiState::selectedInput;
+  }
+}
+
+void UiState::OnInputFocusChanged(TMP_InputField* input, bool focused)
+{
+  if (focused) {
+    UiState::focusedInput = input;
+  } else if (UiState::focusedInput == input) {
+    UiState::focusedInput = nullptr;
+  }
+}
+
+// The section manager and event system are replaced along with the scene
+void UiState::Invalidate()
+{
+  UiState::sectionKnown   = false;
+  UiState::selectionKnown = false;
+  UiState::selectedInput  = nullptr;
+  UiState::focusedInput   = nullptr;
+}
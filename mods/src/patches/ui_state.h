@@ -0,0 +1,45 @@
+#pragma once
+
+#include <prime/Hub.h>
+
+class TMP_InputField;
+struct EventSystem;
+struct GameObject;
+
+// The bits of UI state the hotkey and zoom hooks check every frame, kept up to date by detours on
+// the events that change them (see patches/parts/ui_state.cc) instead of being read through
+// reflection each time. Anything whose event could not be hooked, or that has not been seen since
+// the last scene load, is polled the old way.
+class UiState
+{
+public:
+  static SectionID CurrentSection();
+  static bool      IsInChat();
+  static bool      IsInSystemOrGalaxyOrStarbase();
+  static bool      IsInputFocused();
+
+  // Compares the cache with the polled state once per frame, correcting and logging any drift.
+  // Only does anything in _MODDBG builds.
+  static void Verify();
+
+  // Called by the detours
+  static void OnSectionChanged(SectionID section);
+  static void OnSelectionChanged(EventSystem* event_system, GameObject* selected);
+  static void OnInputFocusChanged(TMP_InputField* input, bool focused);
+  static void Invalidate();
+
+  static bool sectionHooked;
+  static bool selectionHooked;
+  static bool focusHooked;
+
+private:
+  static SectionID PollSection();
+  static void      PollSelection();
+
+  static bool sectionKnown;
+  static bool selectionKnown;
+
+  static SectionID       section;
+  static TMP_InputField* selectedInput;
+  static TMP_InputField* focusedInput;
+};
@@ -16,23 +16,23 @@ private:
 public:
   float __get_farClipPlane()
   {
-    static auto field = get_class_helper().GetProperty("farClipPlane");
-    return *field.GetRaw<float>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("farClipPlane");
+    return field.Get(this);
   }
   void __set_farClipPlane(float v)
   {
-    static auto field = get_class_helper().GetProperty("farClipPlane");
-    field.SetRaw(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("farClipPlane");
+    field.Set(this, v);
   }
 
   float __get_nearClipPlane()
   {
-    static auto field = get_class_helper().GetProperty("nearClipPlane");
-    return *field.GetRaw<float>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("nearClipPlane");
+    return field.Get(this);
   }
   void __set_nearClipPlane(float v)
   {
-    static auto field = get_class_helper().GetProperty("nearClipPlane");
-    field.SetRaw(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("nearClipPlane");
+    field.Set(this, v);
   }
 };
\ No newline at end of file
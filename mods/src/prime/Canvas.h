@@ -16,12 +16,12 @@ private:
 public:
   float __get_scaleFactor()
   {
-    static auto field = get_class_helper().GetProperty("scaleFactor");
-    return *field.Get<float>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("scaleFactor");
+    return field.Get(this);
   }
   void __set_scaleFactor(float v)
   {
-    static auto field = get_class_helper().GetProperty("scaleFactor");
-    field.SetRaw<float>(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("scaleFactor");
+    field.Set(this, v);
   }
 };
@@ -26,14 +26,14 @@ public:
 
   bool Visible()
   {
-    static auto field = get_class_helper().GetProperty("Visible");
-    return field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("Visible");
+    return field.Get(this);
   }
 
   bool get_enabled()
   {
-    static auto field = get_class_helper().GetProperty("enabled");
-    return field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("enabled");
+    return field.Get(this);
   }
 
   bool m_Visible()
@@ -44,14 +44,14 @@ public:
 
   Il2CppString* __get_Name()
   {
-    static auto field = get_class_helper().GetProperty("name");
-    return field.GetRaw<Il2CppString>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<Il2CppString*>("name");
+    return field.Get(this);
   }
 
   Transform* __get_Transform()
   {
-    static auto field = get_class_helper().GetProperty("transform");
-    return field.GetRaw<Transform>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<Transform*>("transform");
+    return field.Get(this);
   }
 
   Canvas* __get_m_canvas()
@@ -30,23 +30,23 @@ private:
 public:
   float __get_scaleFactor()
   {
-    static auto field = get_class_helper().GetProperty("scaleFactor");
-    return *field.Get<float>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("scaleFactor");
+    return field.Get(this);
   }
   void __set_scaleFactor(float v)
   {
-    static auto field = get_class_helper().GetProperty("scaleFactor");
-    field.SetRaw<float>(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("scaleFactor");
+    field.Set(this, v);
   }
 
   vec2 __get_referenceResolution()
   {
-    static auto field = get_class_helper().GetProperty("referenceResolution");
-    return *field.Get<vec2>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<vec2>("referenceResolution");
+    return field.Get(this);
   }
   void __set_referenceResolution(vec2 v)
   {
-    static auto field = get_class_helper().GetProperty("referenceResolution");
-    field.SetRaw<vec2>(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<vec2>("referenceResolution");
+    field.Set(this, v);
   }
 };
@@ -92,25 +92,25 @@ public:
 
   bool __get_IsSideChatAllowed()
   {
-    static auto field = get_class_helper().GetProperty("IsSideChatAllowed");
-    return *field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("IsSideChatAllowed");
+    return field.Get(this);
   }
 
   bool __get_IsSideChatOpen()
   {
-    static auto field = get_class_helper().GetProperty("IsSideChatOpen");
-    return *field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("IsSideChatOpen");
+    return field.Get(this);
   }
 
   ChatViewMode __get_ViewMode()
   {
-    static auto field = get_class_helper().GetProperty("ViewMode");
-    return *field.Get<ChatViewMode>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<ChatViewMode>("ViewMode");
+    return field.Get(this);
   }
 
   void __set_ViewMode(ChatViewMode v)
   {
-    static auto field = get_class_helper().GetProperty("ViewMode");
-    field.SetRaw<ChatViewMode>(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<ChatViewMode>("ViewMode");
+    field.Set(this, v);
   }
 };
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <il2cpp/il2cpp_helper.h>
+
+#include <string_view>
+
+struct ChatMessage {
+public:
+  __declspec(property(get = __get_SenderName)) Il2CppString* SenderName;
+  __declspec(property(get = __get_AllianceTag)) Il2CppString* AllianceTag;
+  __declspec(property(get = __get_Text)) Il2CppString* Text;
+
+  // False when a property the chat filter reads is missing from this version of the game
+  static bool IsValid()
+  {
+    return get_class_helper().isValidHelper() && get_SenderName().isValidHelper()
+           && get_AllianceTag().isValidHelper() && get_Text().isValidHelper();
+  }
+
+  // The text of a string without copying it, empty for null
+  static std::u16string_view View(Il2CppString* str)
+  {
+    return str ? std::u16string_view((const char16_t*)str->chars, str->length) : std::u16string_view();
+  }
+
+private:
+  static IL2CppClassHelper& get_class_helper()
+  {
+    static auto class_helper = il2cpp_get_class_helper("Assembly-CSharp", "Digit.Prime.Chat", "ChatMessage");
+    return class_helper;
+  }
+
+  static IL2CppPropertyAccessor<Il2CppString*>& get_SenderName()
+  {
+    static auto property = get_class_helper().GetPropertyAccessor<Il2CppString*>("SenderName");
+    return property;
+  }
+
+  static IL2CppPropertyAccessor<Il2CppString*>& get_AllianceTag()
+  {
+    static auto property = get_class_helper().GetPropertyAccessor<Il2CppString*>("AllianceTag");
+    return property;
+  }
+
+  static IL2CppPropertyAccessor<Il2CppString*>& get_Text()
+  {
+    static auto property = get_class_helper().GetPropertyAccessor<Il2CppString*>("Text");
+    return property;
+  }
+
+public:
+  Il2CppString* __get_SenderName()
+  {
+    return get_SenderName().Get(this);
+  }
+
+  Il2CppString* __get_AllianceTag()
+  {
+    return get_AllianceTag().Get(this);
+  }
+
+  Il2CppString* __get_Text()
+  {
+    return get_Text().Get(this);
+  }
+};
@@ -47,7 +47,7 @@ public:
   }
   ChatSectionContext* __get_CanvasContext()
   {
-    static auto field = get_class_helper().GetProperty("CanvasContext");
-    return field.Get<ChatSectionContext>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<ChatSectionContext*>("CanvasContext");
+    return field.Get(this);
   }
 };
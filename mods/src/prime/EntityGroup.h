@@ -32,8 +32,8 @@ public:
 
   int32_t __get_Length()
   {
-    static auto prop = get_class_helper().GetProperty("Length");
-    return *prop.Get<int32_t>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<int32_t>("Length");
+    return prop.Get(this);
   }
 };
 
@@ -233,13 +233,13 @@ private:
 public:
   ByteString* __get_ByteString()
   {
-    static auto prop = get_class_helper().GetProperty("Group");
-    return prop.GetRaw<ByteString>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<ByteString*>("Group");
+    return prop.Get(this);
   }
 
   Type __get_Type()
   {
-    static auto prop = get_class_helper().GetProperty("Type");
-    return *prop.Get<Type>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Type>("Type");
+    return prop.Get(this);
   }
 };
@@ -8,8 +8,8 @@ struct EventSystem {
 public:
   static EventSystem* current()
   {
-    static auto field = get_class_helper().GetProperty("current");
-    return field.GetRaw<EventSystem>(nullptr);
+    static auto field = get_class_helper().GetPropertyAccessor<EventSystem*>("current");
+    return field.Get(nullptr);
   }
 
   void SetSelectedGameObject(void*)
@@ -37,13 +37,13 @@ private:
 public:
   GameObject* __get_currentSelectedGameObject()
   {
-    static auto field = get_class_helper().GetProperty("currentSelectedGameObject");
-    return field.GetRaw<GameObject>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<GameObject*>("currentSelectedGameObject");
+    return field.Get(this);
   }
 
   void __set_currentSelectedGameObject(GameObject* v)
   {
-    static auto field = get_class_helper().GetProperty("currentSelectedGameObject");
-    return field.SetRaw(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<GameObject*>("currentSelectedGameObject");
+    field.Set(this, v);
   }
 };
\ No newline at end of file
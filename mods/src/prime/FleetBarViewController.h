@@ -18,8 +18,8 @@ public:
 public:
   void* __get_CurrentFleet()
   {
-    static auto field = get_class_helper().GetProperty("CurrentFleet");
-    return field.Get<void>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<void*>("CurrentFleet");
+    return field.Get(this);
   }
 };
 
@@ -67,8 +67,8 @@ public:
 
   FleetBarContext* CanvasContext()
   {
-    static auto n = get_class_helper().GetProperty("CanvasContext");
-    return n.GetRaw<FleetBarContext>(this);
+    static auto n = get_class_helper().GetPropertyAccessor<FleetBarContext*>("CanvasContext");
+    return n.Get(this);
   }
 
 private:
@@ -29,19 +29,19 @@ private:
 public:
   long __get_ID()
   {
-    static auto field = get_class_helper().GetProperty("ID");
-    return *field.Get<long>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<int64_t>("ID");
+    return field.Get(this);
   }
 
   HullSpec* __get_Hull()
   {
-    static auto field = get_class_helper().GetProperty("Hull");
-    return field.GetRaw<HullSpec>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<HullSpec*>("Hull");
+    return field.Get(this);
   }
 
   DeployedFleetType __get_FleetType()
   {
-    static auto field = get_class_helper().GetProperty("FleetType");
-    return *field.Get<DeployedFleetType>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<DeployedFleetType>("FleetType");
+    return field.Get(this);
   }
 };
@@ -60,13 +60,13 @@ private:
 public:
   FleetPlayerData* __get_fleet()
   {
-    static auto field = get_class_helper().GetProperty("fleet");
-    return field.GetRaw<FleetPlayerData>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<FleetPlayerData*>("fleet");
+    return field.Get(this);
   }
 
   ShipBarItemLocalViewController* __get__shipBarItemLocalViewController()
   {
-    static auto field = get_class_helper().GetProperty("_shipBarItemLocalViewController");
-    return field.GetRaw<ShipBarItemLocalViewController>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<ShipBarItemLocalViewController*>("_shipBarItemLocalViewController");
+    return field.Get(this);
   }
 };
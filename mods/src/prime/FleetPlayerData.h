@@ -51,41 +51,41 @@ private:
 public:
   HullSpec* __get_Hull()
   {
-    static auto field = get_class_helper().GetProperty("Hull");
-    return field.GetRaw<HullSpec>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<HullSpec*>("Hull");
+    return field.Get(this);
   }
   void* __get_Address()
   {
-    static auto field = get_class_helper().GetProperty("Address");
-    return field.GetRaw<void>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<void*>("Address");
+    return field.Get(this);
   }
   FleetState __get_CurrentState()
   {
-    static auto field = get_class_helper().GetProperty("CurrentState");
-    return *field.Get<FleetState>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<FleetState>("CurrentState");
+    return field.Get(this);
   }
   FleetState __get_PreviousState()
   {
-    static auto field = get_class_helper().GetProperty("PreviousState");
-    return *field.Get<FleetState>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<FleetState>("PreviousState");
+    return field.Get(this);
   }
   
   CanRepairRequirement* __get_CanRepairRequirement()
   {
-    static auto field = get_class_helper().GetProperty("CanRepairRequirement");
-    return field.GetRaw<CanRepairRequirement>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<CanRepairRequirement*>("CanRepairRequirement");
+    return field.Get(this);
   }
 
 
   RecallRequirement* __get_RecallRequirements()
   {
-    static auto field = get_class_helper().GetProperty("RecallRequirement");
-    return field.GetRaw<RecallRequirement>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<RecallRequirement*>("RecallRequirement");
+    return field.Get(this);
   }
 
   uint64_t __get_Id()
   {
-    static auto field = get_class_helper().GetProperty("Id");
-    return *field.Get<uint64_t>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<uint64_t>("Id");
+    return field.Get(this);
   }
 };
@@ -3,7 +3,7 @@
 struct GameObject {
 public:
   __declspec(property(get = __get_activeInHierarchy)) bool activeInHierarchy;
-  __declspec(property(get = __get_scene)) void* scene;
+  __declspec(property(get = __get_scene)) int32_t scene;
 
   template <typename T> T* GetComponentFastPath2()
   {
@@ -60,12 +60,13 @@ private:
 public:
   bool __get_activeInHierarchy()
   {
-    static auto field = get_class_helper().GetProperty("activeInHierarchy");
-    return field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("activeInHierarchy");
+    return field.Get(this);
   }
-  void* __get_scene()
+  // UnityEngine.SceneManagement.Scene only wraps its handle
+  int32_t __get_scene()
   {
-    static auto field = get_class_helper().GetProperty("scene");
-    return *field.Get<void*>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<int32_t>("scene");
+    return field.Get(this);
   }
 };
\ No newline at end of file
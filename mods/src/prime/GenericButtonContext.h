@@ -17,18 +17,18 @@ private:
 public:
   bool __get_Interactable()
   {
-    auto field = get_class_helper().GetProperty("Interactable");
+    auto field = get_class_helper().GetPropertyAccessor<bool>("Interactable");
     if (field.isValidHelper()) {
-      return *field.Get<bool>(this);
+      return field.Get(this);
     }
 
     return false;
   }
   void __set_Interactable(bool v)
   {
-    auto field = get_class_helper().GetProperty("Interactable");
+    auto field = get_class_helper().GetPropertyAccessor<bool>("Interactable");
     if (field.isValidHelper()) {
-      field.SetRaw<bool>(this, v);
+      field.Set(this, v);
     }
   }
 };
@@ -6,8 +6,8 @@ struct HttpRequest {
 public:
   const Il2CppChar* get_URL()
   {
-    static auto prop = get_class_helper().GetProperty("URL");
-    auto        s    = prop.Get<Il2CppString>((void*)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("URL");
+    auto        s    = prop.Get((void*)this);
     return il2cpp_string_chars(s);
   }
 
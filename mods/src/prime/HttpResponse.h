@@ -17,9 +17,8 @@ public:
 
   HttpRequest* get_Request()
   {
-    static auto prop = get_class_helper().GetProperty("Request");
-    auto        s    = prop.GetRaw<HttpRequest>((void*)this);
-    return s;
+    static auto prop = get_class_helper().GetPropertyAccessor<HttpRequest*>("Request");
+    return prop.Get((void*)this);
   }
 
 private:
@@ -33,7 +32,7 @@ private:
 public:
   System_Byte_array* __get_bytes()
   {
-    static auto prop = get_class_helper().GetProperty("Bytes");
-    return prop.GetRaw<System_Byte_array>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<System_Byte_array*>("Bytes");
+    return prop.Get(this);
   }
 };
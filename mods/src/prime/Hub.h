@@ -224,8 +224,8 @@ private:
 public:
   SectionID __get_CurrentSection()
   {
-    static auto field = get_class_helper().GetProperty("CurrentSection");
-    return *field.Get<SectionID>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<SectionID>("CurrentSection");
+    return field.Get(this);
   }
 
   SectionStorage* __get__sectionStorage()
@@ -253,8 +253,8 @@ private:
 struct PrimeApp {
   GSServiceRegistry* get_Services()
   {
-    static auto field = get_class_helper().GetProperty("Services");
-    return field.GetRaw<GSServiceRegistry>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<GSServiceRegistry*>("Services");
+    return field.Get(this);
   }
 
 private:
@@ -268,14 +268,14 @@ private:
 struct Hub {
   static SectionManager* get_SectionManager()
   {
-    static auto field = get_class_helper().GetProperty("SectionManager");
-    return field.GetRaw<SectionManager>(nullptr);
+    static auto field = get_class_helper().GetPropertyAccessor<SectionManager*>("SectionManager");
+    return field.Get(nullptr);
   }
 
   static PrimeApp* get_App()
   {
-    static auto field = get_class_helper().GetProperty("App");
-    return field.GetRaw<PrimeApp>(nullptr);
+    static auto field = get_class_helper().GetPropertyAccessor<PrimeApp*>("App");
+    return field.Get(nullptr);
   }
 
   static bool IsInChat()
@@ -34,7 +34,7 @@ public:
 
   HullType __get_Type()
   {
-    static auto field = get_class_helper().GetProperty("Type");
-    return *field.Get<HullType>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<HullType>("Type");
+    return field.Get(this);
   }
 };
@@ -7,14 +7,14 @@ class IBuffComparer
 public:
   long get_HullId()
   {
-    static auto prop = get_class_helper().GetProperty("HullID");
-    return *prop.Get<long>((void*)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<int64_t>("HullID");
+    return prop.Get((void*)this);
   }
 
   long get_FactionId()
   {
-    static auto prop = get_class_helper().GetProperty("FactionID");
-    return *prop.Get<long>((void*)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<int64_t>("FactionID");
+    return prop.Get((void*)this);
   }
 
 private:
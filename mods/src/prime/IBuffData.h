@@ -19,7 +19,7 @@ private:
 public:
   ClientModifierType __get_modifierType()
   {
-    static auto prop = get_class_helper().GetProperty("ModifierType");
-    return *prop.Get<ClientModifierType>((void*)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<ClientModifierType>("ModifierType");
+    return prop.Get((void*)this);
   }
 };
\ No newline at end of file
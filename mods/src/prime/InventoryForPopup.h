@@ -17,13 +17,13 @@ private:
 public:
   bool __get_IsDonationUse()
   {
-    static auto field = get_class_helper().GetProperty("IsDonationUse");
-    return field.GetRaw(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("IsDonationUse");
+    return field.Get(this);
   }
 
-  void __set_IsDonationUse(float v)
+  void __set_IsDonationUse(bool v)
   {
-    static auto field = get_class_helper().GetProperty("IsDonationUse");
-    return field.SetRaw(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("IsDonationUse");
+    field.Set(this, v);
   }
 };
@@ -2,14 +2,32 @@
 
 #include <il2cpp/il2cpp_helper.h>
 
+#include <atomic>
+#include <cstdint>
+
+#ifdef _MODDBG
+#include <spdlog/spdlog.h>
+#endif
+
+struct MonoSingletonCache {
+  // Called when a scene has loaded; the backing fields may still point at destroyed objects until
+  // each singleton's getter has run again
+  static void Invalidate()
+  {
+    generation.fetch_add(1, std::memory_order_release);
+  }
+
+  static inline std::atomic<uint32_t> generation{1};
+};
+
 template <typename T> struct MonoSingleton {
 public:
   static T* Instance()
   {
     IL2CppClassHelper& helper = T::get_class_helper();
     static auto        parent = helper.GetParent("MonoSingleton`1");
-    auto               p      = parent.GetProperty("Instance");
-    auto               p2     = p.GetRaw<T>(nullptr);
+    static auto        p      = parent.GetPropertyAccessor<T*>("Instance");
+    static auto        field  = find_instance_field(parent);
 
     // Il2CppClassPointerStore<MonoSingleton<T>>.NativeClassPtr =
     // (__Null)IL2CPP.il2cpp_class_from_type(Il2CppSystem.Type.internal_from_handle(IL2CPP.il2cpp_class_get_type(IL2CPP.GetIl2CppClass("Assembly-CSharp.dll",
@@ -19,6 +37,53 @@ public:
     // Il2CppClassPointerStore<T>.NativeClassPtr))
     //	})).TypeHandle.value);
 
+    // After a scene load, or while the singleton does not exist yet, let the getter find it
+    const auto current = MonoSingletonCache::generation.load(std::memory_order_acquire);
+    if (!field || !*field || seen_generation.load(std::memory_order_relaxed) != current) {
+      auto p2 = p.Get(nullptr);
+      seen_generation.store(current, std::memory_order_relaxed);
+      return p2;
+    }
+
+    auto p2 = *field;
+
+#ifdef _MODDBG
+    if (auto reflected = p.Get(nullptr); reflected != p2) {
+      spdlog::warn("MonoSingleton<{}>::Instance cached {} but the getter returned {}",
+                   helper.get_cls()->name, (void*)p2, (void*)reflected);
+      return reflected;
+    }
+#endif
+
     return p2;
   }
+
+private:
+  // The static field of the closed MonoSingleton<T> that holds the instance
+  static T** find_instance_field(IL2CppClassHelper& parent)
+  {
+    auto cls = parent.get_cls();
+    if (!cls) {
+      return nullptr;
+    }
+
+    il2cpp_runtime_class_init(cls);
+
+    const auto instance_cls = T::get_class_helper().get_cls();
+    void*      iter         = nullptr;
+    while (auto field = il2cpp_class_get_fields(cls, &iter)) {
+      if (!(field->type->attrs & FIELD_ATTRIBUTE_STATIC) || (field->type->attrs & FIELD_ATTRIBUTE_LITERAL)
+          || field->offset == THREAD_STATIC_FIELD_OFFSET) {
+        continue;
+      }
+
+      if (il2cpp_class_from_type(field->type) == instance_cls && cls->static_fields) {
+        return (T**)((char*)cls->static_fields + field->offset);
+      }
+    }
+
+    return nullptr;
+  }
+
+  static inline std::atomic<uint32_t> seen_generation{0};
 };
@@ -18,8 +18,8 @@ public:
 
   static NavigationSectionManager* Instance()
   {
-    static auto p = get_class_helper().GetProperty("Instance");
-    return p.GetRaw<NavigationSectionManager>(nullptr);
+    static auto p = get_class_helper().GetPropertyAccessor<NavigationSectionManager*>("Instance");
+    return p.Get(nullptr);
   }
 
 private:
@@ -33,7 +33,7 @@ private:
 public:
   NavigationManager* __get_NavigationManager()
   {
-    static auto field = get_class_helper().GetProperty("NavigationManager");
-    return field.GetRaw<NavigationManager>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<NavigationManager*>("NavigationManager");
+    return field.Get(this);
   }
 };
\ No newline at end of file
@@ -64,14 +64,14 @@ private:
 public:
   float __get_Distance()
   {
-    static auto field = get_class_helper().GetProperty("Distance");
-    return *field.Get<float>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("Distance");
+    return field.Get(this);
   }
 
   void __set_Distance(float depth)
   {
-    static auto field = get_class_helper().GetProperty("Distance");
-    return field.SetRaw(this, depth);
+    static auto field = get_class_helper().GetPropertyAccessor<float>("Distance");
+    field.Set(this, depth);
   }
 
   NodeDepth __get__depth()
@@ -38,19 +38,19 @@ public:
 
   ParentObjectViewerViewController* __get_Parent()
   {
-    static auto field = get_class_helper().GetProperty("Parent");
-    return field.GetRaw<ParentObjectViewerViewController>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<ParentObjectViewerViewController*>("Parent");
+    return field.Get(this);
   }
 
   bool __get_IsInfoShown()
   {
-    static auto field = get_class_helper().GetProperty("IsInfoShown");
-    return *field.GetRaw<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("IsInfoShown");
+    return field.Get(this);
   }
 
   void __set_IsInfoShown(bool v)
   {
-    static auto field = get_class_helper().GetProperty("IsInfoShown");
-    field.SetRaw(this, v);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("IsInfoShown");
+    field.Set(this, v);
   }
 };
\ No newline at end of file
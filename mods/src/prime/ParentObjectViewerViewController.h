@@ -53,7 +53,7 @@ public:
 
   bool __get_IsShowing()
   {
-    static auto field = get_class_helper().GetProperty("IsShowing");
-    return *field.GetRaw<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("IsShowing");
+    return field.Get(this);
   }
 };
\ No newline at end of file
@@ -32,37 +32,37 @@ private:
 public:
   Il2CppString* __get_dataType()
   {
-    static auto prop = get_class_helper().GetProperty("DataType");
-    return prop.GetRaw<Il2CppString>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("DataType");
+    return prop.Get(this);
   }
 
   Il2CppString* __get_channelId()
   {
-    static auto prop = get_class_helper().GetProperty("ChannelId");
-    return prop.GetRaw<Il2CppString>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("ChannelId");
+    return prop.Get(this);
   }
 
   int32_t __get_instanceIdJson()
   {
-    static auto prop = get_class_helper().GetProperty("InstanceIdJson");
-    return *prop.Get<int32_t>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<int32_t>("InstanceIdJson");
+    return prop.Get(this);
   }
 
   Il2CppString* __get_target()
   {
-    static auto prop = get_class_helper().GetProperty("Target");
-    return prop.GetRaw<Il2CppString>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("Target");
+    return prop.Get(this);
   }
 
   Il2CppString* __get_source()
   {
-    static auto prop = get_class_helper().GetProperty("Source");
-    return prop.GetRaw<Il2CppString>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("Source");
+    return prop.Get(this);
   }
 
   Il2CppString* __get_data()
   {
-    static auto prop = get_class_helper().GetProperty("Data");
-    return prop.GetRaw<Il2CppString>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<Il2CppString*>("Data");
+    return prop.Get(this);
   }
 };
@@ -25,9 +25,9 @@ public:
 
   bool __get_Interactable()
   {
-    static auto field = get_class_helper().GetProperty("Interactable");
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("Interactable");
     if (field.isValidHelper()) {
-      return *field.Get<bool>(this);
+      return field.Get(this);
     }
 
     return false;
@@ -35,9 +35,9 @@ public:
 
   void __set_Interactable(bool v)
   {
-    static auto field = get_class_helper().GetProperty("Interactable");
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("Interactable");
     if (field.isValidHelper()) {
-      field.SetRaw<bool>(this, v);
+      field.Set(this, v);
     }
   }
 };
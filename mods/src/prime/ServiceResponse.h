@@ -46,7 +46,7 @@ private:
 public:
   RepeatedField_EntityGroup* __get_EntityGroups()
   {
-    static auto prop = get_class_helper().GetProperty("EntityGroups");
-    return prop.GetRaw<RepeatedField_EntityGroup>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<RepeatedField_EntityGroup*>("EntityGroups");
+    return prop.Get(this);
   }
 };
\ No newline at end of file
@@ -21,12 +21,12 @@ private:
   }
   T __get_CurrentState()
   {
-    static auto field = get_class_helper().GetProperty("CurrentState");
-    return *field.Get<T>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<T>("CurrentState");
+    return field.Get(this);
   }
   T __get_PreviousState()
   {
-    static auto field = get_class_helper().GetProperty("PreviousState");
-    return *field.Get<T>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<T>("PreviousState");
+    return field.Get(this);
   }
 };
\ No newline at end of file
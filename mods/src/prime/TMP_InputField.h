@@ -43,7 +43,7 @@ private:
 public:
   bool __get_isFocused()
   {
-    static auto field = get_class_helper().GetProperty("isFocused");
-    return field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("isFocused");
+    return field.Get(this);
   }
 };
\ No newline at end of file
@@ -52,8 +52,8 @@ struct Toast {
 public:
   int get_State()
   {
-    static auto prop = get_class_helper().GetProperty("State");
-    return *prop.Get<ToastState>((void *)this);
+    static auto prop = get_class_helper().GetPropertyAccessor<ToastState>("State");
+    return prop.Get((void *)this);
   }
 
 private:
@@ -5,18 +5,18 @@
 #include "Vector3.h"
 
 struct Transform {
-  __declspec(property(get = __get_LocalScale, put = __set_LocalScale)) Vector3* localScale;
+  __declspec(property(get = __get_LocalScale, put = __set_LocalScale)) Vector3 localScale;
 
-  Vector3* __get_LocalScale()
+  Vector3 __get_LocalScale()
   {
-    static auto field = get_class_helper().GetProperty("localScale");
-    return field.Get<Vector3>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<Vector3>("localScale");
+    return field.Get(this);
   }
 
-  void __set_LocalScale(Vector3* v)
+  void __set_LocalScale(Vector3 v)
   {
-    static auto prop = get_class_helper().GetProperty("localScale");
-    return prop.SetRaw((void*)this, *v);
+    static auto prop = get_class_helper().GetPropertyAccessor<Vector3>("localScale");
+    prop.Set((void*)this, v);
   }
 
 
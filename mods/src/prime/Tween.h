@@ -0,0 +1,75 @@
+#pragma once
+
+#include "errormsg.h"
+
+#include <il2cpp/il2cpp_helper.h>
+
+struct Tween {
+public:
+  __declspec(property(get = __get_timeScale, put = __set_timeScale)) float timeScale;
+  __declspec(property(get = __get_stringId)) Il2CppString* stringId;
+  __declspec(property(get = __get_id)) Il2CppObject* id;
+  __declspec(property(get = __get_target)) Il2CppObject* target;
+
+private:
+  static IL2CppClassHelper& get_class_helper()
+  {
+    static auto class_helper = il2cpp_get_class_helper("DOTween", "DG.Tweening", "Tween");
+    return class_helper;
+  }
+
+public:
+  float __get_timeScale()
+  {
+    static auto field = get_class_helper().GetField("timeScale");
+    return *(float*)((ptrdiff_t)this + field.offset());
+  }
+  void __set_timeScale(float v)
+  {
+    static auto field                           = get_class_helper().GetField("timeScale");
+    *(float*)((ptrdiff_t)this + field.offset()) = v;
+  }
+
+  Il2CppString* __get_stringId()
+  {
+    static auto field = get_class_helper().GetField("stringId");
+    return *(Il2CppString**)((ptrdiff_t)this + field.offset());
+  }
+
+  Il2CppObject* __get_id()
+  {
+    static auto field = get_class_helper().GetField("id");
+    return *(Il2CppObject**)((ptrdiff_t)this + field.offset());
+  }
+
+  Il2CppObject* __get_target()
+  {
+    static auto field = get_class_helper().GetField("target");
+    return *(Il2CppObject**)((ptrdiff_t)this + field.offset());
+  }
+};
+
+struct DOTween {
+public:
+  static int TotalPlayingTweens()
+  {
+    static auto TotalPlayingTweensMethod = get_class_helper().GetMethod<int()>("TotalPlayingTweens");
+    static auto TotalPlayingTweensWarn   = true;
+
+    if (TotalPlayingTweensMethod) {
+      return TotalPlayingTweensMethod();
+    } else if (TotalPlayingTweensWarn) {
+      TotalPlayingTweensWarn = false;
+      ErrorMsg::MissingStaticMethod("DOTween", "TotalPlayingTweens");
+    }
+
+    return 0;
+  }
+
+private:
+  static IL2CppClassHelper& get_class_helper()
+  {
+    static auto class_helper = il2cpp_get_class_helper("DOTween", "DG.Tweening", "DOTween");
+    return class_helper;
+  }
+};
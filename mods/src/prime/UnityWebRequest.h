@@ -6,9 +6,8 @@ struct UnityWebRequest {
 public:
   const uintptr_t get_uploadHandler()
   {
-    static auto prop = get_class_helper().GetProperty("uploadHandler");
-    auto        s    = prop.Get<uintptr_t>((void*)this);
-    return (uintptr_t)s;
+    static auto prop = get_class_helper().GetPropertyAccessor<void*>("uploadHandler");
+    return (uintptr_t)prop.Get((void*)this);
   }
 
 private:
@@ -16,7 +16,7 @@ private:
 public:
   T* __get_CanvasContext()
   {
-    static auto field = get_class_helper().GetProperty("CanvasContext");
-    return field.GetRaw<T>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<T*>("CanvasContext");
+    return field.Get(this);
   }
 };
\ No newline at end of file
@@ -56,7 +56,7 @@ public:
 
   VisibilityState __get_State()
   {
-    static auto prop = get_class_helper().GetProperty("VisibilityState");
-    return *prop.Get<VisibilityState>(this);
+    static auto prop = get_class_helper().GetPropertyAccessor<VisibilityState>("VisibilityState");
+    return prop.Get(this);
   }
 };
@@ -24,19 +24,19 @@ private:
 public:
   bool __get_enabled()
   {
-    static auto field = get_class_helper().GetProperty("enabled");
-    return field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("enabled");
+    return field.Get(this);
   }
 
   T* __get_Context()
   {
-    static auto field = get_class_helper().GetProperty("Context");
-    return field.GetRaw<T>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<T*>("Context");
+    return field.Get(this);
   }
 
   bool __get_isActiveAndEnabled()
   {
-    static auto field = get_class_helper().GetProperty("isActiveAndEnabled");
-    return *field.Get<bool>(this);
+    static auto field = get_class_helper().GetPropertyAccessor<bool>("isActiveAndEnabled");
+    return field.Get(this);
   }
 };
@@ -0,0 +1,191 @@
+// Replays a sync capture through the real processors with the HTTP layer stubbed out.
+//
+//   sync_replay <capture> [records.jsonl]
+//
+// Prints per-type throughput and allocation counts. When a records file is given, every batch of
+// records the processors would have sent is written to it as one JSON line, so runs can be diffed.
+
+#include "config.h"
+#include "patches/sync_capture.h"
+#include "patches/sync_replay.h"
+
+#include <prime/EntityGroup.h>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+
+static std::atomic<uint64_t> allocation_count{0};
+static std::atomic<uint64_t> allocation_bytes{0};
+
+void* operator new(size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  if (auto ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+struct ReplayStats {
+  uint64_t payloads    = 0;
+  uint64_t bytes       = 0;
+  uint64_t records     = 0;
+  uint64_t allocations = 0;
+  uint64_t allocated   = 0;
+  double   seconds     = 0.0;
+};
+
+static std::string entity_group_name(const SyncCapture::Entry& entry)
+{
+  switch (entry.type) {
+    case SyncCapture::RtcType:
+      return "rtc:" + entry.target;
+    case EntityGroup::Type::ActiveMissions:
+      return "ActiveMissions";
+    case EntityGroup::Type::CompletedMissions:
+      return "CompletedMissions";
+    case EntityGroup::Type::PlayerInventories:
+      return "PlayerInventories";
+    case EntityGroup::Type::ResearchTreesState:
+      return "ResearchTreesState";
+    case EntityGroup::Type::Officers:
+      return "Officers";
+    case EntityGroup::Type::ForbiddenTechs:
+      return "ForbiddenTechs";
+    case EntityGroup::Type::ActiveOfficerTraits:
+      return "ActiveOfficerTraits";
+    case EntityGroup::Type::Json:
+      return "Json";
+    case EntityGroup::Type::Jobs:
+      return "Jobs";
+    case EntityGroup::Type::GlobalActiveBuffs:
+      return "GlobalActiveBuffs";
+    case EntityGroup::Type::EntitySlots:
+      return "EntitySlots";
+    case EntityGroup::Type::AllianceGetGameProperties:
+      return "AllianceGetGameProperties";
+    case EntityGroup::Type::UserProfiles:
+      return "UserProfiles";
+    case EntityGroup::Type::AllianceProfiles:
+      return "AllianceProfiles";
+    default:
+      return "EntityGroup:" + std::to_string(entry.type);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <capture> [records.jsonl]\n", argv[0]);
+    return 2;
+  }
+
+  spdlog::set_level(spdlog::level::warn);
+
+  std::vector<SyncCapture::Entry> entries;
+  try {
+    entries = SyncCapture::Read(argv[1]);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+
+  // replay everything the processors understand, regardless of the local settings
+  Config::Update([](Config& config) {
+    config.sync_capture = false;
+    for (const auto& opt : SyncOptions) {
+      config.sync_options.*opt.option = true;
+    }
+  });
+
+  std::ofstream records_file;
+  if (argc > 2) {
+    records_file.open(argv[2], std::ios::out | std::ios::trunc);
+  }
+
+  // the combat log worker asks the game server for journals and profiles, answer it from the capture
+  for (auto& entry : entries) {
+    if (entry.type == SyncCapture::ScopelyType) {
+      SyncReplay::AddScopelyResponse(entry.target, std::move(entry.payload));
+    }
+  }
+
+  std::map<std::string, ReplayStats> stats;
+  ReplayStats*                       current = nullptr;
+  std::string                        current_name;
+
+  SyncReplay::SetRecordSink([&](SyncConfig::Type type, const nlohmann::json& records) {
+    current->records += records.size();
+
+    if (records_file.is_open()) {
+      records_file << nlohmann::json{{"source", current_name}, {"type", to_string(type)}, {"records", records}}.dump()
+                   << '\n';
+    }
+  });
+
+  for (auto& entry : entries) {
+    if (entry.type == SyncCapture::ScopelyType) {
+      continue;
+    }
+
+    current_name = entity_group_name(entry);
+    current      = &stats[current_name];
+
+    const auto size        = entry.payload.size();
+    auto       payload     = std::make_unique<std::string>(std::move(entry.payload));
+    const auto allocations = allocation_count.load();
+    const auto allocated   = allocation_bytes.load();
+    const auto start       = std::chrono::steady_clock::now();
+
+    const bool handled = entry.type == SyncCapture::RtcType
+                             ? SyncReplay::ProcessRtc(entry.target, std::move(payload))
+                             : SyncReplay::ProcessEntityGroup(entry.type, std::move(payload));
+
+    // battles are shipped by the combat log worker in the game, here they count for the battle headers
+    SyncReplay::DrainCombatLogs();
+
+    current->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    current->allocations += allocation_count.load() - allocations;
+    current->allocated += allocation_bytes.load() - allocated;
+
+    if (handled) {
+      current->payloads++;
+      current->bytes += size;
+    }
+  }
+
+  std::printf("%-28s %8s %12s %10s %12s %12s %14s\n", "source", "payloads", "bytes", "records", "MB/s", "allocs",
+              "alloc bytes");
+
+  for (const auto& [name, s] : stats) {
+    const auto throughput = s.seconds > 0.0 ? static_cast<double>(s.bytes) / s.seconds / (1024.0 * 1024.0) : 0.0;
+    std::printf("%-28s %8llu %12llu %10llu %12.2f %12llu %14llu\n", name.c_str(),
+                static_cast<unsigned long long>(s.payloads), static_cast<unsigned long long>(s.bytes),
+                static_cast<unsigned long long>(s.records), throughput,
+                static_cast<unsigned long long>(s.allocations), static_cast<unsigned long long>(s.allocated));
+  }
+
+  return 0;
+}
@@ -9,9 +9,9 @@ do
     add_includedirs("src", { public = true })
 
     -- Packages
-    add_packages("spud", "nlohmann_json", "protobuf", "libil2cpp", "eastl", "toml++", "spdlog", "simdutf", "libcurl", "capstone", "cpr")
+    add_packages("spud", "nlohmann_json", "protobuf", "libil2cpp", "eastl", "toml++", "spdlog", "simdutf", "libcurl", "capstone", "cpr", "zlib")
     add_rules("protobuf.cpp")
-    add_files("src/prime/proto/*.proto")
+    add_files("src/prime/proto/*.proto", { proto_public = true })
 
     set_exceptions("cxx")
     add_defines("NOMINMAX")
@@ -36,3 +36,38 @@ do
 
     set_policy("build.optimization.lto", true)
 end
+
+-- Replays a sync capture (see [sync] capture) through the processors without the game
+if is_plat("linux") then
+target("sync_replay")
+do
+    set_kind("binary")
+    set_default(false)
+
+    add_deps("mods")
+    add_files("tools/sync_replay.cc")
+
+    add_packages("spud", "nlohmann_json", "protobuf", "libil2cpp", "eastl", "toml++", "spdlog", "simdutf", "libcurl", "capstone", "cpr", "zlib", "x11")
+    add_syslinks("uuid", "dl", "pthread")
+
+    set_exceptions("cxx")
+    add_defines("NOMINMAX")
+end
+
+-- Microbenchmarks for the hot paths, e.g. xmake run mods_bench --benchmark_out=bench.json --benchmark_out_format=json
+target("mods_bench")
+do
+    set_kind("binary")
+    set_default(false)
+
+    add_deps("mods")
+    add_files("bench/*.cc")
+    add_defines("MODS_BENCH_CONFIG=\"" .. path.join(os.projectdir(), "example_community_patch_settings.toml") .. "\"")
+
+    add_packages("spud", "nlohmann_json", "protobuf", "libil2cpp", "eastl", "toml++", "spdlog", "simdutf", "libcurl", "capstone", "cpr", "zlib", "x11", "benchmark")
+    add_syslinks("uuid", "dl", "pthread")
+
+    set_exceptions("cxx")
+    add_defines("NOMINMAX")
+end
+end
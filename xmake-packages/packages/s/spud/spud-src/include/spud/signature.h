@@ -54,6 +54,40 @@ std::vector<signature_result>
 find_matches(std::string_view mask, std::string_view data,
              std::span<uint8_t> search_buffer,
              uint32_t features = cpu_feature::FEATURE_ALL);
+
+// Prefilter over the anchor of each signature: a fixed byte and, when it is
+// fixed too, the byte after it. Signatures are spread over 8 buckets and a
+// position is a candidate when, in some bucket, its byte is one of the
+// bucket's anchor bytes (lo[b & 0xF] & hi[b >> 4]) and the byte after it one
+// of the bucket's follow bytes. This is a superset of the real anchor
+// positions, candidates still have to be verified.
+struct anchor_set {
+  alignas(16) uint8_t lo[16] = {};
+  alignas(16) uint8_t hi[16] = {};
+  alignas(16) uint8_t next_lo[16] = {};
+  alignas(16) uint8_t next_hi[16] = {};
+
+  // next is -1 when the byte after the anchor is a wildcard
+  void add(size_t bucket, uint8_t byte, int next);
+
+  bool contains(std::span<const uint8_t> search_buffer, size_t offset) const {
+    const auto byte = search_buffer[offset];
+    const auto buckets = lo[byte & 0xF] & hi[byte >> 4];
+    if (offset + 1 >= search_buffer.size()) {
+      return buckets != 0;
+    }
+
+    const auto next = search_buffer[offset + 1];
+    return (buckets & next_lo[next & 0xF] & next_hi[next >> 4]) != 0;
+  }
+};
+
+// Appends the offsets in [begin, end) of search_buffer that the anchor set
+// accepts
+using find_candidates_fn = void (*)(std::span<const uint8_t> search_buffer,
+                                    size_t begin, size_t end,
+                                    const anchor_set &anchors,
+                                    std::vector<size_t> &candidates);
 } // namespace detail
 
 struct signature_matches {
@@ -107,4 +141,20 @@ signature_matches find_in_module(std::string_view signature,
                                  std::string_view module = {},
                                  uint32_t features = cpu_feature::FEATURE_ALL);
 
+// Looks for all of the signatures in a single pass over the buffer, split
+// across threads for large buffers. Each signature is anchored on its rarest
+// byte pair in the buffer; the anchors of every signature are found together
+// with a SIMD nibble-table scan and only those positions are verified.
+// Returns every match of signatures[i] in result[i], in address order.
+// Signatures without any fixed byte never match.
+std::vector<signature_matches>
+find_many_matches(std::span<const std::string_view> signatures,
+                  std::span<uint8_t> search_buffer,
+                  uint32_t features = cpu_feature::FEATURE_ALL);
+
+std::vector<signature_matches>
+find_many_in_module(std::span<const std::string_view> signatures,
+                    std::string_view module = {},
+                    uint32_t features = cpu_feature::FEATURE_ALL);
+
 } // namespace spud
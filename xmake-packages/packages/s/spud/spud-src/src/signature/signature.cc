@@ -1,6 +1,7 @@
 #include <spud/arch.h>
 #include <spud/signature.h>
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <bitset>
@@ -11,6 +12,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #if SPUD_ARCH_X86_FAMILY
@@ -93,10 +95,22 @@ void find_matches_sse(std::string_view mask, std::string_view data,
 void find_matches_avx2(std::string_view mask, std::string_view data,
                        size_t buffer_end, std::span<uint8_t> search_buffer,
                        std::vector<signature_result> &results);
+
+void find_candidates_sse(std::span<const uint8_t> search_buffer, size_t begin,
+                         size_t end, const anchor_set &anchors,
+                         std::vector<size_t> &candidates);
+
+void find_candidates_avx2(std::span<const uint8_t> search_buffer, size_t begin,
+                          size_t end, const anchor_set &anchors,
+                          std::vector<size_t> &candidates);
 #elif SPUD_ARCH_ARM_FAMILY
 void find_matches_neon(std::string_view mask, std::string_view data,
                        size_t buffer_end, std::span<uint8_t> search_buffer,
                        std::vector<signature_result> &results);
+
+void find_candidates_neon(std::span<const uint8_t> search_buffer, size_t begin,
+                          size_t end, const anchor_set &anchors,
+                          std::vector<size_t> &candidates);
 #endif
 
 std::vector<signature_result> find_matches(std::string_view mask,
@@ -154,6 +168,236 @@ std::vector<signature_result> find_matches(std::string_view mask,
 
   return results;
 }
+
+void anchor_set::add(size_t bucket, uint8_t byte, int next) {
+  const auto bit = static_cast<uint8_t>(1u << (bucket % 8));
+  lo[byte & 0xF] |= bit;
+  hi[byte >> 4] |= bit;
+
+  if (next < 0) {
+    for (size_t i = 0; i < 16; ++i) {
+      next_lo[i] |= bit;
+      next_hi[i] |= bit;
+    }
+  } else {
+    next_lo[next & 0xF] |= bit;
+    next_hi[next >> 4] |= bit;
+  }
+}
+
+static void find_candidates_scalar(std::span<const uint8_t> search_buffer,
+                                   size_t begin, size_t end,
+                                   const anchor_set &anchors,
+                                   std::vector<size_t> &candidates) {
+  for (size_t offset = begin; offset < end; ++offset) {
+    if (anchors.contains(search_buffer, offset)) {
+      candidates.push_back(offset);
+    }
+  }
+}
+
+static find_candidates_fn select_candidates_kernel(uint32_t features) {
+#if SPUD_ARCH_X86_FAMILY
+  uint32_t abcd[4];
+  run_cpuid(7, 0, abcd);
+  if ((features & FEATURE_AVX2) != 0 && (abcd[1] & (1 << 5)) != 0) {
+    return find_candidates_avx2;
+  }
+
+  run_cpuid(1, 0, abcd);
+  if ((features & FEATURE_SSE42) != 0 && (abcd[2] & (1 << 19)) != 0) {
+    return find_candidates_sse;
+  }
+#elif SPUD_ARCH_ARM_FAMILY && SPUD_SIGNATURE_NEON_CANDIDATES
+  // Opt-in until the NEON kernel has been checked against the scalar one on
+  // ARM hardware
+  if ((features & FEATURE_NEON) != 0) {
+    return find_candidates_neon;
+  }
+#endif
+  return find_candidates_scalar;
+}
+
+// Byte frequencies over evenly spaced samples of the buffer, used to anchor
+// each signature on its least common bytes
+static std::array<uint32_t, 256>
+sample_histogram(std::span<const uint8_t> search_buffer) {
+  constexpr size_t sample_size = 4096;
+  constexpr size_t sample_count = 64;
+
+  std::array<uint32_t, 256> histogram = {};
+  if (search_buffer.size() <= sample_size * sample_count) {
+    for (const auto byte : search_buffer) {
+      ++histogram[byte];
+    }
+    return histogram;
+  }
+
+  const auto stride = search_buffer.size() / sample_count;
+  for (size_t i = 0; i < sample_count; ++i) {
+    for (const auto byte : search_buffer.subspan(i * stride, sample_size)) {
+      ++histogram[byte];
+    }
+  }
+  return histogram;
+}
+
+namespace {
+struct compiled_signature {
+  std::string mask;
+  std::string data;
+  size_t anchor = 0;
+};
+
+class many_signatures {
+public:
+  many_signatures(std::span<const std::string_view> signatures,
+                  std::span<uint8_t> search_buffer, uint32_t features)
+      : search_buffer(search_buffer),
+        find_candidates(select_candidates_kernel(features)) {
+    const auto histogram = sample_histogram(search_buffer);
+
+    uint64_t sampled = 0;
+    for (const auto count : histogram) {
+      sampled += count;
+    }
+
+    compiled.resize(signatures.size());
+    for (size_t index = 0; index < signatures.size(); ++index) {
+      auto &signature = compiled[index];
+      generate_mask_and_data(signatures[index], signature.mask,
+                             signature.data);
+
+      // Estimated frequency of the pair, a wildcard follow byte counting as
+      // every byte
+      const auto score = [&](size_t i) {
+        const auto next =
+            i + 1 < signature.mask.size() && signature.mask[i + 1] != '?'
+                ? histogram[static_cast<uint8_t>(signature.data[i + 1])] + 1
+                : sampled + 1;
+        return (histogram[static_cast<uint8_t>(signature.data[i])] + 1) *
+               next;
+      };
+
+      auto best = UINT64_MAX;
+      for (size_t i = 0; i < signature.mask.size(); ++i) {
+        if (signature.mask[i] != '?' && score(i) < best) {
+          best = score(i);
+          signature.anchor = i;
+        }
+      }
+
+      if (best == UINT64_MAX) {
+        continue;
+      }
+
+      const auto anchor = signature.anchor;
+      const auto next =
+          anchor + 1 < signature.mask.size() && signature.mask[anchor + 1] != '?'
+              ? static_cast<uint8_t>(signature.data[anchor + 1])
+              : -1;
+      anchors.add(index, static_cast<uint8_t>(signature.data[anchor]), next);
+      by_anchor[static_cast<uint8_t>(signature.data[anchor])].push_back(index);
+    }
+  }
+
+  bool empty() const {
+    return std::all_of(by_anchor.begin(), by_anchor.end(),
+                       [](const auto &indices) { return indices.empty(); });
+  }
+
+  // Verifies the anchors found in [begin, end). A match is reported by the
+  // range holding its anchor, so ranges can be scanned independently.
+  void scan(size_t begin, size_t end,
+            std::vector<std::vector<signature_result>> &results) const {
+    constexpr size_t block_size = 64 * 1024;
+
+    std::vector<size_t> candidates;
+    for (auto block = begin; block < end; block += block_size) {
+      candidates.clear();
+      find_candidates(search_buffer, block, std::min(end, block + block_size),
+                      anchors, candidates);
+
+      for (const auto position : candidates) {
+        for (const auto index : by_anchor[search_buffer[position]]) {
+          const auto &signature = compiled[index];
+          if (position < signature.anchor) {
+            continue;
+          }
+
+          const auto start = position - signature.anchor;
+          if (start + signature.mask.size() > search_buffer.size()) {
+            continue;
+          }
+
+          if (signature_does_match(start, signature.mask, signature.data,
+                                   search_buffer)) {
+            results[index].emplace_back(
+                signature_result{search_buffer, start});
+          }
+        }
+      }
+    }
+  }
+
+private:
+  std::span<uint8_t> search_buffer;
+  find_candidates_fn find_candidates;
+  std::vector<compiled_signature> compiled;
+  std::array<std::vector<size_t>, 256> by_anchor;
+  anchor_set anchors;
+};
+} // namespace
+
+static void
+find_many_matches(std::span<const std::string_view> signatures,
+                  std::span<uint8_t> search_buffer, uint32_t features,
+                  std::vector<std::vector<signature_result>> &results) {
+  // Below this a thread costs more to start than it saves
+  constexpr size_t min_chunk_size = 4 * 1024 * 1024;
+
+  const many_signatures scanner(signatures, search_buffer, features);
+  if (scanner.empty() || search_buffer.empty()) {
+    return;
+  }
+
+  const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+  const auto thread_count = std::clamp<size_t>(
+      search_buffer.size() / min_chunk_size, 1, max_threads);
+  if (thread_count == 1) {
+    scanner.scan(0, search_buffer.size(), results);
+    return;
+  }
+
+  const auto chunk_size = (search_buffer.size() + thread_count - 1) /
+                          thread_count;
+
+  std::vector<std::vector<std::vector<signature_result>>> chunk_results(
+      thread_count,
+      std::vector<std::vector<signature_result>>(signatures.size()));
+
+  std::vector<std::thread> workers;
+  workers.reserve(thread_count - 1);
+  for (size_t i = 1; i < thread_count; ++i) {
+    workers.emplace_back([&, i] {
+      scanner.scan(i * chunk_size,
+                   std::min(search_buffer.size(), (i + 1) * chunk_size),
+                   chunk_results[i]);
+    });
+  }
+  scanner.scan(0, chunk_size, chunk_results[0]);
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (auto &chunk : chunk_results) {
+    for (size_t index = 0; index < signatures.size(); ++index) {
+      results[index].insert(results[index].end(), chunk[index].begin(),
+                            chunk[index].end());
+    }
+  }
+}
 } // namespace detail
 
 signature_matches find_matches(std::string_view signature,
@@ -169,9 +413,18 @@ signature_matches find_matches(std::string_view signature,
   return results;
 }
 
+std::vector<signature_matches>
+find_many_matches(std::span<const std::string_view> signatures,
+                  std::span<uint8_t> search_buffer, uint32_t features) {
+  std::vector<std::vector<detail::signature_result>> results(
+      signatures.size());
+  detail::find_many_matches(signatures, search_buffer, features, results);
+  return {results.begin(), results.end()};
+}
+
 #if SPUD_OS_WIN
-signature_matches find_in_module(std::string_view signature,
-                                 std::string_view module, uint32_t features) {
+static std::vector<std::span<uint8_t>>
+module_sections(std::string_view module) {
   std::vector<std::span<uint8_t>> sections;
 
   const auto module_handle = reinterpret_cast<uintptr_t>(
@@ -205,20 +458,11 @@ signature_matches find_in_module(std::string_view signature,
     }
   }
 
-  std::string mask;
-  std::string data;
-  detail::generate_mask_and_data(signature, mask, data);
-
-  std::vector<detail::signature_result> results;
-  for (auto &section : sections) {
-    auto matches = detail::find_matches(mask, data, section, features);
-    results.insert(results.end(), matches.begin(), matches.end());
-  }
-  return results;
+  return sections;
 }
 #elif SPUD_OS_MAC
-signature_matches find_in_module(std::string_view signature,
-                                 std::string_view module, uint32_t features) {
+static std::vector<std::span<uint8_t>>
+module_sections(std::string_view module) {
   std::vector<std::span<uint8_t>> sections;
 
   pid_t pid = getpid();
@@ -252,20 +496,11 @@ signature_matches find_in_module(std::string_view signature,
     address += size; // Move to the next region
   }
 
-  std::string mask;
-  std::string data;
-  detail::generate_mask_and_data(signature, mask, data);
-
-  std::vector<detail::signature_result> results;
-  for (auto &section : sections) {
-    auto matches = detail::find_matches(mask, data, section, features);
-    results.insert(results.end(), matches.begin(), matches.end());
-  }
-  return results;
+  return sections;
 }
 #elif SPUD_OS_LINUX
-signature_matches find_in_module(std::string_view signature,
-                                 std::string_view module, uint32_t features) {
+static std::vector<std::span<uint8_t>>
+module_sections(std::string_view module) {
   std::ifstream maps_file("/proc/self/maps");
   if (!maps_file.is_open()) {
     return {};
@@ -273,12 +508,8 @@ signature_matches find_in_module(std::string_view signature,
 
   const std::string_view module_name = module.size() > 0 ? module.data() : "";
 
-  std::string mask;
-  std::string data;
-  detail::generate_mask_and_data(signature, mask, data);
-
   std::string line;
-  std::vector<detail::signature_result> results;
+  std::vector<std::span<uint8_t>> sections;
   while (std::getline(maps_file, line)) {
     int name_start = 0, name_end = 0;
     unsigned long addr_start, addr_end;
@@ -297,14 +528,37 @@ signature_matches find_in_module(std::string_view signature,
     }
     if (map_name.ends_with(module_name) && strchr(perms_str, 'r') &&
         strchr(perms_str, 'x')) {
-      const auto section = std::span(reinterpret_cast<uint8_t *>(addr_start),
-                                     reinterpret_cast<uint8_t *>(addr_end));
-      auto matches = detail::find_matches(mask, data, section, features);
-      results.insert(results.end(), matches.begin(), matches.end());
+      sections.emplace_back(reinterpret_cast<uint8_t *>(addr_start),
+                            reinterpret_cast<uint8_t *>(addr_end));
     }
   }
-  return results;
+  return sections;
 }
 #endif
 
+signature_matches find_in_module(std::string_view signature,
+                                 std::string_view module, uint32_t features) {
+  std::string mask;
+  std::string data;
+  detail::generate_mask_and_data(signature, mask, data);
+
+  std::vector<detail::signature_result> results;
+  for (auto &section : module_sections(module)) {
+    auto matches = detail::find_matches(mask, data, section, features);
+    results.insert(results.end(), matches.begin(), matches.end());
+  }
+  return results;
+}
+
+std::vector<signature_matches>
+find_many_in_module(std::span<const std::string_view> signatures,
+                    std::string_view module, uint32_t features) {
+  std::vector<std::vector<detail::signature_result>> results(
+      signatures.size());
+  for (auto &section : module_sections(module)) {
+    detail::find_many_matches(signatures, section, features, results);
+  }
+  return {results.begin(), results.end()};
+}
+
 } // namespace spud
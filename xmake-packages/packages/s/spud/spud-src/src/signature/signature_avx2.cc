@@ -74,5 +74,58 @@ void find_matches_avx2(std::string_view mask, std::string_view data,
   }
 }
 
+// Teddy-style: classify 32 positions at a time through the anchor set's
+// nibble tables, for the anchor byte and the byte after it
+void find_candidates_avx2(std::span<const uint8_t> search_buffer, size_t begin,
+                          size_t end, const anchor_set &anchors,
+                          std::vector<size_t> &candidates) {
+  const auto table = [](const uint8_t *entries) {
+    return _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(entries)));
+  };
+  const __m256i lo = table(anchors.lo);
+  const __m256i hi = table(anchors.hi);
+  const __m256i next_lo = table(anchors.next_lo);
+  const __m256i next_hi = table(anchors.next_hi);
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  const __m256i zero = _mm256_setzero_si256();
+
+  const auto classify = [&](__m256i block, __m256i lo_table,
+                            __m256i hi_table) {
+    const auto lo_bits =
+        _mm256_shuffle_epi8(lo_table, _mm256_and_si256(block, nibble));
+    const auto hi_bits = _mm256_shuffle_epi8(
+        hi_table, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+    return _mm256_and_si256(lo_bits, hi_bits);
+  };
+
+  // The follow byte of the last position is read from the next block
+  size_t offset = begin;
+  for (; offset + 32 <= end && offset + 33 <= search_buffer.size();
+       offset += 32) {
+    const auto data = search_buffer.data() + offset;
+    const auto block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    const auto next_block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + 1));
+
+    const auto buckets = _mm256_and_si256(classify(block, lo, hi),
+                                          classify(next_block, next_lo, next_hi));
+    const auto misses = _mm256_cmpeq_epi8(buckets, zero);
+
+    uint32_t mm_mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(misses));
+    while (mm_mask != 0) {
+      candidates.push_back(offset + std::countr_zero(mm_mask));
+      mm_mask = mm_mask & (mm_mask - 1);
+    }
+  }
+
+  for (; offset < end; ++offset) {
+    if (anchors.contains(search_buffer, offset)) {
+      candidates.push_back(offset);
+    }
+  }
+}
+
 } // namespace detail
 } // namespace spud
@@ -76,5 +76,50 @@ void find_matches_neon(std::string_view mask, std::string_view data,
   }
 }
 
+// Teddy-style: classify 16 positions at a time through the anchor set's
+// nibble tables, for the anchor byte and the byte after it
+void find_candidates_neon(std::span<const uint8_t> search_buffer, size_t begin,
+                          size_t end, const anchor_set &anchors,
+                          std::vector<size_t> &candidates) {
+  const uint8x16_t lo = vld1q_u8(anchors.lo);
+  const uint8x16_t hi = vld1q_u8(anchors.hi);
+  const uint8x16_t next_lo = vld1q_u8(anchors.next_lo);
+  const uint8x16_t next_hi = vld1q_u8(anchors.next_hi);
+  const uint8x16_t nibble = vdupq_n_u8(0x0F);
+
+  const auto classify = [&](uint8x16_t block, uint8x16_t lo_table,
+                            uint8x16_t hi_table) {
+    return vandq_u8(vqtbl1q_u8(lo_table, vandq_u8(block, nibble)),
+                    vqtbl1q_u8(hi_table, vshrq_n_u8(block, 4)));
+  };
+
+  // The follow byte of the last position is read from the next block
+  size_t offset = begin;
+  for (; offset + 16 <= end && offset + 17 <= search_buffer.size();
+       offset += 16) {
+    const auto data = search_buffer.data() + offset;
+    const uint8x16_t block = vld1q_u8(data);
+    const uint8x16_t next_block = vld1q_u8(data + 1);
+
+    const uint8x16_t hits = vtstq_u8(classify(block, lo, hi),
+                                     classify(next_block, next_lo, next_hi));
+
+    // Narrow to 4 bits per byte to get a scalar mask
+    uint64_t nibble_mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+    while (nibble_mask != 0) {
+      const auto bit_pos = std::countr_zero(nibble_mask);
+      candidates.push_back(offset + bit_pos / 4);
+      nibble_mask = nibble_mask & ~(uint64_t(0xF) << (bit_pos & ~3));
+    }
+  }
+
+  for (; offset < end; ++offset) {
+    if (anchors.contains(search_buffer, offset)) {
+      candidates.push_back(offset);
+    }
+  }
+}
+
 } // namespace detail
 } // namespace spud
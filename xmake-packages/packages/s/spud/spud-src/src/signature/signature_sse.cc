@@ -72,5 +72,58 @@ void find_matches_sse(std::string_view mask, std::string_view data,
     }
   }
 }
+
+// Teddy-style: classify 16 positions at a time through the anchor set's
+// nibble tables, for the anchor byte and the byte after it
+void find_candidates_sse(std::span<const uint8_t> search_buffer, size_t begin,
+                         size_t end, const anchor_set &anchors,
+                         std::vector<size_t> &candidates) {
+  const auto table = [](const uint8_t *entries) {
+    return _mm_load_si128(reinterpret_cast<const __m128i *>(entries));
+  };
+  const __m128i lo = table(anchors.lo);
+  const __m128i hi = table(anchors.hi);
+  const __m128i next_lo = table(anchors.next_lo);
+  const __m128i next_hi = table(anchors.next_hi);
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  const __m128i zero = _mm_setzero_si128();
+
+  const auto classify = [&](__m128i block, __m128i lo_table,
+                            __m128i hi_table) {
+    const auto lo_bits =
+        _mm_shuffle_epi8(lo_table, _mm_and_si128(block, nibble));
+    const auto hi_bits = _mm_shuffle_epi8(
+        hi_table, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+    return _mm_and_si128(lo_bits, hi_bits);
+  };
+
+  // The follow byte of the last position is read from the next block
+  size_t offset = begin;
+  for (; offset + 16 <= end && offset + 17 <= search_buffer.size();
+       offset += 16) {
+    const auto data = search_buffer.data() + offset;
+    const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    const auto next_block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 1));
+
+    const auto buckets = _mm_and_si128(classify(block, lo, hi),
+                                       classify(next_block, next_lo, next_hi));
+    const auto misses = _mm_cmpeq_epi8(buckets, zero);
+
+    uint32_t mm_mask =
+        ~static_cast<uint32_t>(_mm_movemask_epi8(misses)) & 0xFFFF;
+    while (mm_mask != 0) {
+      candidates.push_back(offset + std::countr_zero(mm_mask));
+      mm_mask = mm_mask & (mm_mask - 1);
+    }
+  }
+
+  for (; offset < end; ++offset) {
+    if (anchors.contains(search_buffer, offset)) {
+      candidates.push_back(offset);
+    }
+  }
+}
+
 } // namespace detail
 } // namespace spud
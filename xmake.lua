@@ -10,12 +10,14 @@ add_requires("toml++")
 add_requires("nlohmann_json")
 add_requires("cpr")
 add_requireconfs("cpr.libcurl", { configs = { zlib = true } })
+add_requires("zlib")
 add_requires("protobuf 32.1")
 
 if is_plat("windows") then
     includes("win-proxy-dll")
     add_links('rpcrt4')
     add_links('runtimeobject')
+    add_links('ws2_32')
 end
 
 if is_plat("macosx") then
@@ -37,10 +39,14 @@ on_fetch(function(package, opt)
 end)
 package_end()
 
-add_requires("spud v0.2.0-2")
+add_requires("spud v0.2.0-4")
 add_requires("libil2cpp")
 add_requires("simdutf", { system = false })
 
+if is_plat("linux") then
+    add_requires("benchmark")
+end
+
 -- includes("launcher")
 includes("mods")
 